@@ -38,6 +38,8 @@
 
 #include "queue.h"
 
+#include "snap.h"
+
 #if 0
 #undef logall
 #define logall(...) PRINTF(__VA_ARGS__)
@@ -60,12 +62,11 @@ static const telnet_telopt_t telopts[] = {
 #endif
 
 
-static amlc_t *amlc_device_table[AMLC_MAXDEV] = { NULL };
 static inline line_t *amlc_getfreeline(cpu_t *cpu)
 {
   for(int n = 0; n < AMLC_MAXDEV; n++)
   {
-  amlc_t *amlc = amlc_device_table[n];
+  amlc_t *amlc = cpu->sys->amlc[n];
 
     if(amlc)
     {
@@ -91,7 +92,7 @@ static inline line_t *amlc_getline(cpu_t *cpu, int ctrl, int ln)
 {
   for(int n = 0; n < AMLC_MAXDEV; n++)
   {
-  amlc_t *amlc = amlc_device_table[n];
+  amlc_t *amlc = cpu->sys->amlc[n];
 
     if(amlc && amlc->ctrl == ctrl)
     {
@@ -512,10 +513,17 @@ fd_set fdset;
   sigaddset(&set, SIGTSTP);
   pthread_sigmask(SIG_BLOCK, &set, NULL);
 
-  if(bind(sock, (struct sockaddr *)&bindsock, sizeof(bindsock)))
+  // A migrated system waits for its source to release the port
+  for(int n = 0; bind(sock, (struct sockaddr *)&bindsock, sizeof(bindsock)); ++n)
   {
-    logmsg("amlc-l Failed to bind to socket errno=%d: %s\n", errno, strerror(errno));
-    return NULL;
+    if(errno != EADDRINUSE || !cpu->sys->incoming)
+    {
+      logmsg("amlc-l Failed to bind to socket errno=%d: %s\n", errno, strerror(errno));
+      return NULL;
+    }
+    if(!n)
+      logmsg("amlc-l Port in use, waiting\n");
+    sleep(1);
   }
 
   if(listen(sock, AMLC_BACKLOG))
@@ -560,17 +568,17 @@ fd_set fdset;
 }
 
 
-static pthread_t amlc_listener_tid = 0;
 static inline void amlc_connect(amlc_t *amlc)
 {
+  amlc_t **table = amlc->cpu->sys->amlc;
   int n = io_getslot(amlc->id);
   if(n >= AMLC_MAXDEV)
     n = 0;
   for(; n < AMLC_MAXDEV; n++)
   {
-    if(!amlc_device_table[n] || amlc_device_table[n] == amlc)
+    if(!table[n] || table[n] == amlc)
     {
-      amlc_device_table[n] = amlc;
+      table[n] = amlc;
       break;
     }
   }
@@ -712,10 +720,11 @@ logmsg("amlc %03o line %d send failed\n", amlc->ctrl, ln);
           fdmax = line->fdr;
       }
 
-      if(line->ls == conn)
+      if(line->ls == conn || line->ls == reat)
       {
-logmsg("amlc %03o line %d connected\n",amlc->ctrl, ln);
+logmsg("amlc %03o line %d %s\n",amlc->ctrl, ln, line->ls == reat ? "reattached" : "connected");
 
+        int reattached = line->ls == reat;
         line->ls = onln;
 #ifdef LIBTELNET
         void **parm = malloc(sizeof(void*));
@@ -738,6 +747,9 @@ logmsg("amlc %03o line %d connected\n",amlc->ctrl, ln);
         }
 #endif
 
+        if(reattached)
+          continue;
+
         amlc->st |= (amlc->st & ~AMLC_ST_LINE) | ln | AMLC_ST_DSC;
         line->ds = (ln << 12) | AMLC_DS_DSC3 | AMLC_DS_DSC2 | AMLC_DS_DSC1;
 
@@ -847,13 +859,162 @@ static inline void amlc_init(cpu_t *cpu, int type, int ext, int func, int ctrl,
 
   amlc_connect(*amlc);
 
-  if(!amlc_listener_tid)
-    pthread_create(&amlc_listener_tid, &(*amlc)->pthread.attr, amlc_listener, (*amlc)->cpu);
+  if(!cpu->sys->amlc_listener)
+    pthread_create(&cpu->sys->amlc_listener, &(*amlc)->pthread.attr, amlc_listener, (*amlc)->cpu);
 
   pthread_create(&(*amlc)->pthread.tid, &(*amlc)->pthread.attr, amlc_thread, *amlc);
 }
 
 
+/* Line connections belong to the host, a line whose connection
+ * state differs from the one saved reports a data set change
+ */
+static void amlc_snap(amlc_t *amlc, snap_t *s)
+{
+  pthread_mutex_lock(&(amlc->pthread.mutex));
+
+  SNAP(s, amlc->intr);
+  SNAP(s, amlc->va);
+  SNAP(s, amlc->ca);
+  SNAP(s, amlc->c1);
+  SNAP(s, amlc->da);
+  SNAP(s, amlc->cl);
+  SNAP(s, amlc->st);
+  SNAP(s, amlc->ra);
+  SNAP(s, amlc->im);
+  SNAP(s, amlc->dm);
+  SNAP(s, amlc->dv);
+  SNAP(s, amlc->in);
+
+  for(int ln = 0; ln < AMLC_LINES; ++ln)
+  {
+  line_t *line = &amlc->ln[ln];
+  int on = line->ls == onln || line->ls == conn || line->ls == reat;
+
+    SNAP(s, line->cf);
+    SNAP(s, line->cn);
+    SNAP(s, line->ds);
+    SNAP(s, on);
+
+    if(s->wr || s->err)
+      continue;
+
+    if((line->cf & AMLC_CF_LOOP) && line->ls != loop)
+      amlc_loop(line);
+    if(!(line->cf & AMLC_CF_LOOP) && line->ls == loop)
+      amlc_detach(line);
+
+    if(on != (line->ls == onln || line->ls == conn || line->ls == reat))
+    {
+      amlc->st |= (amlc->st & ~AMLC_ST_LINE) | ln | AMLC_ST_DSC;
+      line->ds = (line->ls == offl) ? (ln << 12) : (ln << 12) | AMLC_DS_DSC3 | AMLC_DS_DSC2 | AMLC_DS_DSC1;
+    }
+  }
+
+  pthread_mutex_unlock(&(amlc->pthread.mutex));
+}
+
+
+/* Pass connected lines to or from a migrating system over the
+ * unix socket sock, the connection itself travelling as SCM_RIGHTS
+ * so that telnet sessions survive the move.  The sender drops its
+ * copy; the receiver takes the lines over without a dataset change.
+ */
+int amlc_handoff(cpu_t *cpu, int sock, bool send)
+{
+int32_t msg[4];
+char cbuf[CMSG_SPACE(sizeof(int))];
+struct iovec iov = { .iov_base = msg, .iov_len = sizeof(msg) };
+struct msghdr mh = { .msg_iov = &iov, .msg_iovlen = 1, .msg_control = cbuf, .msg_controllen = sizeof(cbuf) };
+int n = 0;
+
+  if(send)
+  {
+    for(int a = 0; a < AMLC_MAXDEV; ++a)
+    {
+    amlc_t *amlc = cpu->sys->amlc[a];
+
+      if(!amlc)
+        continue;
+
+      pthread_mutex_lock(&(amlc->pthread.mutex));
+      for(int ln = 0; ln < AMLC_LINES; ++ln)
+      {
+      line_t *line = &amlc->ln[ln];
+
+        if(line->ls != onln || line->fds < 0 || line->fds != line->fdr)
+          continue;
+
+        msg[0] = amlc->ctrl; msg[1] = ln;
+        msg[2] = line->conn.inbinary; msg[3] = line->conn.outbinary;
+        mh.msg_controllen = sizeof(cbuf);
+        struct cmsghdr *cm = CMSG_FIRSTHDR(&mh);
+        cm->cmsg_level = SOL_SOCKET;
+        cm->cmsg_type = SCM_RIGHTS;
+        cm->cmsg_len = CMSG_LEN(sizeof(int));
+        memcpy(CMSG_DATA(cm), &line->fds, sizeof(int));
+
+        if(sendmsg(sock, &mh, 0) != sizeof(msg))
+        {
+          pthread_mutex_unlock(&(amlc->pthread.mutex));
+          return -1;
+        }
+
+        amlc_detach(line);
+        ++n;
+      }
+      pthread_mutex_unlock(&(amlc->pthread.mutex));
+    }
+
+    msg[0] = -1;
+    mh.msg_control = NULL; mh.msg_controllen = 0;
+    return sendmsg(sock, &mh, 0) == sizeof(msg) ? n : -1;
+  }
+
+  do {
+    mh.msg_control = cbuf; mh.msg_controllen = sizeof(cbuf);
+    if(recvmsg(sock, &mh, MSG_WAITALL) != sizeof(msg))
+      return -1;
+
+    struct cmsghdr *cm = CMSG_FIRSTHDR(&mh);
+    if(!cm || cm->cmsg_type != SCM_RIGHTS)
+      continue;
+
+    int fd;
+    memcpy(&fd, CMSG_DATA(cm), sizeof(int));
+    ioctl(fd, FIOCLEX, NULL);
+
+    line_t *line = (msg[1] >= 0 && msg[1] < AMLC_LINES) ? amlc_getline(cpu, msg[0], msg[1]) : NULL;
+    if(line)
+    {
+      pthread_mutex_lock(&(line->amlc->pthread.mutex));
+      if(line->ls != offl)
+      {
+        pthread_mutex_unlock(&(line->amlc->pthread.mutex));
+        line = NULL;
+      }
+    }
+
+    if(!line)
+    {
+      logmsg("amlc %03o line %d not available for reattach\n", msg[0], msg[1]);
+      close(fd);
+      continue;
+    }
+
+    line->fds = line->fdr = fd;
+    line->conn.amlc = line->conn.ln = 0;
+    line->conn.inbinary = msg[2];
+    line->conn.outbinary = msg[3];
+    line->ls = reat;
+    pthread_mutex_unlock(&(line->amlc->pthread.mutex));
+    ++n;
+  } while(msg[0] >= 0);
+
+  return n;
+}
+
+
 int amlc_io(cpu_t *cpu, int type, int ext, int func, int ctrl, void **devparm, int argc, char *argv[])
 {
 amlc_t *amlc = *devparm;
@@ -1042,6 +1203,9 @@ amlc_t *amlc = *devparm;
     case IO_TYPE_INI:
       amlc_init(cpu, type, ext, func, ctrl, (amlc_t **)devparm, argc, argv);
       break;
+    case IO_TYPE_SNP:
+      amlc_snap(amlc, (snap_t *)argv);
+      break;
     case IO_TYPE_ASN:
       {
       char *ahost, *aport, *aamlc = NULL, *aline = NULL;
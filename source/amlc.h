@@ -31,7 +31,7 @@
 #ifndef _amlc_h
 #define _amlc_h
 
-#define AMLC_MAXDEV 8
+#define AMLC_MAXDEV EM50_MAXAMLC
 #define AMLC_LINES 16
 #define AMLC_DFLTPORT 2323
 #define AMLC_BACKLOG 5
@@ -77,7 +77,7 @@ typedef struct {
 #define AMLC_DS_DSC2 0x0002   // DTR
 #define AMLC_DS_DSC1 0x0001   // RTS
   int fds, fdr;
-  enum { offl = 0, conn, onln, loop } ls;
+  enum { offl = 0, conn, onln, loop, reat } ls; // reat: handed over by a migration
   struct {
     int amlc; // amlc device number to connect to
     int ln;   // line number to connect to
@@ -126,5 +126,6 @@ typedef struct amlc_t {
 } amlc_t;
 
 int amlc_io(cpu_t *cpu, int, int, int, int, void **, int, char *[]);
+int amlc_handoff(cpu_t *cpu, int sock, bool send);
 
 #endif
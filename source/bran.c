@@ -56,7 +56,7 @@ uint16_t ea = E50X(vfetch_iw)(cpu);
     if(io_idle_wait(cpu, x))
     {
       S_X(cpu, 0);
-      longjmp(cpu->endop, endop_intrchk);
+      ENDOP(cpu, endop_intrchk);
     }
 
     x = 1;
@@ -530,7 +530,7 @@ uint16_t ea = E50X(vfetch_iw)(cpu);
 
   logop2o(op, "blr", ea);
 
-  if(!cpu->crs->km.link)
+  if(!CC_LINK(cpu))
     cpu->p = ea;
 }
 #endif
@@ -547,7 +547,7 @@ uint16_t ea = E50X(vfetch_iw)(cpu);
 
   logop2o(op, "bls", ea);
 
-  if(cpu->crs->km.link)
+  if(CC_LINK(cpu))
     cpu->p = ea;
 }
 #endif
@@ -570,7 +570,7 @@ uint16_t ea = E50X(vfetch_iw)(cpu);
 
   logop2o(op, "bmge", ea);
 
-  if(cpu->crs->km.link)
+  if(CC_LINK(cpu))
     cpu->p = ea;
 }
 
@@ -581,7 +581,7 @@ uint16_t ea = E50X(vfetch_iw)(cpu);
 
   logop2o(op, "bmgt", ea);
 
-  if(cpu->crs->km.link && CC_NE(cpu))
+  if(CC_LINK(cpu) && CC_NE(cpu))
     cpu->p = ea;
 }
 
@@ -592,7 +592,7 @@ uint16_t ea = E50X(vfetch_iw)(cpu);
 
   logop2o(op, "bmle", ea);
 
-  if((!cpu->crs->km.link) || CC_EQ(cpu))
+  if((!CC_LINK(cpu)) || CC_EQ(cpu))
     cpu->p = ea;
 }
 
@@ -603,7 +603,7 @@ uint16_t ea = E50X(vfetch_iw)(cpu);
 
   logop2o(op, "bmlt", ea);
 
-  if(!(cpu->crs->km.link) || CC_GE(cpu))
+  if(!(CC_LINK(cpu)) || CC_GE(cpu))
     cpu->p = ea;
 }
 
@@ -89,18 +89,120 @@ uint16_t w = E50X(vfetch_w)(cpu, *far1);
     inc_d(far1);
 }
 
+#if defined(HMDE)
+/* Number of bytes from far/fbr up to the end of its page, at most len */
+static inline int zspan(uint32_t far, int fbr, int len)
+{
+int n = ((em50_page_size - (far & em50_page_offm)) << 1) - (fbr ? 1 : 0);
+
+  return n < len ? n : len;
+}
+
+static inline void zadv(uint32_t *far, int *fbr, int n)
+{
+  n += *fbr ? 1 : 0;
+  *far = intraseg_i(*far, n >> 1);
+  *fbr = (n & 1) ? 8 : 0;
+}
+
+/* Character moves run left to right, an overlapping destination
+   propagates the source as it would a byte at a time */
+static inline void zcopy(uint8_t *d, const uint8_t *s, int n)
+{
+  if(d <= s || d >= s + n)
+    memmove(d, s, n);
+  else
+    while(n--)
+      *d++ = *s++;
+}
+
+/* Number of leading bytes that are equal, 32 bytes at a time first */
+static inline int zmatch(const uint8_t *a, const uint8_t *b, int n)
+{
+int k = 0;
+
+  for(; k + 32 <= n && !memcmp(a + k, b + k, 32); k += 32);
+  for(; k < n && a[k] == b[k]; ++k);
+
+  return k;
+}
+
+static inline int zmatchc(const uint8_t *a, uint8_t c, int n)
+{
+uint8_t b[32];
+int k = 0;
+
+  memset(b, c, sizeof(b));
+  for(; k + 32 <= n && !memcmp(a + k, b, 32); k += 32);
+  for(; k < n && a[k] == c; ++k);
+
+  return k;
+}
+#endif
+
+
+/* Bulk copy of n bytes, both operands are translated once per page.
+   Storage is kept big-endian so a byte string is contiguous in host
+   storage. Translation faults are taken at the first byte of a page,
+   with all preceding bytes moved, as with the byte at a time copy */
+static inline void E50X(copy)(cpu_t *cpu, int n, uint32_t *src, int *srb, uint32_t *dst, int *dsb)
+{
+  while(n)
+  {
+    if(ISAT(cpu, *src) || ISAT(cpu, *dst))
+    {
+    int flr = 1;
+      E50X(store_byte)(cpu, E50X(load_byte)(cpu, src, srb, &flr), dst, dsb);
+      --n;
+      continue;
+    }
+
+    int l = zspan(*dst, *dsb, zspan(*src, *srb, n));
+    uint8_t *s = E50X(v2h)(cpu, WXX(*src), acc_rd) + (*srb ? 1 : 0);
+    uint8_t *d = E50X(v2h)(cpu, WXX(*dst), acc_wr) + (*dsb ? 1 : 0);
+
+    zcopy(d, s, l);
+    ic_store(cpu, h2r(cpu, d), (l + (*dsb ? 1 : 0) + 1) >> 1);
+
+    zadv(src, srb, l);
+    zadv(dst, dsb, l);
+    n -= l;
+  }
+}
+
+static inline void E50X(fill)(cpu_t *cpu, int n, uint8_t c, uint32_t *dst, int *dsb)
+{
+  while(n)
+  {
+    if(ISAT(cpu, *dst))
+    {
+      E50X(store_byte)(cpu, c, dst, dsb);
+      --n;
+      continue;
+    }
+
+    int l = zspan(*dst, *dsb, n);
+    uint8_t *d = E50X(v2h)(cpu, WXX(*dst), acc_wr) + (*dsb ? 1 : 0);
+
+    memset(d, c, l);
+    ic_store(cpu, h2r(cpu, d), (l + (*dsb ? 1 : 0) + 1) >> 1);
+
+    zadv(dst, dsb, l);
+    n -= l;
+  }
+}
+
+
 #define ZED_CPC 0b00
 static inline void E50X(zed_cpc)(cpu_t *cpu, uint8_t m, uint32_t *far0, int *fbr0, int *flr0, uint32_t *far1, int *fbr1)
 {
 uint8_t c = cpu->crs->km.ascii ? 040: 0240;
 int count = *flr0 < m ? *flr0 : m;
-int n = 0;
 
-  for(; n < count; ++n)
-    E50X(store_byte)(cpu, E50X(load_byte)(cpu, far0, fbr0, flr0), far1, fbr1);
+  E50X(copy)(cpu, count, far0, fbr0, far1, fbr1);
+  *flr0 -= count;
 
-  for(; n < m; ++n)
-    E50X(store_byte)(cpu, c, far1, fbr1);
+  E50X(fill)(cpu, m - count, c, far1, fbr1);
 }
 
 #define ZED_INL 0b01
@@ -124,96 +226,20 @@ static inline void E50X(zed_blk)(cpu_t *cpu, uint8_t m, uint32_t *far1, int *fbr
 {
 uint8_t c = cpu->crs->km.ascii ? 040: 0240;
 
-  for(int i = 0; i < m; ++i)
-    E50X(store_byte)(cpu, c, far1, fbr1);
+  E50X(fill)(cpu, m, c, far1, fbr1);
 }
 
 
 static inline void E50X(move)(cpu_t *cpu, uint32_t src, int srb, int srl, uint32_t dst, int dsb, int dsl)
 {
-  while(srl && dsl)
-  {
-  uint16_t w;
-    
-    w = E50X(vfetch_w)(cpu, src);
+int n = srl < dsl ? srl : dsl;
 
-    if(dsb == 0 && srb == 0 && dsl > 1 && srl > 1)
-    {
-      E50X(vstore_w)(cpu, dst, w);
-      inc_d(&src);
-      inc_d(&dst);
-      srl -= 2;
-      dsl -= 2;
-    }
-    else if(dsb != 0 && srb != 0)
-    {
-      uint16_t t = E50X(vfetch_w)(cpu, dst);
-      t = (t & 0xff00) | (w & 0x00ff);
-      E50X(vstore_w)(cpu, dst, t);
-      inc_d(&src); srb = 0;
-      inc_d(&dst); dsb = 0;
-      --srl;
-      --dsl;
-    }
-    else if(dsb != 0 && srb == 0)
-    {
-      uint16_t t = E50X(vfetch_w)(cpu, dst);
-      t = (t & 0xff00) | (w >> 8);
-      E50X(vstore_w)(cpu, dst, t);
-      srb = 8;
-      inc_d(&dst); dsb = 0;
-      --srl;
-      --dsl;
-    }
-    else if(dsb == 0 && srb != 0)
-    {
-      uint16_t t = E50X(vfetch_w)(cpu, dst);
-      t = (t & 0x00ff) | (w << 8);
-      E50X(vstore_w)(cpu, dst, t);
-      inc_d(&src); srb = 0;
-      dsb = 8;
-      --srl;
-      --dsl;
-    }
-    else /* dsb == 0 && srb == 0 && srl == 1 */
-    {
-      uint16_t t = E50X(vfetch_w)(cpu, dst);
-      t = (t & 0x00ff) | (w & 0xff00);
-      E50X(vstore_w)(cpu, dst, t);
-      srb = 8;
-      dsb = 8;
-      --srl;
-      --dsl;
-    }
-  }
+  E50X(copy)(cpu, n, &src, &srb, &dst, &dsb);
+  srl -= n;
+  dsl -= n;
 
-  uint16_t w = cpu->crs->km.ascii ? 020040: 0120240;
-
-  while(dsl)
-  {
-    if(dsb == 0 && dsl > 1)
-    {
-      E50X(vstore_w)(cpu, dst, w);
-      inc_d(&dst);
-      dsl -= 2;
-    }
-    else if(dsb != 0)
-    {
-      uint16_t t = E50X(vfetch_w)(cpu, dst);
-      t = (t & 0xff00) | (w & 0x00ff);
-      E50X(vstore_w)(cpu, dst, t);
-      inc_d(&dst); dsb = 0;
-      --dsl;
-    }
-    else /* dsl == 1 */
-    {
-      uint16_t t = E50X(vfetch_w)(cpu, dst);
-      t = (t & 0x00ff) | (w & 0xff00);
-      E50X(vstore_w)(cpu, dst, t);
-      dsb = 8;
-      --dsl;
-    }
-  }
+  E50X(fill)(cpu, dsl, cpu->crs->km.ascii ? 040: 0240, &dst, &dsb);
+  dsl = 0;
 
   S_FAR(cpu, 0, src);
   S_FBR(cpu, 0, srb);
@@ -225,11 +251,32 @@ static inline void E50X(move)(cpu_t *cpu, uint32_t src, int srb, int srl, uint32
 
 static inline void E50X(compare)(cpu_t *cpu, uint32_t src, int srb, int srl, uint32_t dst, int dsb, int dsl)
 {
+  cc_sync(cpu);
   cpu->crs->km.eq = 1;
   cpu->crs->km.lt = 0;
 
   while(srl && dsl)
   {
+    /* Skip the equal part of both page spans, stopping on a step of
+       the loop below so that it sets FAR/FBR/FLR at a mismatch */
+    if(!ISAT(cpu, src) && !ISAT(cpu, dst))
+    {
+      int n = zspan(dst, dsb, zspan(src, srb, srl < dsl ? srl : dsl));
+      uint8_t *s = E50X(v2h)(cpu, WXX(src), acc_rd) + (srb ? 1 : 0);
+      uint8_t *d = E50X(v2h)(cpu, WXX(dst), acc_rd) + (dsb ? 1 : 0);
+
+      n = zmatch(s, d, n);
+      if(!srb && !dsb)
+        n &= ~1;
+      zadv(&src, &srb, n);
+      zadv(&dst, &dsb, n);
+      srl -= n;
+      dsl -= n;
+
+      if(!(srl && dsl))
+        break;
+    }
+
   uint16_t t, w = E50X(vfetch_w)(cpu, src);
 
     if(dsb == 0 && srb == 0 && dsl > 1 && srl > 1)
@@ -299,6 +346,7 @@ static inline void E50X(compare)(cpu_t *cpu, uint32_t src, int srb, int srl, uin
         S_FAR(cpu, 1, dst-2);
         S_FLR(cpu, 1, dsl+2);
       }
+      cc_sync(cpu);
       cpu->crs->km.eq = 0;
       cpu->crs->km.lt = w < t ? 1 : 0;
       return;
@@ -307,6 +355,20 @@ static inline void E50X(compare)(cpu_t *cpu, uint32_t src, int srb, int srl, uin
 
   while(dsl)
   {
+    if(!ISAT(cpu, dst))
+    {
+      int n = zspan(dst, dsb, dsl);
+
+      n = zmatchc(E50X(v2h)(cpu, WXX(dst), acc_rd) + (dsb ? 1 : 0), cpu->crs->km.ascii ? 040 : 0240, n);
+      if(!dsb)
+        n &= ~1;
+      zadv(&dst, &dsb, n);
+      dsl -= n;
+
+      if(!dsl)
+        break;
+    }
+
     uint16_t t, w = cpu->crs->km.ascii ? 020040: 0120240;
 
 //  S_FAR(cpu, 1, dst);
@@ -349,6 +411,7 @@ static inline void E50X(compare)(cpu_t *cpu, uint32_t src, int srb, int srl, uin
         S_FAR(cpu, 1, dst-2);
         S_FLR(cpu, 1, dsl+2);
       }
+      cc_sync(cpu);
       cpu->crs->km.eq = 0;
       cpu->crs->km.lt = w < t ? 1 : 0;
       return;
@@ -357,6 +420,20 @@ static inline void E50X(compare)(cpu_t *cpu, uint32_t src, int srb, int srl, uin
 
   while(srl)
   {
+    if(!ISAT(cpu, src))
+    {
+      int n = zspan(src, srb, srl);
+
+      n = zmatchc(E50X(v2h)(cpu, WXX(src), acc_rd) + (srb ? 1 : 0), cpu->crs->km.ascii ? 040 : 0240, n);
+      if(!srb)
+        n &= ~1;
+      zadv(&src, &srb, n);
+      srl -= n;
+
+      if(!srl)
+        break;
+    }
+
     uint16_t w, t = cpu->crs->km.ascii ? 020040: 0120240;
 
 //  S_FAR(cpu, 0, src);
@@ -399,6 +476,7 @@ static inline void E50X(compare)(cpu_t *cpu, uint32_t src, int srb, int srl, uin
         S_FAR(cpu, 0, src-2);
         S_FLR(cpu, 0, srl+2);
       }
+      cc_sync(cpu);
       cpu->crs->km.eq = 0;
       cpu->crs->km.lt = w < t ? 1 : 0;
       return;
@@ -422,96 +500,85 @@ uint16_t t = E50X(vfetch_w)(cpu, x);
   return (c & 1) ? t & 0xff : t >> 8;
 }
 
-static inline uint16_t E50X(trtab_w)(cpu_t *cpu, uint32_t trt, uint16_t w)
-{
-sw_t r = {.w = w};
-
-  r.l = E50X(trtab)(cpu, trt, r.l);
-  r.h = E50X(trtab)(cpu, trt, r.h);
-
-  return r.w;
-}
-
-static inline uint16_t E50X(trtab_h)(cpu_t *cpu, uint32_t trt, uint16_t w)
-{
-sw_t r = {.w = w};
-
-  r.h = E50X(trtab)(cpu, trt, r.h);
-
-  return r.w;
-}
-
-static inline uint16_t E50X(trtab_l)(cpu_t *cpu, uint32_t trt, uint16_t w)
+/* Host address of the translate table, or NULL when the table crosses
+   a page or is in the register file and has to be read per character */
+static inline uint8_t *E50X(trtab_p)(cpu_t *cpu, uint32_t trt)
 {
-sw_t r = {.w = w};
+  if(ISAT(cpu, trt) || page_cross_x(trt, 0177))
+    return NULL;
 
-  r.l = E50X(trtab)(cpu, trt, r.l);
-
-  return r.w;
+  return E50X(v2h)(cpu, WXX(trt), acc_rd);
 }
 
 static inline void E50X(translate)(cpu_t *cpu, uint32_t src, int srb, int srl, uint32_t dst, int dsb, int dsl, uint32_t trt)
 {
-  while(srl && dsl)
+uint8_t *tab = NULL;
+int n = srl < dsl ? srl : dsl;
+
+  while(n)
   {
-  uint16_t w;
-    
-    w = E50X(vfetch_w)(cpu, src);
+    uint8_t *s = NULL;
 
-    if(dsb == 0 && srb == 0 && srl > 1 && dsl > 1)
-    {
-      w = E50X(trtab_w)(cpu, trt, w);
-      E50X(vstore_w)(cpu, dst, w);
-      inc_d(&src);
-      inc_d(&dst);
-      srl -= 2;
-      dsl -= 2;
-    }
-    else if(dsb != 0 && srb != 0)
+    if(!ISAT(cpu, src) && !ISAT(cpu, dst))
     {
-      w = E50X(trtab_l)(cpu, trt, w);
-      uint16_t t = E50X(vfetch_w)(cpu, dst);
-      t = (t & 0xff00) | (w & 0x00ff);
-      E50X(vstore_w)(cpu, dst, t);
-      inc_d(&src); srb = 0;
-      inc_d(&dst); dsb = 0;
-      --srl;
-      --dsl;
+      s = E50X(v2h)(cpu, WXX(src), acc_rd) + (srb ? 1 : 0);
+      if(!tab)
+        tab = E50X(trtab_p)(cpu, trt);
     }
-    else if(dsb != 0 && srb == 0)
-    {
-      w = E50X(trtab_h)(cpu, trt, w);
-      uint16_t t = E50X(vfetch_w)(cpu, dst);
-      t = (t & 0xff00) | (w >> 8);
-      E50X(vstore_w)(cpu, dst, t);
-      srb = 8;
-      inc_d(&dst); dsb = 0;
-      --srl;
-      --dsl;
-    }
-    else if(dsb == 0 && srb != 0)
+
+    if(!s || !tab)
     {
-      w = E50X(trtab_l)(cpu, trt, w);
-      uint16_t t = E50X(vfetch_w)(cpu, dst);
-      t = (t & 0x00ff) | (w << 8);
-      E50X(vstore_w)(cpu, dst, t);
-      inc_d(&src); srb = 0;
-      dsb = 8;
-      --srl;
+      if(!srb && !dsb && n > 1)
+      {
+        uint16_t w = E50X(vfetch_w)(cpu, src);
+        w = (E50X(trtab)(cpu, trt, w >> 8) << 8) | E50X(trtab)(cpu, trt, w & 0xff);
+        E50X(vstore_w)(cpu, dst, w);
+        inc_d(&src);
+        inc_d(&dst);
+        n -= 2;
+        dsl -= 2;
+        continue;
+      }
+
+    int flr = 1;
+      uint8_t c = E50X(load_byte)(cpu, &src, &srb, &flr);
+      E50X(store_byte)(cpu, E50X(trtab)(cpu, trt, c), &dst, &dsb);
+      --n;
       --dsl;
+      continue;
     }
-    else /* dsb == 0 && srb == 0 && srl == 1 */
+
+    int l = zspan(dst, dsb, zspan(src, srb, n));
+    uint8_t *d = E50X(v2h)(cpu, WXX(dst), acc_wr) + (dsb ? 1 : 0);
+
+    /* Left to right, as the table or source may be overlaid, both
+       bytes of a word are looked up before it is stored when source
+       and destination are aligned alike */
+    if(srb == dsb)
     {
-      w = E50X(trtab_h)(cpu, trt, w);
-      uint16_t t = E50X(vfetch_w)(cpu, dst);
-      t = (t & 0x00ff) | (w & 0xff00);
-      E50X(vstore_w)(cpu, dst, t);
-      srb = 8;
-      dsb = 8;
-      --srl;
-      --dsl;
+      int i = 0;
+      if(dsb)
+        d[i++] = tab[*s];
+      for(; i + 1 < l; i += 2)
+      {
+        uint8_t h = tab[s[i]], t = tab[s[i + 1]];
+        d[i] = h;
+        d[i + 1] = t;
+      }
+      if(i < l)
+        d[i] = tab[s[i]];
     }
+    else
+      for(int i = 0; i < l; ++i)
+        d[i] = tab[s[i]];
+    ic_store(cpu, h2r(cpu, d), (l + (dsb ? 1 : 0) + 1) >> 1);
+
+    zadv(&src, &srb, l);
+    zadv(&dst, &dsb, l);
+    n -= l;
+    dsl -= l;
   }
+
   S_FAR(cpu, 0, src);
 //S_FLR(cpu, 0, srl);
   S_FBR(cpu, 0, srb);
@@ -534,6 +601,7 @@ int bit = G_FBR(cpu, f);
 
   if(flr == 0)
   {
+    cc_sync(cpu);
     cpu->crs->km.eq = 1;
     cpu->crs->km.lt = 0;
     return;
@@ -564,6 +632,7 @@ int bit = G_FBR(cpu, f);
 #else
   S_A(cpu, c);
 #endif
+  cc_sync(cpu);
   cpu->crs->km.eq = 0;
   cpu->crs->km.lt = 0;
 }
@@ -582,6 +651,7 @@ int bit = G_FBR(cpu, f);
 
   if(flr == 0)
   {
+    cc_sync(cpu);
     cpu->crs->km.eq = 1;
     cpu->crs->km.lt = 0;
     return;
@@ -620,6 +690,7 @@ int bit = G_FBR(cpu, f);
     S_FBR(cpu, f, 8);
 
   logmsg("-> far%d %8.8x flr %8.8x fbr %d\n", f, G_FAR(cpu, f), G_FLR(cpu, f), G_FBR(cpu, f));
+  cc_sync(cpu);
   cpu->crs->km.eq = 0;
   cpu->crs->km.lt = 0;
 }
@@ -632,47 +703,15 @@ uint32_t far = G_FAR(cpu, f);
 int flr = G_FLR(cpu, f);
 int bit = G_FBR(cpu, f);
 #ifdef I_MODE
-uint16_t c = G_RH(cpu, 2) & 0xff;
+uint8_t c = G_RH(cpu, 2) & 0xff;
 #else
-uint16_t c = G_A(cpu) & 0xff;
+uint8_t c = G_A(cpu) & 0xff;
 #endif
 
   logop1oo(op, "zfil", f, c);
   logmsg("-> far%d %8.8x flr %8.8x fbr %d\n", f, G_FAR(cpu, f), G_FLR(cpu, f), G_FBR(cpu, f));
 
-  c |= c << 8;
-
-  while(flr)
-  {
-    if(bit != 0)
-    {
-      uint16_t w = E50X(vfetch_w)(cpu, far);
-      w &= 0xff00;
-      w |= c & 0xff;
-      E50X(vstore_w)(cpu, far, w);
-      --flr;
-      bit = 0;
-      inc_d(&far);
-    }
-    else
-    {
-      if(flr > 1)
-      {
-        E50X(vstore_w)(cpu, far, c);
-        flr -= 2;
-        inc_d(&far);
-      }
-      else /* flr == 1 */
-      {
-        uint16_t w = E50X(vfetch_w)(cpu, far);
-        w &= 0x00ff;
-        w |= c & 0xff00;
-        E50X(vstore_w)(cpu, far, w);
-        --flr;
-        bit = 8;
-      }
-    }
-  }
+  E50X(fill)(cpu, flr, c, &far, &bit);
 
   S_FLR(cpu, f, 0);
   S_FAR(cpu, f, far);
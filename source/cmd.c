@@ -44,6 +44,12 @@
 
 #include "help.h"
 
+#include "fuse.h"
+
+#include "snap.h"
+
+#include "dirty.h"
+
 static const char *prompt = "CP> ";
 #ifndef __APPLE__
 const
@@ -274,7 +280,11 @@ uint32_t addr = 0; uint16_t val;
       raddr = addr + n - 3;
 
     if(raddr < (cpu->sys->physsize>>1))
+    {
       store_w(physad(cpu, raddr), val);
+      ic_store(cpu, raddr, 1);
+      dirty_mark(cpu, raddr);
+    }
     else
     {
       printf("R%6.6X Storage not available\n", raddr);
@@ -422,18 +432,17 @@ static int cmd_lightsc(int argc, char *argv[], cpu_t *cpu)
 
 static inline int cmd_dispintr(int argc, char *argv[], cpu_t *cpu)
 {
-  int p = io_pending(cpu);
-  int a = cpu->intr.a;
-  int n = a;
-  printf("INT Q %d/%d\n", a, cpu->intr.n);
+  unsigned a = cpu->intr.a;
+  unsigned n = atomic_load(&cpu->intr.n);
+  printf("INT Q %d/%d\n", a & INTR_QMASK, n & INTR_QMASK);
   if(cpu->intr.c >= 0)
     printf("INT V %4.4X ACTIVE\n", cpu->intr.c);
-  if(p)
-    do {
-      if(cpu->intr.v[n] >= 0)
-        printf("INT Q[%d] V %4.4X\n", n, cpu->intr.v[n]);
-      n = io_incrnxt(n);
-    } while (a != n);
+  for(; a != n; ++a)
+  {
+    int32_t v = atomic_load(&cpu->intr.v[a & INTR_QMASK]);
+    if(v >= 0)
+      printf("INT Q[%d] V %4.4X\n", a & INTR_QMASK, v);
+  }
 
   return 0;
 }
@@ -937,6 +946,342 @@ char c;
 #endif
 
 
+static int cmd_tlb(int argc, char *argv[], cpu_t *cpu)
+{
+  if(argc > 1)
+  {
+  int n; char c;
+
+    if(!strcasecmp(argv[1], "reset"))
+    {
+      memset(cpu->tlb.hit, 0, sizeof(cpu->tlb.hit));
+      memset(cpu->tlb.miss, 0, sizeof(cpu->tlb.miss));
+      memset(cpu->tlb.evict, 0, sizeof(cpu->tlb.evict));
+      return 0;
+    }
+
+    if(sscanf(argv[1], "%i%c", &n, &c) != 1 || n < TLB_MIN || n > TLB_MAX || (n & (n - 1)))
+    {
+      printf("Invalid TLB size (%s), must be a power of 2 from %d to %d\n", argv[1], TLB_MIN, TLB_MAX);
+      return 1;
+    }
+
+    if(cpu->halt.status != stopped)
+    {
+      printf("CPU must not be running\n");
+      return 1;
+    }
+
+    cpu->tlb.mask = n / TLB_WAYS - 1;
+    mm_ptlb(cpu);
+
+    return 0;
+  }
+
+uint64_t hit = 0, miss = 0, evict = 0;
+
+  printf("TLB %d entries, %d sets of %d ways\n", (cpu->tlb.mask + 1) * TLB_WAYS, cpu->tlb.mask + 1, TLB_WAYS);
+  printf("WAY %20s %20s %20s\n", "HITS", "MISSES", "EVICTIONS");
+  for(int w = 0; w < TLB_WAYS; ++w)
+  {
+    printf("%3d %20ju %20ju %20ju\n", w, (uintmax_t)cpu->tlb.hit[w], (uintmax_t)cpu->tlb.miss[w], (uintmax_t)cpu->tlb.evict[w]);
+    hit += cpu->tlb.hit[w];
+    miss += cpu->tlb.miss[w];
+    evict += cpu->tlb.evict[w];
+  }
+  printf("ALL %20ju %20ju %20ju\n", (uintmax_t)hit, (uintmax_t)miss, (uintmax_t)evict);
+  if(hit + miss)
+    printf("HIT RATIO %.2f%%\n", (100.0 * hit) / (hit + miss));
+
+  return 0;
+}
+
+
+static int cmd_pairs_cmp(const void *a, const void *b)
+{
+uint64_t n = ((const typeof(((pairs_t *)0)->e[0]) *)a)->n;
+uint64_t m = ((const typeof(((pairs_t *)0)->e[0]) *)b)->n;
+
+  return n < m ? 1 : n > m ? -1 : 0;
+}
+
+
+static const char *cmd_pairs_name(inst_t h, char *buf, size_t len)
+{
+Dl_info di;
+
+  if(dladdr((void *)h, &di) && di.dli_sname)
+    return di.dli_sname;
+
+  snprintf(buf, len, "%p", (void *)h);
+  return buf;
+}
+
+
+static int cmd_pairs(int argc, char *argv[], cpu_t *cpu)
+{
+sys_t *sys = cpu->sys;
+int top = 20;
+
+  if(argc > 1)
+  {
+  char c;
+
+    if(!strcasecmp(argv[1], "reset"))
+    {
+      if(cpu->pairs)
+        memset(cpu->pairs, 0, sizeof(pairs_t));
+      return 0;
+    }
+
+    if(!strcasecmp(argv[1], "on") || !strcasecmp(argv[1], "off") || !strcasecmp(argv[1], "fuse"))
+    {
+      bool on = !strcasecmp(argv[argc - 1], "on");
+
+      if(!strcasecmp(argv[1], "fuse") && (argc != 3 || (!on && strcasecmp(argv[2], "off"))))
+      {
+        printf("Specify PAIRS FUSE ON or OFF\n");
+        return 1;
+      }
+
+      for(int n = 0; n < sys->ncpu; ++n)
+        if(sys->cpu[n]->halt.status != stopped)
+        {
+          printf("CPU must not be running\n");
+          return 1;
+        }
+
+      if(!strcasecmp(argv[1], "fuse"))
+        sys->nofuse = !on;
+      else
+        if(on && !cpu->pairs)
+        {
+          if(!(cpu->pairs = calloc(1, sizeof(pairs_t))))
+          {
+            printf("calloc(pairs) failed rc=%d: %s\n", errno, strerror(errno));
+            return 1;
+          }
+        }
+        else
+          if(!on && cpu->pairs)
+          {
+            free(cpu->pairs);
+            cpu->pairs = NULL;
+          }
+
+      ic_purge(cpu);
+
+      return 0;
+    }
+
+    if(sscanf(argv[1], "%i%c", &top, &c) != 1 || top < 1)
+    {
+      printf("Invalid number of pairs (%s)\n", argv[1]);
+      return 1;
+    }
+  }
+
+  printf("Instruction pair fusion is %s, profiling is %s\n", sys->nofuse ? "off" : "on", cpu->pairs ? "on" : "off");
+
+  if(!cpu->pairs)
+    return 0;
+
+typeof(cpu->pairs->e[0]) *e = malloc(sizeof(cpu->pairs->e));
+uint64_t total = cpu->pairs->other;
+int n = 0;
+
+  if(!e)
+  {
+    printf("malloc(pairs) failed rc=%d: %s\n", errno, strerror(errno));
+    return 1;
+  }
+
+  for(int x = 0; x < PAIRS_SIZE; ++x)
+    if(cpu->pairs->e[x].n)
+    {
+      e[n++] = cpu->pairs->e[x];
+      total += cpu->pairs->e[x].n;
+    }
+
+  qsort(e, n, sizeof(*e), cmd_pairs_cmp);
+
+  printf("%ju pairs, %d distinct, %ju not recorded\n", (uintmax_t)total, n, (uintmax_t)cpu->pairs->other);
+  if(n)
+    printf("%20s %7s %-20s %6s %-20s %6s\n", "COUNT", "%", "FIRST", "INST", "SECOND", "INST");
+  for(int x = 0; x < n && x < top; ++x)
+  {
+  char a[24], b[24];
+
+    printf("%20ju %6.2f%% %-20s %6.6o %-20s %6.6o\n", (uintmax_t)e[x].n, (100.0 * e[x].n) / total,
+      cmd_pairs_name(e[x].a, a, sizeof(a)), e[x].wa, cmd_pairs_name(e[x].b, b, sizeof(b)), e[x].wb);
+  }
+
+  free(e);
+
+  return 0;
+}
+
+static int cmd_save(int argc, char *argv[], cpu_t *cpu)
+{
+  if(argc != 2)
+  {
+    printf("Specify a file name\n");
+    return 1;
+  }
+
+  if(snap_save(cpu, argv[1]))
+  {
+    printf("Save to %s failed: %s\n", argv[1], strerror(errno));
+    return 1;
+  }
+
+  return 0;
+}
+
+
+static int cmd_restore(int argc, char *argv[], cpu_t *cpu)
+{
+  if(argc != 2)
+  {
+    printf("Specify a file name\n");
+    return 1;
+  }
+
+  if(snap_restore(cpu, argv[1]))
+  {
+    printf("Restore of %s failed: %s\n", argv[1], strerror(errno));
+    return 1;
+  }
+
+  if(cpu->halt.status == started && cpu->sys->tmode == st)
+    cmd_termx(cpu);
+
+  return 0;
+}
+
+
+static int cmd_clone(int argc, char *argv[], cpu_t *cpu)
+{
+sys_t *sys = cpu->sys;
+
+  if(argc < 2)
+  {
+    for(int k = 0; k < sys->nclones; ++k)
+    {
+    struct clone_t *c = &sys->clones[k];
+    int rs;
+
+      if(c->pid > 0 && waitpid(c->pid, &rs, WNOHANG) == c->pid)
+        c->pid = 0;
+
+      printf("CLONE %d pid %d port %d pncport %d%s\n", k + 1, c->pid, c->aport, c->pport, c->pid ? "" : " (ended)");
+    }
+    return 0;
+  }
+
+  int n = a2i(argv[1]);
+  if(n < 1)
+  {
+    printf("Invalid count %s\n", argv[1]);
+    return 1;
+  }
+
+  if(snap_clone(cpu, n, argc > 2 ? a2i(argv[2]) : 0, argc > 3 ? a2i(argv[3]) : 0))
+  {
+    printf("Clone failed: %s\n", strerror(errno));
+    return 1;
+  }
+
+  return 0;
+}
+
+
+static int cmd_checkpoint(int argc, char *argv[], cpu_t *cpu)
+{
+bool base = argc == 3 && !strcasecmp(argv[1], "BASE");
+struct timespec t0, t1;
+
+  if(argc != 2 && !base)
+  {
+    printf("Specify a file name\n");
+    return 1;
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &t0);
+  ssize_t n = snap_checkpoint(cpu, argv[argc - 1], base);
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+
+  if(n < 0)
+  {
+    printf("Checkpoint to %s failed: %s\n", argv[argc - 1], strerror(errno));
+    return 1;
+  }
+
+  printf("Checkpoint %s %zd pages %.1fms\n", cpu->sys->ckpt, n,
+    (t1.tv_sec - t0.tv_sec) * 1e3 + (t1.tv_nsec - t0.tv_nsec) / 1e6);
+
+  return 0;
+}
+
+
+static int cmd_migrate(int argc, char *argv[], cpu_t *cpu)
+{
+snapmig_t m;
+
+  if(argc != 2)
+  {
+    printf("Specify a socket\n");
+    return 1;
+  }
+
+  if(snap_migrate(cpu, argv[1], &m))
+  {
+    printf("Migration to %s failed after %d rounds: %s\n", argv[1], m.rounds, strerror(errno));
+    return 1;
+  }
+
+  printf("Migrated to %s %d rounds %zu pages, held %.1fms for %zu pages, %d lines\n",
+    argv[1], m.rounds, m.pages, m.held, m.last, m.lines);
+
+  return -1;
+}
+
+
+static int cmd_dirty(int argc, char *argv[], cpu_t *cpu)
+{
+sys_t *sys = cpu->sys;
+
+  if(argc < 2)
+  {
+    size_t n = dirty_sync(sys);
+    printf("%zu of %zu pages written (%zuKB)%s\n", n, dirty_pages(sys), n * em50_pgoc_size / 1024, sys->softdirty ? " soft-dirty" : "");
+  }
+  else if(!strcasecmp(argv[1], "RESET"))
+  {
+  int status[EM50_MAXCPU];
+
+    snap_stop(sys, status);
+    dirty_reset(sys);
+    snap_start(sys, status);
+  }
+  else if(!strcasecmp(argv[1], "SOFT"))
+  {
+    if(dirty_soft(sys, argc < 3 || strcasecmp(argv[2], "OFF")))
+    {
+      printf("Soft-dirty tracking not available: %s\n", strerror(errno));
+      return 1;
+    }
+  }
+  else
+  {
+    printf("Invalid operand %s\n", argv[1]);
+    return 1;
+  }
+
+  return 0;
+}
+
+
 static int cmd_quit(int argc, char *argv[], cpu_t *cpu)
 { return -1; }
 
@@ -990,6 +1335,15 @@ static const struct {
   { "SDATASW",  2, okrc, cmd_sdatasw,  &help_sdatasw },
   { "LIGHTS",   2, okrc, cmd_lights,   &help_lights },
   { "LIGHTSC",  7, norc, cmd_lightsc,  &help_nohelp },
+  { "TLB",      3, okrc, cmd_tlb,      &help_tlb },
+  { "PAIRS",    4, okrc, cmd_pairs,    &help_pairs },
+  { "SAVE",     4, okrc, cmd_save,     &help_save },
+  { "RESTORE",  4, okrc, cmd_restore,  &help_restore },
+  { "CLONE",    2, okrc, cmd_clone,    &help_clone },
+  { "FORK",     4, okrc, cmd_clone,    &help_nohelp },
+  { "DIRTY",    3, okrc, cmd_dirty,    &help_dirty },
+  { "CHECKPOINT", 5, okrc, cmd_checkpoint, &help_checkpoint },
+  { "MIGRATE",  3, norc, cmd_migrate,  &help_migrate },
   { "DISPLAY",  1, okrc, cmd_display,  &help_display },
   { "ALTER",    2, okrc, cmd_alter,    &help_alter },
   { "VERSION",  3, okrc, cmd_version,  &help_version },
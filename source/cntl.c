@@ -34,6 +34,8 @@
 
 #include "cntl.h"
 
+#include "snap.h"
+
 
 #if 0
 #undef logall
@@ -169,6 +171,17 @@ static void vcp_init(cpu_t *cpu, int type, int ext, int func, int ctrl, cp_t **v
   pthread_create(&(*vcp)->pthread.tid, &(*vcp)->pthread.attr, cp_thread, cpu);
 }
 
+static void vcp_snap(cp_t *vcp, snap_t *s)
+{
+  SNAP(s, vcp->iv);
+  SNAP(s, vcp->ir);
+  SNAP(s, vcp->mi);
+  SNAP(s, vcp->cr);
+  SNAP(s, vcp->li);
+  SNAP(s, vcp->im);
+  SNAP(s, vcp->intr);
+}
+
 int cntl_io(cpu_t *cpu, int type, int ext, int func, int ctrl, void **devparm, int argc, char *argv[])
 {
 cp_t *vcp = *devparm;
@@ -299,6 +312,9 @@ cp_t *vcp = *devparm;
         }
       }
       break;
+    case IO_TYPE_SNP:
+      vcp_snap(vcp, (snap_t *)argv);
+      break;
     case IO_TYPE_ASN:
       if(argc > 0)
       {
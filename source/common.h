@@ -76,6 +76,7 @@
 #include <limits.h>
 #include <spawn.h>
 #include <pthread.h>
+#include <stdatomic.h>
 #if defined(__APPLE__) || defined(__OSX__)
  #define pthread_yield() sched_yield()
  #define pthread_setname_np(_t, _n) pthread_setname_np(_n)
@@ -86,9 +87,11 @@
  #define posix_spawnattr_setschedparam(_a, _p) ((_p)->sched_priority)
 #endif
 #include <dirent.h>
+#include <dlfcn.h>
 #include <math.h>
 
 #include <sys/socket.h>
+#include <sys/un.h>
 #include <arpa/inet.h>
 #include <netdb.h>
 
@@ -40,6 +40,8 @@
 
 #include "prcex.h"
 
+#include "fuse.h"
+
 
 #ifdef HMDE
 
@@ -98,13 +100,35 @@ __sync_synchronize();
       longjmp(cpu->smode, smode_halt);
     E50X(vstore_wx)(cpu, irc, cpu->p, acc_wr);
     S_RB(cpu, intraseg_i(irc, 1));
+
+    ENDOP(cpu, endop_inhibit); // FIXME TODO CHECK
   }
+}
 
-  longjmp(cpu->endop, endop_inhibit); // FIXME TODO CHECK
+
+/* Poll for interrupts, the number of instructions until the next
+ * poll doubles while nothing is pending, io_setintv raising
+ * intr.attn ends the current burst early.  An interrupt pending while
+ * they are inhibited keeps the short burst, IRTN and IRTC enable them
+ * without ending the burst.
+ */
+static inline void E50X(run_cpu_poll)(cpu_t *cpu)
+{
+  atomic_store_explicit(&cpu->intr.attn, 0, memory_order_relaxed);
+
+  if(io_pending(cpu))
+  {
+    cpu->intr.burst = INTR_BURST_MIN;
+    if(cpu->crs->km.ie)
+      E50X(run_cpu_intrchk)(cpu);
+  }
+  else
+    if(cpu->intr.burst < INTR_BURST_MAX)
+      cpu->intr.burst <<= 1;
 }
 
 
-static inline void __attribute__ ((noreturn)) E50X(run_cpu_check)(cpu_t *cpu)
+static inline void ENDOP_NORETURN E50X(run_cpu_check)(cpu_t *cpu)
 {
 ATOFF(cpu);
 
@@ -127,12 +151,12 @@ ATOFF(cpu);
 logall("-> %s fault offset %2.2x vector %2.2x/%2.2x pc %8.8x keys %4.4x fcodeh %4.4x faddr %8.8x pb %8.8x\n",
   fault_name(cpu->fault.vecoff), cpu->fault.offset, cpu->fault.vector,cpu->fault.vecoff, cpu->fault.pc, cpu->fault.km.keys, cpu->fault.fcode, cpu->fault.faddr, cpu->pb);
 
-    longjmp(cpu->endop, endop_inhibit); // FIXME TODO CHECK
+    ENDOP(cpu, endop_inhibit); // FIXME TODO CHECK
   }
 }
 
 
-static inline void __attribute__ ((noreturn)) E50X(run_cpu_fault)(cpu_t *cpu)
+static inline void ENDOP_NORETURN E50X(run_cpu_fault)(cpu_t *cpu)
 {
 ATOFF(cpu);
 
@@ -155,22 +179,206 @@ ATOFF(cpu);
 logall("-> %s fault offset %2.2x vector %2.2x/%2.2x pc %8.8x keys %4.4x fcodeh %4.4x faddr %8.8x pb %8.8x\n",
   fault_name(cpu->fault.vecoff), cpu->fault.offset, cpu->fault.vector,cpu->fault.vecoff, cpu->fault.pc, cpu->fault.km.keys, cpu->fault.fcode, cpu->fault.faddr, cpu->pb);
 
-    longjmp(cpu->endop, endop_inhibit); // FIXME TODO CHECK
+    ENDOP(cpu, endop_inhibit); // FIXME TODO CHECK
+  }
+}
+
+
+static inline void E50X(ic_bind)(cpu_t *cpu, uint32_t addr)
+{
+  uint8_t *h = E50X(v2h)(cpu, addr, acc_ex);
+  uint32_t r = h2r(cpu, h);
+  uint8_t *m = h - (ea_off(r) << 1);
+  uint32_t t = ICACHE_TAG(r, km_cmde);
+  int x = ICACHE_INDEX(r);
+
+  if(cpu->icache.t[x] != t)
+  {
+    memset(cpu->icache.e[x], 0, sizeof(*cpu->icache.e));
+    __atomic_store_n(&cpu->icache.t[x], t, __ATOMIC_RELAXED);
+  }
+
+  cpu->icache.vp = cpu->pb & em50_page_mask;
+  cpu->icache.h = cpu->icache.e[x];
+  cpu->icache.m = m;
+  cpu->icache.x = x;
+}
+
+
+/* Leaving the bound page follows a link of its slot when the page
+ * entered was entered from there before, without translating the
+ * address again. Links are made under the current translation, any
+ * ic_unbind (TLB purge, process exchange, mode switch) drops them all.
+ * Stores into code clear the handler slots, and a slot reused for
+ * another page fails the tag check.
+ */
+static inline void E50X(ic_link)(cpu_t *cpu, uint32_t addr)
+{
+uint32_t vp = cpu->pb & em50_page_mask;
+
+  if(cpu->icache.vp == ICACHE_NONE)
+  {
+    E50X(ic_bind)(cpu, addr);
+    return;
+  }
+
+  typeof(cpu->icache.l[0][0]) *l = cpu->icache.l[cpu->icache.x];
+
+  for(int n = 0; n < ICACHE_LINKS; ++n)
+    if(l[n].vp == vp && l[n].gen == cpu->icache.gen && cpu->icache.t[l[n].x] == l[n].t)
+    {
+      cpu->icache.vp = vp;
+      cpu->icache.h = cpu->icache.e[l[n].x];
+      cpu->icache.m = l[n].m;
+      cpu->icache.x = l[n].x;
+      return;
+    }
+
+  E50X(ic_bind)(cpu, addr);
+
+  memmove(l + 1, l, (ICACHE_LINKS - 1) * sizeof(*l));
+  l->vp = vp;
+  l->t = cpu->icache.t[cpu->icache.x];
+  l->x = cpu->icache.x;
+  l->m = cpu->icache.m;
+  l->gen = cpu->icache.gen;
+}
+
+
+/* The word is read again after seq, so that the handler is that of
+ * the word executed, and the handler is dropped if a store by another
+ * thread may have cleared the slot before it was installed
+ */
+static inline inst_t E50X(ic_fill)(cpu_t *cpu, uint32_t o)
+{
+  unsigned s = atomic_load_explicit(&cpu->icache.seq, memory_order_acquire);
+
+  cpu->inst = *(uint16_t *)(cpu->icache.m + (o << 1));
+  inst_t h = E50X(fuse_bind)(cpu, E50X(dispatch)[(cpu->op[0] << 8) | cpu->op[1]]);
+
+  __atomic_store_n(&cpu->icache.h[o], h, __ATOMIC_RELAXED);
+  atomic_thread_fence(memory_order_seq_cst);
+  if(atomic_load_explicit(&cpu->icache.seq, memory_order_relaxed) != s)
+    __atomic_store_n(&cpu->icache.h[o], NULL, __ATOMIC_RELAXED);
+
+  return h;
+}
+
+
+static inline inst_t E50X(ic_fetch)(cpu_t *cpu)
+{
+#if defined V_MODE || defined I_MODE
+uint32_t a = cpu->pb;
+#else
+uint32_t a = cpu->p;
+#endif
+
+  if(ISAT(cpu, a))
+  {
+    cpu->inst = E50X(vfetch_i)(cpu);
+    return E50X(dispatch)[(cpu->op[0] << 8) | cpu->op[1]];
   }
+
+  ++cpu->c;
+  cpu->po = cpu->pb;
+
+  if((cpu->pb & em50_page_mask) != cpu->icache.vp)
+    E50X(ic_link)(cpu, a);
+
+  uint32_t o = ea_off(cpu->pb);
+  cpu->inst = *(uint16_t *)(cpu->icache.m + (o << 1));
+  cpu->p++;
+
+  inst_t h = cpu->icache.h[o];
+  if(!h)
+    h = E50X(ic_fill)(cpu, o);
+
+  return h;
 }
 
 
 static inline void E50X(exec_inst)(cpu_t *cpu)
 {
   cpu->exec = 0;
-  cpu->inst = E50X(vfetch_i)(cpu);
-  E50X(decode)(cpu, cpu->op);
+  E50X(ic_fetch)(cpu)(cpu, cpu->op);
+  logopr(cpu);
+}
+
+
+static inline void E50X(exec_pairs)(cpu_t *cpu)
+{
+  cpu->exec = 0;
+  inst_t h = E50X(ic_fetch)(cpu);
+  pairs_count(cpu->pairs, h, (cpu->op[0] << 8) | cpu->op[1]);
+  h(cpu, cpu->op);
   logopr(cpu);
 }
 
 
+/* Instruction pair profiling is selected per burst
+ */
+static inline void E50X(exec_burst)(cpu_t *cpu, int n)
+{
+  if(cpu->pairs)
+    for(; n && !atomic_load_explicit(&cpu->intr.attn, memory_order_acquire)
+#if defined(ENDOP_RETURN)
+      && cpu->eop == endop_run
+#endif
+      ; --n)
+      E50X(exec_pairs)(cpu);
+  else
+    for(; n && !atomic_load_explicit(&cpu->intr.attn, memory_order_acquire)
+#if defined(ENDOP_RETURN)
+      && cpu->eop == endop_run
+#endif
+      ; --n)
+      E50X(exec_inst)(cpu);
+}
+
+
+#if defined(ENDOP_RETURN)
 void E50X(run_cpu)(cpu_t *cpu)
 {
+  ic_unbind(cpu);
+  endop_t code = setjmp(cpu->endop);
+  cpu->exec = 0;
+  do {
+    if(!cpu_started(cpu))
+      code = E50X(run_cpu_status)(cpu, code);
+    if(cpu->idle)
+    {
+      code = pxm_idle_wait(cpu);
+      continue;
+    }
+    cpu->eop = endop_run;
+    switch(code)
+    {
+    case endop_check:
+      E50X(run_cpu_check)(cpu);
+      break;
+    case endop_fault:
+      E50X(run_cpu_fault)(cpu);
+      break;
+    case endop_nointr1:
+    case endop_setjmp:
+    case endop_run:
+      E50X(exec_inst)(cpu);
+      if(cpu->eop != endop_run)
+        break;
+    case endop_intrchk:
+      E50X(run_cpu_poll)(cpu);
+      if(cpu->eop != endop_run)
+        break;
+    case endop_inhibit:
+      E50X(exec_burst)(cpu, cpu->intr.burst);
+    }
+    code = cpu->eop;
+  } while(1);
+}
+#else
+void E50X(run_cpu)(cpu_t *cpu)
+{
+  ic_unbind(cpu);
   do {
     endop_t code = setjmp(cpu->endop);
     cpu->exec = 0;
@@ -178,6 +386,11 @@ void E50X(run_cpu)(cpu_t *cpu)
     do {
       if(!cpu_started(cpu))
         code = E50X(run_cpu_status)(cpu, code);
+      if(cpu->idle)
+      {
+        code = pxm_idle_wait(cpu);
+        continue;
+      }
       switch(code)
       {
       case endop_check:
@@ -190,21 +403,17 @@ void E50X(run_cpu)(cpu_t *cpu)
       case endop_run:
         E50X(exec_inst)(cpu);
       case endop_intrchk:
-        if(cpu->crs->km.ie)
-        {
-//        if(cpu->crs->km.pxm && (!((dly++) & 0xff)))
-//          E50X(timer_get)(cpu);
-          if(io_pending(cpu))
-            E50X(run_cpu_intrchk)(cpu);
-        }
+//      if(cpu->crs->km.pxm && (!((dly++) & 0xff)))
+//        E50X(timer_get)(cpu);
+        E50X(run_cpu_poll)(cpu);
       case endop_inhibit:
-        for(int n = 0; n < 32; ++n)
-          E50X(exec_inst)(cpu);
+        E50X(exec_burst)(cpu, cpu->intr.burst);
       }
       code = endop_run;
     } while(1);
   } while(1);
 }
+#endif
 
 
 #ifndef EMDE
@@ -40,12 +40,32 @@ extern void e32r_run_cpu(cpu_t *);
 extern void e32i_run_cpu(cpu_t *);
 extern void e64v_run_cpu(cpu_t *);
 
+extern void e16s_decode_init(void);
+extern void e32s_decode_init(void);
+extern void e64r_decode_init(void);
+extern void e32r_decode_init(void);
+extern void e32i_decode_init(void);
+extern void e64v_decode_init(void);
+
+
+static inline void decode_init(void)
+{
+  e16s_decode_init();
+  e32s_decode_init();
+  e64r_decode_init();
+  e32r_decode_init();
+  e32i_decode_init();
+  e64v_decode_init();
+}
+
 
 static inline void cpu_reset(cpu_t *cpu)
 {
   memset(&(cpu->srf), 0, sizeof(cpu->srf));
+  cpu->cc.m = 0;
   mm_ptlb(cpu);
   mm_piotlb(cpu);
+  cpu->idle = 0;
   cpu->crn = 0;
   cpu->crs = &cpu->srf.urs[0];
   cpu->crs->timer = 0;
@@ -52,6 +52,94 @@ typedef __int128_t intdec_t;
 typedef __int64_t intdec_t;
 #endif
 
+/* Operands of up to this many digits are converted in 64 bits,
+   128 bit division and modulo are library calls */
+#define DEC_DIGITS64 18
+
+static const uint64_t dec_pow10[DEC_DIGITS64 + 1] = {
+  1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+  10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL,
+  100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+  100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+  100000000000000000ULL, 1000000000000000000ULL };
+
+static inline intdec_t dec_pow(int n)
+{
+  return n <= DEC_DIGITS64 ? (intdec_t)dec_pow10[n] : (intdec_t)pow(10, n);
+}
+
+static inline int dec_s64(intdec_t v)
+{
+  return v >= -INT64_MAX && v <= INT64_MAX;
+}
+
+static inline int dec_u64(intdec_t v)
+{
+#if defined(__SIZEOF_INT128__)
+  return v >= 0 && v <= (intdec_t)UINT64_MAX;
+#else
+  return v >= 0;
+#endif
+}
+
+static inline intdec_t dec_div(intdec_t a, intdec_t b)
+{
+  if(dec_s64(a) && dec_s64(b))
+    return (int64_t)a / (int64_t)b;
+
+  return a / b;
+}
+
+static inline intdec_t dec_rem(intdec_t a, intdec_t b)
+{
+  if(dec_s64(a) && dec_s64(b))
+    return (int64_t)a % (int64_t)b;
+
+  return a % b;
+}
+
+/* Value of the low nibbles of n characters */
+static inline intdec_t dec_load_digits(const uint8_t *b, int n)
+{
+  if(n <= DEC_DIGITS64)
+  {
+  uint64_t r = 0;
+
+    for(int i = 0; i < n; ++i)
+      r = r * 10 + (b[i] & 0xf);
+
+    return r;
+  }
+
+  intdec_t r = 0;
+
+  for(int i = 0; i < n; ++i)
+    r = r * 10 + (b[i] & 0xf);
+
+  return r;
+}
+
+/* Low n digits of v (v >= 0) as characters in zone z */
+static inline void dec_store_digits(uint8_t *b, int n, intdec_t v, uint8_t z)
+{
+  if(dec_u64(v))
+  {
+  uint64_t r = v;
+
+    for(int i = n - 1; i >= 0; --i)
+    {
+      b[i] = z | (r % 10);
+      r /= 10;
+    }
+  }
+  else
+    for(int i = n - 1; i >= 0; --i)
+    {
+      b[i] = z | (v % 10);
+      v /= 10;
+    }
+}
+
 #define dcw_dt_ls 0   /* Leading Separate */
 #define dcw_dt_ts 1   /* Trailing Separate */
 #define dcw_dt_pd 3   /* Packed Decimal */
@@ -133,7 +221,7 @@ static inline intdec_t dcw_scale(dcw_t dcw, int xmv, intdec_t value)
 //printf("scale %d, value %jd\n", scale, (intmax_t)value);
   if(scale < 0)
   {
-    intdec_t mult = pow(10, -scale);
+    intdec_t mult = dec_pow(-scale);
     value *= mult;
   }
   else if(scale > 0)
@@ -143,12 +231,12 @@ static inline intdec_t dcw_scale(dcw_t dcw, int xmv, intdec_t value)
 //if(lz) printf("lz %d v %jd\n", lz, (intmax_t)value);
 //    if(!xmv && lz < scale)
 //      scale += lz;
-    intdec_t div = pow(10, scale < 40 ? scale : 39);
+    intdec_t div = dec_pow(scale < 40 ? scale : 39);
     if(!div) { div = 1; value = 0;}
 // THIS IS WRONG FOR XCM, WHICH SHOULD IGNORE DCW.D
     intdec_t rnd = (!xmv || (xmv && dcw.d)) ? div / 2 : 0;
 //  intdec_t rnd = (xmv && dcw.d) ? div / 2 : 0;
-    value = (value + (value > 0 ? rnd : -rnd)) / div;
+    value = dec_div(value + (value > 0 ? rnd : -rnd), div);
 //printf("value %jd\n", (intmax_t)value);
   }
 
@@ -165,6 +253,18 @@ static inline void E50X(store_bytes)(cpu_t *cpu, uint8_t *bytes, int count, uint
   if(count == 0)
     return;
 
+  /* Within a page translate once and copy to host storage */
+  int b = *fbr ? 1 : 0;
+  if(!ISAT(cpu, *far) && !page_cross_x(*far, (b + count - 1) >> 1))
+  {
+    uint8_t *h = E50X(v2h)(cpu, WXX(*far), acc_wr);
+    memcpy(h + b, bytes, count);
+    ic_store(cpu, h2r(cpu, h), (b + count + 1) >> 1);
+    *far = intraseg_i(*far, (b + count) >> 1);
+    *fbr = ((b + count) & 1) ? 8 : 0;
+    return;
+  }
+
   if(*fbr != 0)
   {
   uint16_t w = (E50X(vfetch_w)(cpu, *far) & 0xff00) | *bytes++;
@@ -203,13 +303,7 @@ uint8_t ls[digits + 1];
   if(value < 0)
     value = -value;
 
-  for(int n = digits; n > 0; --n)
-  {
-    ls[n] = '0' + (value % 10);
-    value /= 10;
-    if(!cpu->crs->km.ascii)
-      ls[n] |= 0x80;
-  }
+  dec_store_digits(ls + 1, digits, value, cpu->crs->km.ascii ? '0' : '0' | 0x80);
 
   E50X(store_bytes)(cpu, ls, digits + 1, far, fbr);
 }
@@ -225,13 +319,7 @@ uint8_t ls[digits + 1];
   if(neg)
     value = -value;
 
-  for(int n = digits - 1; n >= 0; --n)
-  {
-    ls[n] = '0' + (value % 10);
-    value /= 10;
-    if(!cpu->crs->km.ascii)
-      ls[n] |= 0x80;
-  }
+  dec_store_digits(ls, digits, value, cpu->crs->km.ascii ? '0' : '0' | 0x80);
 
   ls[digits] = neg ? '-' : '+';
 
@@ -256,14 +344,35 @@ static inline void E50X(store_pd)(cpu_t *cpu, int digits, intdec_t value, uint32
   if(value < 0)
     value = -value;
 
-  value *= 10;
+  /* The last digit shares its byte with the sign, the value is not
+     scaled by 10 first as that overflows for fields of 38 digits */
+  if(dec_u64(value))
+  {
+  uint64_t v = value;
+
+    pd[bytes - 1] = (v % 10) << 4;
+    v /= 10;
+
+    for(int n = bytes - 2; n >= 0; --n)
+    {
+    int d = v % 100;
+      v /= 100;
 
-  for(int n = bytes - 1; n >= 0; --n)
+      pd[n] = (d / 10) << 4 | d % 10;
+    }
+  }
+  else
   {
-  int d = value % 100;
-    value /= 100;
+    pd[bytes - 1] = (value % 10) << 4;
+    value /= 10;
+
+    for(int n = bytes - 2; n >= 0; --n)
+    {
+    int d = value % 100;
+      value /= 100;
 
-    pd[n] = (d / 10) << 4 | d % 10;
+      pd[n] = (d / 10) << 4 | d % 10;
+    }
   }
 
   pd[bytes - 1] |= neg ? 0x0d : 0x0c;
@@ -282,13 +391,7 @@ uint8_t ls[digits];
   if(neg)
     value = -value;
 
-  for(int n = digits - 1; n >= 0; --n)
-  {
-    ls[n] = '0' + (value % 10);
-    value /= 10;
-    if(!cpu->crs->km.ascii)
-      ls[n] |= 0x80;
-  }
+  dec_store_digits(ls, digits, value, cpu->crs->km.ascii ? '0' : '0' | 0x80);
 
   if(neg)
   {
@@ -314,13 +417,7 @@ uint8_t ls[digits];
   if(neg)
     value = -value;
 
-  for(int n = digits - 1; n >= 0; --n)
-  {
-    ls[n] = '0' + (value % 10);
-    value /= 10;
-    if(!cpu->crs->km.ascii)
-      ls[n] |= 0x80;
-  }
+  dec_store_digits(ls, digits, value, cpu->crs->km.ascii ? '0' : '0' | 0x80);
 
   if(neg)
   {
@@ -340,6 +437,15 @@ static inline void E50X(load_bytes)(cpu_t *cpu, uint8_t *bytes, int count, uint3
   if(count == 0)
     return;
 
+  int b = *fbr ? 1 : 0;
+  if(!ISAT(cpu, *far) && !page_cross_x(*far, (b + count - 1) >> 1))
+  {
+    memcpy(bytes, E50X(v2h)(cpu, WXX(*far), acc_rd) + b, count);
+    *far = intraseg_i(*far, (b + count) >> 1);
+    *fbr = ((b + count) & 1) ? 8 : 0;
+    return;
+  }
+
   if(*fbr != 0)
   {
     *bytes++ = E50X(vfetch_w)(cpu, (*far)) & 0xff;
@@ -369,11 +475,7 @@ intdec_t r = 0;
 uint8_t ls[digits + 1];
 
   E50X(load_bytes)(cpu, ls, digits + 1, far, fbr);
-  for(int n = 1; n <= digits; n++)
-  {
-    r *= 10;
-    r += ls[n] & 0xf;
-  }
+  r = dec_load_digits(ls + 1, digits);
   // space = 0x20, + = 0x2b, { = 0x7b 1011
   //               - = 0x2d, } = 0x7d 1101
   if((ls[0] & 0b100))
@@ -390,11 +492,7 @@ intdec_t r = 0;
 uint8_t ts[digits + 1];
 
   E50X(load_bytes)(cpu, ts, digits + 1, far, fbr);
-  for(int n = 0; n < digits; n++)
-  {
-    r *= 10;
-    r += ts[n] & 0xf;
-  }
+  r = dec_load_digits(ts, digits);
   // space = 0x20, + = 0x2b, { = 0x7b 1011
   //               - = 0x2d, } = 0x7d 1101
   if((ts[digits] & 0b100))
@@ -421,12 +519,22 @@ static inline intdec_t E50X(load_pd)(cpu_t *cpu, int digits, uint32_t *far, int
   intdec_t value = 0;
 
   int n;
-  for(n = 0; n < bytes - 1; ++n)
+  if(digits <= DEC_DIGITS64 + 1)
   {
-    value *= 100;
+  uint64_t v = 0;
+
+    for(n = 0; n < bytes - 1; ++n)
+      v = v * 100 + ((pd[n] & 0xf0) >> 4) * 10 + (pd[n] & 0x0f);
 
-    value += ((pd[n] & 0xf0) >> 4) * 10 + (pd[n] & 0x0f);
+    value = v;
   }
+  else
+    for(n = 0; n < bytes - 1; ++n)
+    {
+      value *= 100;
+
+      value += ((pd[n] & 0xf0) >> 4) * 10 + (pd[n] & 0x0f);
+    }
   value *= 10;
   value += (pd[n] & 0xf0) >> 4;
   if((pd[n] & 0x0f) == 0x0d)
@@ -447,11 +555,14 @@ uint8_t le[digits];
   uint8_t t = le[0] & 0x7f;
   int neg = t == '}' || t == '-' || (t >= 'J' && t <= 'R');
   r = ((t >= 'J' && t <= 'R') ? t - 'I' : (t == '}' || t == '-' || t == '{' || t == '+') ? 0 : t) & 0xf;
-  for(int n = 1; n < digits; n++)
-  {
-    r *= 10;
-    r += le[n] & 0xf;
-  }
+  if(digits <= DEC_DIGITS64)
+    r = r * dec_pow10[digits - 1] + dec_load_digits(le + 1, digits - 1);
+  else
+    for(int n = 1; n < digits; n++)
+    {
+      r *= 10;
+      r += le[n] & 0xf;
+    }
   // space = 0x20, + = 0x2b, { = 0x7b 1011
   //               - = 0x2d, } = 0x7d 1101
   if(neg)
@@ -469,11 +580,7 @@ uint8_t te[digits];
 
   E50X(load_bytes)(cpu, te, digits, far, fbr);
 
-  for(int n = 0; n < digits - 1; n++)
-  {
-    r += te[n] & 0xf;
-    r *= 10;
-  }
+  r = dec_load_digits(te, digits - 1) * 10;
   // space = 0x20, + = 0x2b, { = 0x7b 1011
   //               - = 0x2d, } = 0x7d 1101
 
@@ -1081,7 +1188,7 @@ int flr1 = G_FLR(cpu, 1);
   }
   
 
-  intdec_t quotient = value / div;
+  intdec_t quotient = dec_div(value, div);
 
   cw.f = ql;
   E50X(store_decimal)(cpu, cw, 1, quotient, &far1, &fbr1);
@@ -1094,7 +1201,7 @@ int flr1 = G_FLR(cpu, 1);
 //S_FBR(cpu, 1, fbr1);
 #endif
 
-  intdec_t remainder = value % div;
+  intdec_t remainder = dec_rem(value, div);
 
   if(rl)
   {
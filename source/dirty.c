@@ -0,0 +1,184 @@
+/* Dirty Page Tracking
+ *
+ *
+ * Copyright Notice:
+ *
+ *   Copyright (C) 1999-2020 Jan Jaeger, All Rights Reserved.
+ *
+ *
+ * This file is part of the Prime 50 Series Emulator (em50).
+ *
+ *
+ * License Statement:
+ *
+ *   The Prime 50 Series Emulator (em50) is free software:
+ *   You can redistribute it and/or modify it under the terms
+ *   of the GNU General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License,
+ *   or (at your option) any later version.
+ *
+ *   em50 is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *   See the GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with em50.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "emu.h"
+
+#include "dirty.h"
+
+
+void dirty_init(sys_t *sys)
+{
+  if(!(sys->dirty = calloc(dirty_pages(sys), 1)))
+  {
+    fprintf(stderr, "calloc(dirty) failed rc=%d: %s\n", errno, strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+}
+
+
+#if defined(__linux__)
+static int dirty_clear_refs(void)
+{
+int fd = open("/proc/self/clear_refs", O_WRONLY | O_CLOEXEC);
+
+  if(fd < 0)
+    return -1;
+
+  int rc = (write(fd, "4", 1) == 1) ? 0 : -1;
+  close(fd);
+
+  return rc;
+}
+
+
+/* Mark the pages whose host pages have the soft-dirty bit (55) set
+ * in /proc/self/pagemap, returns the number of host pages found
+ */
+static ssize_t dirty_pagemap(sys_t *sys, uint8_t *addr, size_t size)
+{
+long hps = sysconf(_SC_PAGESIZE);
+int fd = open("/proc/self/pagemap", O_RDONLY | O_CLOEXEC);
+uint64_t e[512];
+ssize_t found = 0;
+
+  if(fd < 0)
+    return -1;
+
+  off_t off = ((uintptr_t)addr / hps) * sizeof(*e);
+  size_t n = size / hps;
+
+  for(size_t p = 0; p < n; )
+  {
+    ssize_t rd = pread(fd, e, ((n - p) < 512 ? (n - p) : 512) * sizeof(*e), off + p * sizeof(*e));
+    if(rd <= 0)
+    {
+      found = -1;
+      break;
+    }
+
+    for(size_t k = 0; k < rd / sizeof(*e); ++k, ++p)
+      if((e[k] >> 55) & 1)
+      {
+        ++found;
+        if(sys)
+          for(size_t o = 0; o < hps && p * hps + o < sys->physsize; o += em50_pgoc_size)
+            sys->dirty[(p * hps + o) / em50_pgoc_size] = 1;
+      }
+  }
+
+  close(fd);
+
+  return found;
+}
+#endif
+
+
+/* Move the marks to map, when not NULL, and take write permission
+ * away from all TLB entries, so that the next store to each page
+ * records it again.  Each mark is exchanged on its own, a page that
+ * a device marks meanwhile is either taken now or left for the next
+ * interval.
+ */
+void dirty_take(sys_t *sys, uint8_t *map)
+{
+  for(size_t p = 0; p < dirty_pages(sys); ++p)
+  {
+    uint8_t d = __atomic_exchange_n(&sys->dirty[p], 0, __ATOMIC_ACQ_REL);
+    if(map)
+      map[p] = d;
+  }
+
+  for(int c = 0; c < sys->ncpu; ++c)
+  {
+  cpu_t *cpu = sys->cpu[c];
+
+    for(size_t n = 0; n < (cpu->tlb.mask + 1) * TLB_WAYS; ++n)
+      cpu->tlb.t[n].e &= ~TLB_W;
+  }
+
+#if defined(__linux__)
+  if(sys->softdirty)
+    dirty_clear_refs();
+#endif
+}
+
+
+/* Number of pages written since the last reset, with host
+ * soft-dirty tracking those pages are merged into the map first
+ */
+size_t dirty_sync(sys_t *sys)
+{
+size_t n = 0;
+
+#if defined(__linux__)
+  if(sys->softdirty)
+    dirty_pagemap(sys, sys->physstor, sys->physsize);
+#endif
+
+  for(size_t p = 0; p < dirty_pages(sys); ++p)
+    n += sys->dirty[p];
+
+  return n;
+}
+
+
+/* Host soft-dirty tracking catches every store to storage whatever
+ * path it takes, it needs a kernel with CONFIG_MEM_SOFT_DIRTY,
+ * which is checked by dirtying a probe page
+ */
+int dirty_soft(sys_t *sys, bool on)
+{
+  if(!on)
+  {
+    sys->softdirty = false;
+    return 0;
+  }
+
+#if defined(__linux__)
+  long hps = sysconf(_SC_PAGESIZE);
+  volatile uint8_t *probe = mmap(NULL, hps, PROT_READ|PROT_WRITE, MAP_ANONYMOUS|MAP_PRIVATE, -1, 0);
+
+  if(probe == MAP_FAILED)
+    return -1;
+
+  *probe = 1;
+  int ok = !dirty_clear_refs() && (*probe = 2) && dirty_pagemap(NULL, (uint8_t *)probe, hps) == 1;
+  munmap((void *)probe, hps);
+
+  if(ok)
+  {
+    sys->softdirty = true;
+    return 0;
+  }
+#endif
+
+  errno = ENOTSUP;
+  return -1;
+}
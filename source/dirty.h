@@ -0,0 +1,67 @@
+/* Dirty Page Tracking
+ *
+ *
+ * Copyright Notice:
+ *
+ *   Copyright (C) 1999-2020 Jan Jaeger, All Rights Reserved.
+ *
+ *
+ * This file is part of the Prime 50 Series Emulator (em50).
+ *
+ *
+ * License Statement:
+ *
+ *   The Prime 50 Series Emulator (em50) is free software:
+ *   You can redistribute it and/or modify it under the terms
+ *   of the GNU General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License,
+ *   or (at your option) any later version.
+ *
+ *   em50 is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *   See the GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with em50.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef _dirty_h
+#define _dirty_h
+
+/* sys->dirty has a byte per 2KB page of storage, set when the page
+ * may have been written since the last dirty_reset.  dirty_mark in
+ * emu.h records the stores, dirty_take and dirty_reset must be
+ * called with the CPUs held.
+ */
+void dirty_init(sys_t *);
+void dirty_take(sys_t *, uint8_t *);
+size_t dirty_sync(sys_t *);
+int dirty_soft(sys_t *, bool);
+
+static inline size_t dirty_pages(sys_t *sys)
+{
+  return sys->physsize / em50_pgoc_size;
+}
+
+static inline bool dirty_test(sys_t *sys, size_t page)
+{
+  return __atomic_load_n(&sys->dirty[page], __ATOMIC_RELAXED);
+}
+
+static inline void dirty_reset(sys_t *sys)
+{
+  dirty_take(sys, NULL);
+}
+
+// Put back marks taken by dirty_take
+static inline void dirty_merge(sys_t *sys, const uint8_t *map)
+{
+  for(size_t p = 0; p < dirty_pages(sys); ++p)
+    if(map[p])
+      __atomic_store_n(&sys->dirty[p], 1, __ATOMIC_RELAXED);
+}
+
+#endif
@@ -36,6 +36,8 @@
 
 #include "disk.h"
 
+#include "snap.h"
+
 
 #if 0
 #undef logall
@@ -73,6 +75,13 @@ cpu_t *cpu = dk->cpu;
       pthread_mutex_lock(&dk->pthread.mutex);
     }
 
+    while(dk->hold)
+    {
+      pthread_mutex_unlock(&dk->pthread.mutex);
+      usleep(1000);
+      pthread_mutex_lock(&dk->pthread.mutex);
+    }
+
     dm_t *dm = (dk->mhd >= 0) ? &dk->dm[dk->mhd] : NULL;
 
     uint32_t order = ifetch_d(cpu, dk->oar);
@@ -325,13 +334,120 @@ dk_t *dk = parm;
   {
     pthread_cond_wait(&dk->pthread.cond, &dk->pthread.mutex);
     dk->busy = 0;
+    dk->run = 1;
     ex_chp(dk);
+    dk->run = 0;
   }
   pthread_mutex_unlock(&dk->pthread.mutex);
   return NULL;
 }
 
 
+/* Checkpoints carry disk records, a base or a clone snapshot those
+ * held in the overlay and a delta those written since the previous
+ * checkpoint.  On restore the records go to the overlay, on top of
+ * disk files that are as they were at the base.
+ */
+static void dk_snaprec(dm_t *dm, snap_t *s)
+{
+int32_t r = -1;
+uint32_t start = dm->start, len = dm->size << 1;
+uint8_t *buf;
+
+  if(s->wr)
+  {
+  uint8_t *m = (s->type == SNAP_DELTA) ? dm->cm : dm->om;
+  size_t n = (s->type == SNAP_DELTA) ? dm->cn : dm->on;
+
+    if(s->type != SNAP_SAVE && len && (buf = malloc(len)))
+    {
+      for(r = 0; r < (n << 3); ++r)
+        if(dk_maptst(m, n, r))
+        {
+        int fd = dk_ovfd(dm, start + (off_t)r * len);
+
+          if(fd < 0 || pread(fd, buf, len, start + (off_t)r * len) != len)
+            memset(buf, 0, len);
+          SNAP(s, r);
+          SNAP(s, start);
+          SNAP(s, len);
+          snap_io(s, buf, len);
+        }
+      free(buf);
+      if(dm->cm && s->type != SNAP_CLONE)
+        memset(dm->cm, 0, dm->cn);
+    }
+    r = -1;
+    SNAP(s, r);
+    return;
+  }
+
+  if(s->type == SNAP_BASE || s->type == SNAP_CLONE)
+    dk_ovclose(dm);
+
+  for(SNAP(s, r); !s->err && r >= 0; SNAP(s, r))
+  {
+    SNAP(s, start);
+    SNAP(s, len);
+    if(s->err || !(buf = malloc(len)))
+      break;
+    snap_io(s, buf, len);
+    if(!s->err && dk_ovopen(dm) >= 0 && pwrite(dm->ov, buf, len, start + (off_t)r * len) == len)
+      dk_mapset(&dm->om, &dm->on, r);
+    free(buf);
+  }
+}
+
+
+/* An active channel program is restarted from the saved order
+ * address, drives that were open are opened again
+ */
+static void dk_snap(dk_t *dk, snap_t *s)
+{
+  pthread_mutex_lock(&dk->pthread.mutex);
+
+  int run = dk->run;
+  SNAP(s, run);
+  SNAP(s, dk->busy);
+  SNAP(s, dk->oar);
+  SNAP(s, dk->stat);
+  SNAP(s, dk->cn);
+  SNAP(s, dk->ca);
+  SNAP(s, dk->mhd);
+  SNAP(s, dk->intr);
+  SNAP(s, dk->bp);
+  SNAP(s, dk->bf);
+
+  for(int mhd = 0; mhd < DK_UNITS; ++mhd)
+  {
+  dm_t *dm = &dk->dm[mhd];
+  int open = dm->fd >= 0;
+
+    snap_str(s, &dm->fn);
+    SNAP(s, open);
+    SNAP(s, dm->formatting);
+    SNAP(s, dm->seeking);
+    SNAP(s, dm->seek);
+    dk_snaprec(dm, s);
+
+    if(!s->wr && !s->err)
+    {
+      dk_close(dm);
+      if(open)
+        dk_open(dm);
+    }
+  }
+
+  if(!s->wr && !s->err && (run || dk->busy))
+  {
+    dk->busy = 1;
+    pthread_cond_signal(&dk->pthread.cond);
+  }
+
+  pthread_mutex_unlock(&dk->pthread.mutex);
+}
+
+
 static void dk_init(cpu_t *cpu, int type, int ext, int func, int ctrl, dk_t **dk, int argc, char *argv[])
 {
   (*dk) = calloc(1, sizeof(dk_t));
@@ -345,6 +461,7 @@ static void dk_init(cpu_t *cpu, int type, int ext, int func, int ctrl, dk_t **dk
 
     (*dk)->dm[mhd].fn = strdup(c_fname(genname));
     (*dk)->dm[mhd].fd = -1;
+    (*dk)->dm[mhd].ov = -1;
     (*dk)->dm[mhd].dk = (*dk);
   }
 
@@ -451,6 +568,8 @@ dk_t *dk = *devparm;
       if(dk_read(&dk->dm[ext], physad(cpu, DK_ADDR_IPL), recsize[0], 0, 0, 0) != DK_STAT_OK)
         logmsg("disk %03o:%d boot failed\n", ctrl, ext);
       cpu->srf.drf.dma_h[040] = DK_ADDR_IPL + recsize[0];
+      ic_purge(cpu);
+      dirty_range(cpu, DK_ADDR_IPL, recsize[0]);
       pthread_mutex_unlock(&dk->pthread.mutex);
       break;
     case IO_TYPE_INI:
@@ -458,6 +577,24 @@ dk_t *dk = *devparm;
       break;
     case IO_TYPE_CLS:
       break;
+    case IO_TYPE_SNP:
+      dk_snap(dk, (snap_t *)argv);
+      break;
+    case IO_TYPE_HLD:
+      pthread_mutex_lock(&dk->pthread.mutex);
+      dk->hold = argc;
+      pthread_mutex_unlock(&dk->pthread.mutex);
+      break;
+    case IO_TYPE_OVL:
+      pthread_mutex_lock(&dk->pthread.mutex);
+      for(int mhd = 0; mhd < DK_UNITS; ++mhd)
+        if(dk->dm[mhd].fd >= 0)
+        {
+          dk_close(&dk->dm[mhd]);
+          dk_open(&dk->dm[mhd]);
+        }
+      pthread_mutex_unlock(&dk->pthread.mutex);
+      break;
     case IO_TYPE_ASN:
       if(ext >= DK_UNITS)
         printf("Invalid unit (%o)\n", ext);
@@ -465,6 +602,7 @@ dk_t *dk = *devparm;
       {
         pthread_mutex_lock(&dk->pthread.mutex);
         dk_close(&dk->dm[ext]);
+        dk_ovclose(&dk->dm[ext]);
 
         if(strcmp(argv[0], "*"))
         {
@@ -62,11 +62,19 @@ typedef struct {
   uint32_t records;
   uint32_t size;
   uint32_t seek;
+  int ov;       // Copy-on-write overlay, written records and header
+  bool ovhdr;   // Header is in the overlay
+  uint8_t *om;  // Map of records in the overlay
+  size_t on;
+  uint8_t *cm;  // Map of records written since the last checkpoint
+  size_t cn;
 } dm_t;
 
 typedef struct dk_t {
   cpu_t *cpu;
 int busy;
+  int run;  // Channel program active
+  int hold; // Held between orders by io_hold
   struct {
     pthread_t tid;
     pthread_attr_t attr;
@@ -165,12 +173,74 @@ static const int unit[] = { -1,  0,  1, -1,
     return unit[(mask >> 4) & 0b1111] + 4;
 }
 
+/* With sys->overlay set the disk file is only read, records written
+ * go to a sparse file of the same layout in the overlay directory
+ */
+static inline int dk_ovopen(dm_t *dm)
+{
+char ovname[PATH_MAX];
+
+  if(dm->ov >= 0 || !dm->dk->cpu->sys->overlay)
+    return dm->ov;
+
+  snprintf(ovname, sizeof(ovname), "%s/dk0%o%o", dm->dk->cpu->sys->overlay, dm->dk->ctrl, (int)(dm - dm->dk->dm));
+
+  if((dm->ov = open(ovname, O_CREAT | O_TRUNC | O_RDWR | O_CLOEXEC, S_IRUSR | S_IWUSR)) == -1)
+    perror(ovname);
+
+  return dm->ov;
+}
+
+static inline void dk_mapset(uint8_t **m, size_t *n, size_t r)
+{
+  if((r >> 3) >= *n)
+  {
+  size_t s = (r >> 3) + 4096;
+
+    *m = realloc(*m, s);
+    memset(*m + *n, 0, s - *n);
+    *n = s;
+  }
+
+  (*m)[r >> 3] |= 1 << (r & 7);
+}
+
+static inline bool dk_maptst(uint8_t *m, size_t n, size_t r)
+{
+  return (r >> 3) < n && (m[r >> 3] & (1 << (r & 7)));
+}
+
+static inline void dk_ovclose(dm_t *dm)
+{
+  if(dm->ov >= 0)
+    close(dm->ov);
+  dm->ov = -1;
+  dm->ovhdr = false;
+  free(dm->om);
+  dm->om = NULL;
+  dm->on = 0;
+}
+
+static inline size_t dk_ovrec(dm_t *dm, off_t offset)
+{
+  return (offset - dm->start) / (dm->size << 1);
+}
+
+static inline int dk_ovfd(dm_t *dm, off_t offset)
+{
+  if(dm->ov >= 0 && dk_maptst(dm->om, dm->on, dk_ovrec(dm, offset)))
+    return dm->ov;
+
+  return dm->fd;
+}
+
 static inline int dk_rdhdr(dm_t *dm)
 {
 dskhdr_t hdr;
+int fd = dm->ovhdr ? dm->ov : dm->fd;
 
-  if((lseek(dm->fd, 0, SEEK_SET) != 0)
-    || (read(dm->fd, &hdr, sizeof(dskhdr_t)) != sizeof(dskhdr_t)))
+  if((lseek(fd, 0, SEEK_SET) != 0)
+    || (read(fd, &hdr, sizeof(dskhdr_t)) != sizeof(dskhdr_t)))
   {
     close(dm->fd);
     return (dm->fd = -1);
@@ -211,13 +281,16 @@ dskhdr_t hdr;
   hdr.records = to_be_32(dm->records);
   hdr.size = to_be_32(dm->size);
 
-  if((lseek(dm->fd, 0, SEEK_SET) != 0)
-    || (write(dm->fd, &hdr, sizeof(dskhdr_t)) != sizeof(dskhdr_t)))
+int fd = dm->ov >= 0 ? dm->ov : dm->fd;
+
+  if((lseek(fd, 0, SEEK_SET) != 0)
+    || (write(fd, &hdr, sizeof(dskhdr_t)) != sizeof(dskhdr_t)))
   {
     close(dm->fd);
     dm->fd = -1;
   }
 
+  dm->ovhdr = dm->ov >= 0;
   dm->start = from_be_16(hdr.hdrsz);
 
   return dm->fd;
@@ -272,7 +345,7 @@ static inline int dk_creat(dm_t *dm)
 
 static inline int dk_open(dm_t *dm)
 {
-  if((dm->fd = open(dm->fn, O_RDWR | O_CLOEXEC)) == -1)
+  if((dm->fd = open(dm->fn, (dk_ovopen(dm) >= 0 ? O_RDONLY : O_RDWR) | O_CLOEXEC)) == -1)
     if((dm->fd = dk_creat(dm)) == -1)
       return -1;
 
@@ -339,10 +412,12 @@ off_t offset = dk_off(dm, size, head, track, record);
   if(offset == 0)
     return DK_STAT_SEEKERR;
 
-  if(lseek(dm->fd, offset, SEEK_SET) != offset)
+int fd = dk_ovfd(dm, offset);
+
+  if(lseek(fd, offset, SEEK_SET) != offset)
     return DK_STAT_HDRERR;
 
-  size_t rd = read(dm->fd, buf, (size << 1));
+  size_t rd = read(fd, buf, (size << 1));
 
   if(rd != 0 && rd != (size << 1))
     return DK_STAT_HDRERR;
@@ -366,12 +441,18 @@ off_t offset = dk_off(dm, size, head, track, record);
     dk_fixup(dm);
   }
 
-  if(lseek(dm->fd, offset, SEEK_SET) != offset)
+int fd = dm->ov >= 0 ? dm->ov : dm->fd;
+
+  if(lseek(fd, offset, SEEK_SET) != offset)
     return DK_STAT_HDRERR;
 
-  if(write(dm->fd, buf, (size << 1)) != (size << 1))
+  if(write(fd, buf, (size << 1)) != (size << 1))
     return DK_STAT_HDRERR;
 
+  if(dm->ov >= 0)
+    dk_mapset(&dm->om, &dm->on, dk_ovrec(dm, offset));
+  dk_mapset(&dm->cm, &dm->cn, dk_ovrec(dm, offset));
+
   return DK_STAT_OK;
 }
 
@@ -36,6 +36,8 @@
 
 #include "io.h"
 
+#include "dirty.h"
+
 #define SIGHANDLER
 
 #ifdef SIGHANDLER
@@ -145,6 +147,26 @@ int em50_init(cpu_t *cpu)
   cpu->model = *default_cpumodel();
 #endif
 
+  pthread_mutex_init(&cpu->sys->qlock, NULL);
+  dirty_init(cpu->sys);
+  cpu->sys->cpu[0] = cpu;
+  cpu->sys->ncpu = 1;
+
+  if(!(cpu->icache.e = calloc(ICACHE_SIZE, sizeof(*cpu->icache.e))))
+  {
+    fprintf(stderr, "calloc(icache) failed rc=%d: %s\n", errno, strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+
+  if(!(cpu->tlb.t = calloc(TLB_MAX, sizeof(tlbe_t))))
+  {
+    fprintf(stderr, "calloc(tlb) failed rc=%d: %s\n", errno, strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+  cpu->tlb.mask = TLB_SIZE / TLB_WAYS - 1;
+
+  decode_init();
+
   io_intr_init(cpu);
   cpu_halt_init(cpu);
 
@@ -46,6 +46,11 @@
  #define PRINTF(...) do {} while (0)
 #endif
 
+#define EM50_MAXCPU 1
+#define EM50_MAXAMLC 8
+
+struct cpu_t;
+
 typedef struct sys_t {
   size_t physsize;
   uint8_t *physstor;
@@ -77,6 +82,20 @@ typedef struct sys_t {
 
   char *cpboot;
 
+  char *restore;            // Snapshot to resume from at startup
+  char *overlay;            // Directory of copy-on-write disk overlays
+  char *ckpt;               // Last checkpoint, parent of the next delta
+  char *incoming;           // Unix socket to receive a migration on
+  bool detach;              // Run without CP, console output to stdout
+  char *progname;
+
+  struct clone_t {
+    pid_t pid;
+    int aport, pport;
+  } *clones;                // Clones started by CLONE
+  int nclones;
+  char *clonedir;           // Their snapshots and overlays
+
   enum { st = 0, cp, rc } tmode;
 
 #ifdef DEBUG
@@ -85,22 +104,47 @@ typedef struct sys_t {
 #endif
 
   bool cap_sys_nice;
+  bool nofuse;              // Execute instruction pairs separately
+  uint8_t *dirty;           // Pages written since dirty_reset, a byte per page
+  bool softdirty;           // Host soft-dirty bits are merged by dirty_sync
   pthread_t tid;
+
+  struct cpu_t *cpu[EM50_MAXCPU];
+  int ncpu;
+  pthread_mutex_t qlock;    // Queue adds, and queue pointers that cannot be swapped as one word
+
+  void *devparm[0100];      // Device instances by controller address
+  struct amlc_t *amlc[EM50_MAXAMLC];
+  pthread_t amlc_listener;
 } sys_t;
 
 
-#define CACHE_SIZE 2048
-#define CACHE_MASK (CACHE_SIZE-1)
-#define CACHE_INDEX(_v, _a) ((((_v) & em50_page_mask) >> (em50_page_shift - 1) | (((_a) == acc_wr || (_a) == acc_wx) ? 1 : 0)) & CACHE_MASK)
+#define TLB_WAYS 4
+#define TLB_SIZE 2048
+#define TLB_MIN  (TLB_WAYS*16)
+#define TLB_MAX  16384
+#define TLB_V    0b10  // tlbe_t.e valid
+#define TLB_W    0b01  // tlbe_t.e write enabled, modified recorded
 
 #define IOTLB_SIZE 256
 #define IOTLB_MASK (IOTLB_SIZE-1)
 #define IOTLB_INDEX(_a) (((_a) >> em50_page_shift) & IOTLB_MASK)
 
+#define ICACHE_SIZE 256
+#define ICACHE_MASK (ICACHE_SIZE-1)
+#define ICACHE_INDEX(_r) (((_r) >> em50_page_shift) & ICACHE_MASK)
+#define ICACHE_TAG(_r, _m) (((((_r) >> em50_page_shift) + 1) << 3) | (_m))
+#define ICACHE_NONE 1
+#define ICACHE_LINKS 2
+
 #define INTR_QSIZE 040
 #define INTR_QMASK (INTR_QSIZE-1)
 
+#define INTR_BURST_MIN 16    // Instructions between interrupt checks
+#define INTR_BURST_MAX 4096  // when nothing has been pending for a while
+
 #define IDLE_WAIT 10000
+#define IDLE_TICK 1000   // Dispatcher idle wait in IDLE_WAIT units
 
 typedef enum {
   endop_setjmp = 0,
@@ -112,6 +156,18 @@ typedef enum {
   endop_inhibit
 } endop_t;
 
+/* Ending an instruction early (enb, cai, idle bdx, ...) either
+ * unwinds with longjmp, or with ENDOP_RETURN the handler records
+ * the code in cpu->eop and returns; faults always unwind
+ */
+#if defined(ENDOP_RETURN)
+ #define ENDOP(_c, _e) do { (_c)->eop = (_e); return; } while(0)
+ #define ENDOP_NORETURN
+#else
+ #define ENDOP(_c, _e) longjmp((_c)->endop, (_e))
+ #define ENDOP_NORETURN __attribute__ ((noreturn))
+#endif
+
 
 typedef enum {
   smode_setjmp = 0,
@@ -124,8 +180,24 @@ typedef enum {
 
 struct cp_t;
 struct sc_t;
+struct cpu_t;
+
+typedef struct tlbe_t {
+  uint32_t e;  // Segment and page | TLB_V | TLB_W
+  uint32_t r;  // Real page
+  uint32_t s;  // SDW
+  uint32_t d;  // DTAR
+  uint32_t p;  // PMT/HMAP entry
+  uint8_t *h;  // Host page
+  uint64_t u;  // Last use, tlb.clock does not wrap
+} tlbe_t;
+
+typedef void (*inst_t)(struct cpu_t *, op_t);
+typedef inst_t (*decode_t)(op_t);
 
 typedef struct cpu_t {
+  int id;     // CPU number
+  int idle;   // In the dispatcher waiting for an interrupt, no process ready
   int crn;    // Current register set number
   urs_t *crs; // Current User Register Set
   union {
@@ -151,8 +223,15 @@ typedef struct cpu_t {
   };
   uint32_t maxmem;
   int atr;
+  struct {
+    uint32_t a, b, r; // Operands and result of the last add
+    uint32_t m;       // Its sign bit, 0 when EQ, LT and LINK are current
+  } cc;
   uint64_t c;
   jmp_buf endop;
+#if defined(ENDOP_RETURN)
+  endop_t eop;
+#endif
   jmp_buf smode;
   sys_t *sys;
   struct cp_t *vcp;
@@ -172,24 +251,49 @@ typedef struct cpu_t {
     uint8_t op[6];
   };
   struct {
-    uint32_t e[CACHE_SIZE];
-    uint32_t r[CACHE_SIZE];
-    uint32_t s[CACHE_SIZE];
-    int v[CACHE_SIZE];
+    tlbe_t *t;
+    uint32_t mask;  // Number of sets - 1
+    uint64_t clock;
+    uint64_t hit[TLB_WAYS];
+    uint64_t miss[TLB_WAYS];
+    uint64_t evict[TLB_WAYS];
   } tlb;
   struct {
     uint32_t i[IOTLB_SIZE];
+    uint8_t *h[IOTLB_SIZE];
     int v[IOTLB_SIZE];
   } iotlb;
+  struct {
+    uint32_t vp;                 // Bound virtual page
+    inst_t *h;                   // Handlers for bound page
+    uint8_t *m;                  // Storage of bound page
+    uint32_t t[ICACHE_SIZE];     // Physical page and mode
+    inst_t (*e)[em50_page_size];
+    int x;                       // Slot of bound page
+    uint64_t gen;                // Advanced by ic_unbind, drops all links
+    atomic_uint seq;             // Advanced by ic_dma, checked by a fill
+    struct {
+      uint32_t vp;               // Successor virtual page
+      uint32_t t;                // Tag of its slot when linked
+      int x;
+      uint8_t *m;
+      uint64_t gen;
+    } l[ICACHE_SIZE][ICACHE_LINKS];  // Pages entered from each slot
+  } icache;
+  struct pairs_t *pairs;         // Instruction pair counts when profiling
   struct {
     pthread_mutex_t mutex;
 #if defined(IDLE_WAIT)
     pthread_cond_t cond;
+    atomic_int       idle;       // CPU waiting on cond
 #endif
-    volatile int32_t v[INTR_QSIZE];
+    atomic_int       v[INTR_QSIZE];  // Vector, -1 when cleared
+    atomic_uint      s[INTR_QSIZE];  // Slot sequence
     volatile int32_t c;
-    volatile int     a;
-    volatile int     n;
+    unsigned         a;          // Next position to take (CPU only)
+    atomic_uint      n;          // Next position to post
+    atomic_int       attn;       // Set by io_setintv, ends the burst
+    int              burst;
   } intr;
 #if !defined(MODEL)
   struct cpumodel_t model;
@@ -212,9 +316,60 @@ typedef struct cpu_t {
     pthread_mutex_t mutex;
     pthread_cond_t cond;
     volatile enum { stopped = 0, stepping = 1, started = 2 } status;
+    bool waiting;               // CPU thread is held in cpu_halt
   } halt;
 } cpu_t;
 
+static inline void ic_unbind(cpu_t *cpu)
+{
+  cpu->icache.vp = ICACHE_NONE;
+  ++cpu->icache.gen;
+}
+
+static inline void ic_purge(cpu_t *cpu)
+{
+  ic_unbind(cpu);
+  memset(cpu->icache.t, 0, sizeof(cpu->icache.t));
+}
+
+static inline void ic_store(cpu_t *cpu, uint32_t addr, int n)
+{
+  do {
+    int x = ICACHE_INDEX(addr);
+    if((__atomic_load_n(&cpu->icache.t[x], __ATOMIC_RELAXED) >> 3) == (addr >> em50_page_shift) + 1)
+      __atomic_store_n(&cpu->icache.e[x][addr & em50_page_offm], NULL, __ATOMIC_RELAXED);
+    ++addr;
+  } while(--n > 0);
+}
+
+/* Stores from device threads and the queue routines can land while
+ * the CPU thread fills a handler from the old word, or rebinds the
+ * slot and has not yet stored the new tag.  They advance seq before
+ * clearing the slots, and a fill that finds seq changed drops the
+ * handler it installed, see ic_fill.
+ */
+static inline void ic_dma(cpu_t *cpu, uint32_t addr, int n)
+{
+  atomic_fetch_add_explicit(&cpu->icache.seq, 1, memory_order_release);
+  atomic_thread_fence(memory_order_seq_cst);
+  ic_store(cpu, addr, n);
+}
+
+/* Stores through a TLB entry are recorded when the entry is given
+ * write permission, stores that bypass the TLB record each page
+ */
+static inline void dirty_mark(cpu_t *cpu, uint32_t addr)
+{
+  if(addr < cpu->maxmem)
+    __atomic_store_n(&cpu->sys->dirty[addr >> em50_page_shift], 1, __ATOMIC_RELAXED);
+}
+
+static inline void dirty_range(cpu_t *cpu, uint32_t addr, uint32_t n)
+{
+  for(uint32_t p = addr & em50_page_mask; p < addr + n; p += em50_page_size)
+    dirty_mark(cpu, p);
+}
+
 static inline void mm_piotlb(cpu_t *cpu)
 {
   memset(cpu->iotlb.v, 0, sizeof(cpu->iotlb.v));
@@ -222,7 +377,8 @@ static inline void mm_piotlb(cpu_t *cpu)
 
 static inline void mm_ptlb(cpu_t *cpu)
 {
-  memset(cpu->tlb.v, 0, sizeof(cpu->tlb.v));
+  memset(cpu->tlb.t, 0, (cpu->tlb.mask + 1) * TLB_WAYS * sizeof(tlbe_t));
+  ic_unbind(cpu);
 }
 
 static inline uint32_t em50_timer(void)
@@ -253,9 +409,23 @@ static inline void cpu_halt_init(cpu_t *cpu)
 static inline void cpu_halt(cpu_t *cpu)
 {
   pthread_mutex_lock(&cpu->halt.mutex);
+  cpu->halt.waiting = true;
+  pthread_cond_broadcast(&cpu->halt.cond);
   do {
     pthread_cond_wait(&cpu->halt.cond, &cpu->halt.mutex);
   } while(cpu->halt.status == stopped);
+  cpu->halt.waiting = false;
+  pthread_mutex_unlock(&cpu->halt.mutex);
+}
+
+/* Wait for a stopped CPU to finish its current instruction burst,
+ * after which its state may be changed from another thread
+ */
+static inline void cpu_wait(cpu_t *cpu)
+{
+  pthread_mutex_lock(&cpu->halt.mutex);
+  while(cpu->halt.status == stopped && !cpu->halt.waiting)
+    pthread_cond_wait(&cpu->halt.cond, &cpu->halt.mutex);
   pthread_mutex_unlock(&cpu->halt.mutex);
 }
 
@@ -527,11 +697,42 @@ static inline uint64_t _getdac(uint64_t dac)
 #define S_LB(_u, _v)     ((_u)->crs->lb = (_v))
 #define S_XB(_u, _v)     ((_u)->crs->xb = (_v))
 
-#define G_KEYS(_u)       ((_u)->crs->km.keys)
+/* EQ, LT and LINK of the add and subtract instructions are evaluated
+ * lazily, the operands and result are kept in cpu->cc until the keys
+ * are needed, cc_sync must be called before km is read, or before any
+ * of these bits are set on their own
+ */
+static inline void cc_eval(cpu_t *cpu)
+{
+uint32_t a = cpu->cc.a, b = cpu->cc.b, r = cpu->cc.r, m = cpu->cc.m;
+int ovf = (~(a ^ b) & (a ^ r) & m) != 0;
+
+  cpu->crs->km.eq = r == 0;
+  cpu->crs->km.lt = ((r & m) != 0) ^ ovf;
+  cpu->crs->km.link = (((a & b) | ((a ^ b) & ~r)) & m) != 0;
+  cpu->cc.m = 0;
+}
+
+static inline void cc_sync(cpu_t *cpu)
+{
+  if(cpu->cc.m)
+    cc_eval(cpu);
+}
+
+#define CC_LAZY(_c, _a, _b, _r, _m) \
+  do { \
+    (_c)->cc.a = (_a); \
+    (_c)->cc.b = (_b); \
+    (_c)->cc.r = (_r); \
+    (_c)->cc.m = (_m); \
+  } while (0)
+
+#define G_KEYS(_u)       (cc_sync(_u), (_u)->crs->km.keys)
 
 #define S_KEYS(_u, _k) \
 do {  \
   km_t _km = { .keys = (_k) }; \
+  (_u)->cc.m = 0; \
   if(_km.mode == km_e101 || _km.mode == km_e111) \
     _km.mode = (_u)->crs->km.mode; \
   (_u)->crs->km.keys = _km.keys; \
@@ -595,14 +796,16 @@ static inline uint32_t sdt_r_elim(uint32_t u) { return ((u & sdt_h) >> 1) | (u &
 
 #define _SET_CC(_c, _r, _v) \
   do { \
+    cc_sync(_c); \
     (_c)->crs->km.eq = ((_r) == (_v)); \
     (_c)->crs->km.lt = ((_r) < (_v)); \
   } while (0)
 
 #define SET_CC(_c, _r) _SET_CC(_c, _r, 0)
 
-#define CC_EQ(_c) ((_c)->crs->km.eq)
-#define CC_LT(_c) ((_c)->crs->km.lt)
+#define CC_EQ(_c) (cc_sync(_c), (_c)->crs->km.eq)
+#define CC_LT(_c) (cc_sync(_c), (_c)->crs->km.lt)
+#define CC_LINK(_c) (cc_sync(_c), (_c)->crs->km.link)
 #define CC_NE(_c) (!CC_EQ(_c))
 #define CC_GE(_c) (!CC_LT(_c))
 #define CC_LE(_c) (CC_LT(_c) || CC_EQ(_c))
@@ -647,8 +850,6 @@ int skip = 0;
 
 }
 
-typedef void (*inst_t)(cpu_t *, op_t);
-
 typedef int (*ioop_t)(cpu_t *, int, int, int, int, void **, int, char *[]);
 
 int em50_init(cpu_t *);
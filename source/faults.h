@@ -58,6 +58,7 @@ static char *name[] = {
 
 static inline void __attribute__ ((noreturn)) E50X(rxm_fault)(cpu_t *cpu)
 {
+  cc_sync(cpu);
   cpu->fault.pc     = cpu->po;
   cpu->fault.ring   = cpu->po & ea_r;
   cpu->fault.faddr  = 0;
@@ -71,6 +72,7 @@ static inline void __attribute__ ((noreturn)) E50X(rxm_fault)(cpu_t *cpu)
 
 static inline void __attribute__ ((noreturn)) E50X(process_fault)(cpu_t *cpu, uint16_t abrt)
 {
+  cc_sync(cpu);
   cpu->fault.pc     = cpu->pb;
   cpu->fault.ring   = 0;
   cpu->fault.faddr  = 0;
@@ -84,6 +86,7 @@ static inline void __attribute__ ((noreturn)) E50X(process_fault)(cpu_t *cpu, ui
 
 static inline void __attribute__ ((noreturn)) E50X(page_fault)(cpu_t *cpu, uint32_t addr)
 {
+  cc_sync(cpu);
   cpu->fault.pc     = cpu->po;
   cpu->fault.ring   = 0;
   cpu->fault.faddr  = addr;
@@ -97,6 +100,7 @@ static inline void __attribute__ ((noreturn)) E50X(page_fault)(cpu_t *cpu, uint3
 
 static inline void __attribute__ ((noreturn)) E50X(svc_fault)(cpu_t *cpu)
 {
+  cc_sync(cpu);
   cpu->fault.pc     = cpu->pb;
   cpu->fault.ring   = cpu->pb & ea_r;
   cpu->fault.faddr  = 0;
@@ -110,6 +114,7 @@ static inline void __attribute__ ((noreturn)) E50X(svc_fault)(cpu_t *cpu)
 
 static inline void __attribute__ ((noreturn)) E50X(uii_fault)(cpu_t *cpu, uint32_t addr)
 {
+  cc_sync(cpu);
   cpu->fault.pc     = cpu->po;
   cpu->fault.ring   = cpu->po & ea_r;
   cpu->fault.faddr  = addr,
@@ -125,6 +130,7 @@ static inline void __attribute__ ((noreturn)) E50X(uii_fault)(cpu_t *cpu, uint32
 #define semaphore_fault_over  (1)
 static inline void __attribute__ ((noreturn)) E50X(semaphore_fault)(cpu_t *cpu, uint16_t ovf, uint32_t addr)
 {
+  cc_sync(cpu);
   cpu->fault.pc     = cpu->po;
   cpu->fault.ring   = 0;
   cpu->fault.faddr  = addr;
@@ -138,6 +144,7 @@ static inline void __attribute__ ((noreturn)) E50X(semaphore_fault)(cpu_t *cpu,
 
 static inline void __attribute__ ((noreturn)) E50X(ill_fault)(cpu_t *cpu, uint32_t addr)
 {
+  cc_sync(cpu);
   cpu->fault.pc     = cpu->po;
   cpu->fault.ring   = cpu->po & ea_r;
   cpu->fault.faddr  = addr;
@@ -151,6 +158,7 @@ static inline void __attribute__ ((noreturn)) E50X(ill_fault)(cpu_t *cpu, uint32
 
 static inline void __attribute__ ((noreturn)) E50X(mach_chk)(cpu_t *cpu, uint32_t addr)
 {
+  cc_sync(cpu);
   cpu->fault.pc     = cpu->po;
   cpu->fault.ring   = 0;
   cpu->fault.faddr  = addr;
@@ -164,6 +172,7 @@ static inline void __attribute__ ((noreturn)) E50X(mach_chk)(cpu_t *cpu, uint32_
 
 static inline void __attribute__ ((noreturn)) E50X(missing_mem)(cpu_t *cpu, uint32_t addr)
 {
+  cc_sync(cpu);
   cpu->fault.pc     = cpu->po;
   cpu->fault.ring   = 0;
   cpu->fault.faddr  = addr;
@@ -177,6 +186,7 @@ static inline void __attribute__ ((noreturn)) E50X(missing_mem)(cpu_t *cpu, uint
 
 static inline void __attribute__ ((noreturn)) E50X(access_fault)(cpu_t *cpu, uint32_t addr)
 {
+  cc_sync(cpu);
   cpu->fault.pc     = cpu->po;
   cpu->fault.ring   = 0;
 #if defined V_MODE || defined I_MODE
@@ -194,6 +204,7 @@ static inline void __attribute__ ((noreturn)) E50X(access_fault)(cpu_t *cpu, uin
 
 static inline void __attribute__ ((noreturn)) E50X(arith_fault)(cpu_t *cpu, uint16_t code, uint32_t addr)
 {
+  cc_sync(cpu);
   cpu->fault.pc     = cpu->pb;
   cpu->fault.ring   = cpu->pb & ea_r;
 #if defined V_MODE || defined I_MODE
@@ -212,6 +223,7 @@ static inline void __attribute__ ((noreturn)) E50X(arith_fault)(cpu_t *cpu, uint
 
 static inline void __attribute__ ((noreturn)) E50X(stack_fault)(cpu_t *cpu, uint32_t addr)
 {
+  cc_sync(cpu);
   cpu->fault.pc     = cpu->po;
   cpu->fault.ring   = cpu->po & ea_r;
   cpu->fault.faddr  = addr;
@@ -227,6 +239,7 @@ static inline void __attribute__ ((noreturn)) E50X(stack_fault)(cpu_t *cpu, uint
 #define segment_fault_sdw  (2)
 static inline void __attribute__ ((noreturn)) E50X(segment_fault)(cpu_t *cpu, uint16_t type, uint32_t addr)
 {
+  cc_sync(cpu);
   cpu->fault.pc     = cpu->po;
   cpu->fault.ring   = 0;
 #if defined V_MODE || defined I_MODE
@@ -244,6 +257,7 @@ static inline void __attribute__ ((noreturn)) E50X(segment_fault)(cpu_t *cpu, ui
 
 static inline void __attribute__ ((noreturn)) E50X(pointer_fault)(cpu_t *cpu, uint16_t code, uint32_t addr)
 {
+  cc_sync(cpu);
   cpu->fault.pc     = cpu->po;
   cpu->fault.ring   = cpu->po & ea_r;
   cpu->fault.faddr  = addr;
@@ -257,6 +271,7 @@ static inline void __attribute__ ((noreturn)) E50X(pointer_fault)(cpu_t *cpu, ui
 
 static inline void __attribute__ ((noreturn)) E50X(power_check)(cpu_t *cpu)
 {
+  cc_sync(cpu);
   cpu->fault.pc     = cpu->pb;
   cpu->fault.ring   = cpu->pb & ea_r;
   cpu->fault.faddr  = 0;
@@ -270,6 +285,7 @@ static inline void __attribute__ ((noreturn)) E50X(power_check)(cpu_t *cpu)
 
 static inline void __attribute__ ((noreturn)) E50X(environment_check)(cpu_t *cpu, uint16_t code)
 {
+  cc_sync(cpu);
   cpu->fault.pc     = cpu->pb;
   cpu->fault.ring   = cpu->pb & ea_r;
   cpu->fault.faddr  = 0;
@@ -283,6 +299,7 @@ static inline void __attribute__ ((noreturn)) E50X(environment_check)(cpu_t *cpu
 
 static inline void __attribute__ ((noreturn)) E50X(parity_check)(cpu_t *cpu, uint32_t addr)
 {
+  cc_sync(cpu);
   cpu->fault.pc     = cpu->po;
   cpu->fault.ring   = cpu->po & ea_r;
   cpu->fault.faddr  = addr;
@@ -296,6 +313,7 @@ static inline void __attribute__ ((noreturn)) E50X(parity_check)(cpu_t *cpu, uin
 
 static inline void __attribute__ ((noreturn)) E50X(machine_check)(cpu_t *cpu, uint32_t addr)
 {
+  cc_sync(cpu);
   cpu->fault.pc     = cpu->po;
   cpu->fault.ring   = cpu->po & ea_r;
   cpu->fault.faddr  = addr;
@@ -309,6 +327,7 @@ static inline void __attribute__ ((noreturn)) E50X(machine_check)(cpu_t *cpu, ui
 
 static inline void __attribute__ ((noreturn)) E50X(memory_check)(cpu_t *cpu, uint32_t addr)
 {
+  cc_sync(cpu);
   cpu->fault.pc     = cpu->po;
   cpu->fault.ring   = cpu->po & ea_r;
   cpu->fault.faddr  = addr;
@@ -94,6 +94,36 @@ static inline void E50X(s_qac)(cpu_t *cpu, FLOAT fl)
   S_DAC(cpu, 0, qad.qex.q);
 }
 
+#ifdef FLOAT128
+static inline __uint128_t E50X(g_qad)(cpu_t *cpu)
+{
+  em50_qad qad;
+
+  qad.dbl.q = G_DAC(cpu, 1);
+  qad.qex.q = G_DAC(cpu, 0);
+
+  return qad.q;
+}
+
+static inline __uint128_t E50X(g_qad_s)(cpu_t *cpu, uint32_t ea)
+{
+  em50_qad qad;
+
+  qad.dbl.q = E50X(vfetch_q)(cpu, ea);
+  qad.qex.q = E50X(vfetch_q)(cpu, intraseg_i(ea, 4));
+
+  return qad.q;
+}
+
+static inline void E50X(s_qad)(cpu_t *cpu, __uint128_t q)
+{
+  em50_qad qad = {.q = q};
+
+  S_DAC(cpu, 1, qad.dbl.q);
+  S_DAC(cpu, 0, qad.qex.q);
+}
+#endif
+
 #if defined R_MODE || defined V_MODE || defined I_MODE
 /* BFEQ
  * Branch on Floating Point Accumulator Equal to 0
@@ -700,11 +730,7 @@ E50I(fcm)
   int f = 1;
 #endif
 
-  FLOAT dac = to_dbl(G_DAC(cpu, f));
-
-  dac = -dac;
-
-  S_DAC(cpu, f, from_dbl_rnd(dac));
+  S_DAC(cpu, f, dbl_sub(0, G_DAC(cpu, f)));
 
   cpu->crs->km.cbit = 0;
 
@@ -722,11 +748,7 @@ E50I(dfcm)
   int f = 1;
 #endif
 
-  FLOAT dac = to_dbl(G_DAC(cpu, f));
-
-  dac = -dac;
-
-  S_DAC(cpu, f, from_dbl_rnd(dac));
+  S_DAC(cpu, f, dbl_sub(0, G_DAC(cpu, f)));
 
   cpu->crs->km.cbit = 0;
 
@@ -782,15 +804,12 @@ uint32_t ea = E50X(ea)(cpu, op);
 
   logop2o(op, "*fdv", ea);
 
-  FLOAT dac = to_dbl(G_DAC(cpu, 1));
-
-  FLOAT d = fto_dbl(E50X(vfetch_d)(cpu, ea));
+  uint64_t dac = G_DAC(cpu, 1);
 
-logmsg("-> fdv %e * %e", (double)dac, (double)d);
-  dac /= d;
-logmsg(" = %e\n", (double)dac);
+  uint64_t d = _f2d(E50X(vfetch_d)(cpu, ea));
 
-  S_DAC(cpu, 1, from_dbl_rnd(dac));
+logmsg("-> fdv %e * %e\n", (double)to_dbl(dac), (double)to_dbl(d));
+  S_DAC(cpu, 1, dbl_div(dac, d));
 
   cpu->crs->km.cbit = 0;
 
@@ -804,15 +823,12 @@ uint32_t ea = E50X(ea)(cpu, op);
 
   logop2o(op, "*fmp", ea);
 
-  FLOAT dac = to_dbl(G_DAC(cpu, 1));
+  uint64_t dac = G_DAC(cpu, 1);
 
-  FLOAT d = fto_dbl(E50X(vfetch_d)(cpu, ea));
+  uint64_t d = _f2d(E50X(vfetch_d)(cpu, ea));
 
-logmsg("-> fmp %e * %e", (double)dac, (double)d);
-  dac *= d;
-logmsg(" = %e\n", (double)dac);
-
-  S_DAC(cpu, 1, from_dbl_rnd(dac));
+logmsg("-> fmp %e * %e\n", (double)to_dbl(dac), (double)to_dbl(d));
+  S_DAC(cpu, 1, dbl_mul(dac, d));
 
   cpu->crs->km.cbit = 0;
 
@@ -826,15 +842,12 @@ uint32_t ea = E50X(ea)(cpu, op);
 
   logop2o(op, "*dfmp", ea);
 
-  FLOAT dac = to_dbl(G_DAC(cpu, 1));
-
-  FLOAT d = to_dbl(E50X(vfetch_q)(cpu, ea));
+  uint64_t dac = G_DAC(cpu, 1);
 
-logmsg("-> dfmp %e * %e", (double)dac, (double)d);
-  dac *= d;
-logmsg(" = %e\n", (double)dac);
+  uint64_t d = E50X(vfetch_q)(cpu, ea);
 
-  S_DAC(cpu, 1, from_dbl_rnd(dac));
+logmsg("-> dfmp %e * %e\n", (double)to_dbl(dac), (double)to_dbl(d));
+  S_DAC(cpu, 1, dbl_mul(dac, d));
 
   cpu->crs->km.cbit = 0;
 
@@ -848,15 +861,12 @@ uint32_t ea = E50X(ea)(cpu, op);
 
   logop2o(op, "*dfdv", ea);
 
-  FLOAT dac = to_dbl(G_DAC(cpu, 1));
-
-  FLOAT d = to_dbl(E50X(vfetch_q)(cpu, ea));
+  uint64_t dac = G_DAC(cpu, 1);
 
-logmsg("-> dfdv %e / %e", (double)dac, (double)d);
-  dac /= d;
-logmsg(" = %e\n", (double)dac);
+  uint64_t d = E50X(vfetch_q)(cpu, ea);
 
-  S_DAC(cpu, 1, from_dbl_rnd(dac));
+logmsg("-> dfdv %e / %e\n", (double)to_dbl(dac), (double)to_dbl(d));
+  S_DAC(cpu, 1, dbl_div(dac, d));
 
   cpu->crs->km.cbit = 0;
 
@@ -870,15 +880,12 @@ uint32_t ea = E50X(ea)(cpu, op);
 
   logop2o(op, "*fad", ea);
 
-  FLOAT dac = to_dbl(G_DAC(cpu, 1));
+  uint64_t dac = G_DAC(cpu, 1);
 
-  FLOAT d = fto_dbl(E50X(vfetch_d)(cpu, ea));
+  uint64_t d = _f2d(E50X(vfetch_d)(cpu, ea));
 
-logmsg("-> fad %e + %e", (double)dac, (double)d);
-  dac += d;
-logmsg(" = %e\n", (double)dac);
-
-  S_DAC(cpu, 1, from_dbl_rnd(dac));
+logmsg("-> fad %e + %e\n", (double)to_dbl(dac), (double)to_dbl(d));
+  S_DAC(cpu, 1, dbl_add(dac, d));
 
   cpu->crs->km.cbit = 0;
 
@@ -892,15 +899,12 @@ uint32_t ea = E50X(ea)(cpu, op);
 
   logop2o(op, "*dfad", ea);
 
-  FLOAT dac = to_dbl(G_DAC(cpu, 1));
+  uint64_t dac = G_DAC(cpu, 1);
 
-  FLOAT d = to_dbl(E50X(vfetch_q)(cpu, ea));
+  uint64_t d = E50X(vfetch_q)(cpu, ea);
 
-logmsg("-> dfad %e + %e", (double)dac, (double)d);
-  dac += d;
-logmsg(" = %e\n", (double)dac);
-
-  S_DAC(cpu, 1, from_dbl_rnd(dac));
+logmsg("-> dfad %e + %e\n", (double)to_dbl(dac), (double)to_dbl(d));
+  S_DAC(cpu, 1, dbl_add(dac, d));
 
   cpu->crs->km.cbit = 0;
 
@@ -914,15 +918,12 @@ uint32_t ea = E50X(ea)(cpu, op);
 
   logop2o(op, "*fsb", ea);
 
-  FLOAT fac = fto_dbl(G_FAC(cpu, 1));
+  uint64_t fac = _f2d(G_FAC(cpu, 1));
 
-  FLOAT d = fto_dbl(E50X(vfetch_d)(cpu, ea));
-
-logmsg("-> fsb %e - %e", (double)fac, (double)d);
-  fac -= d;
-logmsg(" = %e\n", (double)fac);
+  uint64_t d = _f2d(E50X(vfetch_d)(cpu, ea));
 
-  S_FAC(cpu, 1, ffrom_dbl_rnd(fac));
+logmsg("-> fsb %e - %e\n", (double)to_dbl(fac), (double)to_dbl(d));
+  S_FAC(cpu, 1, _d2f(dbl_sub(fac, d)));
 
   cpu->crs->km.cbit = 0;
 
@@ -936,15 +937,12 @@ uint32_t ea = E50X(ea)(cpu, op);
 
   logop2o(op, "*dfsb", ea);
 
-  FLOAT dac = to_dbl(G_DAC(cpu, 1));
+  uint64_t dac = G_DAC(cpu, 1);
 
-  FLOAT d = to_dbl(E50X(vfetch_q)(cpu, ea));
-
-logmsg("-> dfsb %e - %e", (double)dac, (double)d);
-  dac -= d;
-logmsg(" = %e\n", (double)dac);
+  uint64_t d = E50X(vfetch_q)(cpu, ea);
 
-  S_DAC(cpu, 1, from_dbl_rnd(dac));
+logmsg("-> dfsb %e - %e\n", (double)to_dbl(dac), (double)to_dbl(d));
+  S_DAC(cpu, 1, dbl_sub(dac, d));
 
   cpu->crs->km.cbit = 0;
 
@@ -1081,11 +1079,7 @@ int f = FAC(op);
 
   logop2o(op, "*fa", f);
 
-  FLOAT fac = to_dbl(G_DAC(cpu, f));
-
-  fac += fto_dbl(E50X(efetch_d)(cpu, op));
-
-  S_DAC(cpu, f, from_dbl_rnd(fac));
+  S_DAC(cpu, f, dbl_add(G_DAC(cpu, f), _f2d(E50X(efetch_d)(cpu, op))));
 
   cpu->crs->km.cbit = 0;
 
@@ -1099,11 +1093,7 @@ int f = FAC(op);
 
   logop2o(op, "*dfa", f);
 
-  FLOAT dac = to_dbl(G_DAC(cpu, f));
-
-  dac += to_dbl(E50X(efetch_q)(cpu, op));
-
-  S_DAC(cpu, f, from_dbl_rnd(dac));
+  S_DAC(cpu, f, dbl_add(G_DAC(cpu, f), E50X(efetch_q)(cpu, op)));
 
   cpu->crs->km.cbit = 0;
 
@@ -1117,11 +1107,7 @@ int f = FAC(op);
 
   logop2o(op, "dfs", f);
 
-  FLOAT fac = to_dbl(G_DAC(cpu, f));
-
-  fac -= fto_dbl(E50X(efetch_d)(cpu, op));
-
-  S_DAC(cpu, f, from_dbl_rnd(fac));
+  S_DAC(cpu, f, dbl_sub(G_DAC(cpu, f), _f2d(E50X(efetch_d)(cpu, op))));
 
   cpu->crs->km.cbit = 0;
 
@@ -1135,11 +1121,7 @@ int f = FAC(op);
 
   logop2o(op, "*dfs", f);
 
-  FLOAT dac = to_dbl(G_DAC(cpu, f));
-
-  dac -= to_dbl(E50X(efetch_q)(cpu, op));
-
-  S_DAC(cpu, f, from_dbl_rnd(dac));
+  S_DAC(cpu, f, dbl_sub(G_DAC(cpu, f), E50X(efetch_q)(cpu, op)));
 
   cpu->crs->km.cbit = 0;
 
@@ -1153,11 +1135,7 @@ int f = FAC(op);
 
   logop2o(op, "*fm", f);
 
-  FLOAT fac = to_dbl(G_DAC(cpu, f));
-
-  fac *= fto_dbl(E50X(efetch_d)(cpu, op));
-
-  S_DAC(cpu, f, from_dbl_rnd(fac));
+  S_DAC(cpu, f, dbl_mul(G_DAC(cpu, f), _f2d(E50X(efetch_d)(cpu, op))));
 
   cpu->crs->km.cbit = 0;
 
@@ -1171,11 +1149,7 @@ int f = FAC(op);
 
   logop2o(op, "*dfm", f);
 
-  FLOAT dac = to_dbl(G_DAC(cpu, f));
-
-  dac *= to_dbl(E50X(efetch_q)(cpu, op));
-
-  S_DAC(cpu, f, from_dbl_rnd(dac));
+  S_DAC(cpu, f, dbl_mul(G_DAC(cpu, f), E50X(efetch_q)(cpu, op)));
 
   cpu->crs->km.cbit = 0;
 
@@ -1189,11 +1163,7 @@ int f = FAC(op);
 
   logop2o(op, "*fd", f);
 
-  FLOAT fac = to_dbl(G_DAC(cpu, f));
-
-  fac /= fto_dbl(E50X(efetch_d)(cpu, op));
-
-  S_DAC(cpu, f, from_dbl_rnd(fac));
+  S_DAC(cpu, f, dbl_div(G_DAC(cpu, f), _f2d(E50X(efetch_d)(cpu, op))));
 
   cpu->crs->km.cbit = 0;
 
@@ -1207,11 +1177,7 @@ int f = FAC(op);
 
   logop2o(op, "*dfd", f);
 
-  FLOAT dac = to_dbl(G_DAC(cpu, f));
-
-  dac /= to_dbl(E50X(efetch_q)(cpu, op));
-
-  S_DAC(cpu, f, from_dbl_rnd(dac));
+  S_DAC(cpu, f, dbl_div(G_DAC(cpu, f), E50X(efetch_q)(cpu, op)));
 
   cpu->crs->km.cbit = 0;
 
@@ -1366,6 +1332,9 @@ static inline void E50X(_qfad)(cpu_t *cpu, op_t op, uint32_t ea)
 {
   logop2o(op, "*qfad", ea);
 
+#ifdef FLOAT128
+  E50X(s_qad)(cpu, qad_add(E50X(g_qad)(cpu), E50X(g_qad_s)(cpu, ea)));
+#else
   FLOAT dac = E50X(g_qac)(cpu);
   FLOAT d = E50X(g_qac_s)(cpu, ea);
 
@@ -1374,6 +1343,7 @@ logmsg("-> qfad %e + %e", (double)dac, (double)d);
 logmsg(" = %e\n", (double)dac);
 
   E50X(s_qac)(cpu, dac);
+#endif
 
   cpu->crs->km.cbit = 0;
 
@@ -1384,6 +1354,9 @@ static inline void E50X(_qfsb)(cpu_t *cpu, op_t op, uint32_t ea)
 {
   logop2o(op, "*qfsb", ea);
 
+#ifdef FLOAT128
+  E50X(s_qad)(cpu, qad_sub(E50X(g_qad)(cpu), E50X(g_qad_s)(cpu, ea)));
+#else
   FLOAT dac = E50X(g_qac)(cpu);
   FLOAT d = E50X(g_qac_s)(cpu, ea);
 
@@ -1392,6 +1365,7 @@ logmsg("-> qfsb %e - %e", (double)dac, (double)d);
 logmsg(" = %e\n", (double)dac);
 
   E50X(s_qac)(cpu, dac);
+#endif
 
   cpu->crs->km.cbit = 0;
 
@@ -1402,6 +1376,9 @@ static inline void E50X(_qfmp)(cpu_t *cpu, op_t op, uint32_t ea)
 {
   logop2o(op, "*qfmp", ea);
 
+#ifdef FLOAT128
+  E50X(s_qad)(cpu, qad_mul(E50X(g_qad)(cpu), E50X(g_qad_s)(cpu, ea)));
+#else
   FLOAT dac = E50X(g_qac)(cpu);
   FLOAT d = E50X(g_qac_s)(cpu, ea);
 
@@ -1410,6 +1387,7 @@ logmsg("-> qfmp %e * %e", (double)dac, (double)d);
 logmsg(" = %e\n", (double)dac);
 
   E50X(s_qac)(cpu, dac);
+#endif
 
   cpu->crs->km.cbit = 0;
 
@@ -1420,12 +1398,16 @@ static inline void E50X(_qfdv)(cpu_t *cpu, op_t op, uint32_t ea)
 {
   logop2o(op, "*qfdv", ea);
 
+#ifdef FLOAT128
+  E50X(s_qad)(cpu, qad_div(E50X(g_qad)(cpu), E50X(g_qad_s)(cpu, ea)));
+#else
   FLOAT qac = E50X(g_qac)(cpu);
   FLOAT qdl = E50X(g_qac_s)(cpu, ea);
 
   qac /= qdl;
 
   E50X(s_qac)(cpu, qac);
+#endif
 
   cpu->crs->km.cbit = 0;
 
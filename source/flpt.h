@@ -261,6 +261,301 @@ em50_flt f;
   return f.d;
 }
 
+
+/* Prime format arithmetic
+ *
+ * A double is a 48 bit two's complement fraction F with exponent e,
+ * value = F * 2^(e - 128 - 47), quad extends F with another 48 bits.
+ * Operations are exact on the integer fractions, the result is rounded
+ * once: to 47 magnitude bits half away from zero for double, as does
+ * from_dbl_rnd(), and truncated to 95 bits for quad, as does from_qad().
+ * Exponent overflow wraps, as it does with the IEEE conversions.
+ */
+#if defined(__SIZEOF_INT128__)
+#define FLPT_NATIVE
+
+typedef struct {
+  __uint128_t m;  // magnitude
+  int x;          // value = m * 2^x
+  int neg;
+} flpt_t;
+
+static inline int flpt_bits(__uint128_t m)
+{
+  return (m >> 64) ? 128 - __builtin_clzll(m >> 64) : 64 - __builtin_clzll(m | 1);
+}
+
+static inline flpt_t dbl_unpack(uint64_t d)
+{
+int64_t f = (int64_t)d >> 16;
+flpt_t r = { .m = f < 0 ? -f : f, .x = (int)(d & 0xffff) - 128 - 47, .neg = f < 0 };
+
+  return r;
+}
+
+static inline uint64_t dbl_pack(flpt_t v)
+{
+  if(!v.m)
+    return 0;
+
+  int s = flpt_bits(v.m) - 47;
+
+  if(s > 0)
+  {
+    v.m = (v.m + ((__uint128_t)1 << (s - 1))) >> s;
+    if(v.m >> 47)
+    {
+      v.m >>= 1;
+      ++s;
+    }
+  }
+  else
+    v.m <<= -s;
+
+  int e = v.x + s + 128 + 47;
+  int64_t f = v.neg ? -(int64_t)v.m : (int64_t)v.m;
+
+  /* -0.5 is normalised as -1.0 * 2^-1 */
+  if(v.neg && v.m == (1ULL << 46))
+  {
+    f = -(1LL << 47);
+    --e;
+  }
+
+  return ((uint64_t)f << 16) | (e & 0xffff);
+}
+
+#ifdef FLOAT128
+static inline flpt_t qad_unpack(__uint128_t q)
+{
+em50_qad v = {.q = q};
+__int128_t f = ((__int128_t)((int64_t)v.dbl.q >> 16) << 48) | v.qex.mantissa;
+flpt_t r = { .m = f < 0 ? -f : f, .x = (int)v.dbl.exponent - 128 - 95, .neg = f < 0 };
+
+  return r;
+}
+
+static inline __uint128_t qad_pack(flpt_t v)
+{
+em50_qad r = {.q = 0};
+
+  if(!v.m)
+    return r.q;
+
+  int s = flpt_bits(v.m) - 95;
+
+  if(s > 0)
+    v.m >>= s;
+  else
+    v.m <<= -s;
+
+  int e = v.x + s + 128 + 95;
+  __int128_t f = v.neg ? -(__int128_t)v.m : (__int128_t)v.m;
+
+  if(v.neg && v.m == ((__uint128_t)1 << 94))
+  {
+    f = -((__int128_t)1 << 95);
+    --e;
+  }
+
+  r.dbl.q = ((uint64_t)(f >> 48) << 16) | (e & 0xffff);
+  r.qex.q = (uint64_t)f << 16;
+
+  return r.q;
+}
+#endif
+
+/* Operands are aligned with the magnitude in bits 0..125, what is shifted
+   out of the smaller operand is kept as a sticky bit */
+static inline flpt_t flpt_add(flpt_t a, flpt_t b)
+{
+  if(!a.m)
+    return b;
+  if(!b.m)
+    return a;
+
+  int sa = 126 - flpt_bits(a.m);
+  int sb = 126 - flpt_bits(b.m);
+  a.m <<= sa; a.x -= sa;
+  b.m <<= sb; b.x -= sb;
+
+  if(a.x < b.x)
+  {
+    flpt_t t = a; a = b; b = t;
+  }
+
+  int d = a.x - b.x;
+  if(d > 0)
+    b.m = d < 128 ? (b.m >> d) | ((b.m << (128 - d)) != 0) : 1;
+
+  __int128_t r = (a.neg ? -(__int128_t)a.m : (__int128_t)a.m) + (b.neg ? -(__int128_t)b.m : (__int128_t)b.m);
+  flpt_t v = { .m = r < 0 ? -r : r, .x = a.x, .neg = r < 0 };
+
+  return v;
+}
+
+/* Magnitudes are at most 96 bits, the product is formed from 48 bit
+   halves and reduced to 126 bits, with a sticky bit for what is lost */
+static inline flpt_t flpt_mul(flpt_t a, flpt_t b)
+{
+flpt_t v = { .m = 0, .x = a.x + b.x, .neg = a.neg ^ b.neg };
+const __uint128_t h = ((__uint128_t)1 << 48) - 1;
+
+  if(!a.m || !b.m)
+    return v;
+
+  __uint128_t a1 = a.m >> 48, a0 = a.m & h;
+  __uint128_t b1 = b.m >> 48, b0 = b.m & h;
+  __uint128_t lo = a0 * b0;
+  __uint128_t mid = a1 * b0 + a0 * b1 + (lo >> 48);
+  __uint128_t hi = a1 * b1 + (mid >> 48);
+
+  if(!(hi >> 32))
+  {
+    v.m = (hi << 96) | ((mid & h) << 48) | (lo & h);
+    return v;
+  }
+
+  __uint128_t l = ((mid & h) << 48) | (lo & h);
+  int n = flpt_bits(hi) - 30;
+  v.m = (hi << (96 - n)) | (l >> n) | ((l << (128 - n)) != 0);
+  v.x += n;
+
+  return v;
+}
+
+/* Double precision divisors have at most 48 bits, so one 128 by 64 bit
+   divide gives at least 80 quotient bits, the remainder is kept as a
+   sticky bit */
+static inline flpt_t flpt_div_s(flpt_t a, flpt_t b)
+{
+flpt_t v = { .m = 0, .x = a.x - b.x, .neg = a.neg ^ b.neg };
+
+  if(!a.m)
+    return v;
+
+  int sa = 127 - flpt_bits(a.m);
+  a.m <<= sa; v.x -= sa + 1;
+  v.m = a.m / b.m;
+  v.m = (v.m << 1) | ((a.m % b.m) != 0);
+
+  return v;
+}
+
+/* Quad precision divisors have up to 96 bits, the quotient is formed 32
+   bits at a time from the remainder, giving at least 127 quotient bits, the
+   remainder is kept as a sticky bit */
+static inline flpt_t flpt_div(flpt_t a, flpt_t b)
+{
+flpt_t v = { .m = 0, .x = a.x - b.x, .neg = a.neg ^ b.neg };
+
+  if(!a.m)
+    return v;
+
+  int sa = 126 - flpt_bits(a.m);
+  int sb = 96 - flpt_bits(b.m);
+  a.m <<= sa; v.x -= sa;
+  b.m <<= sb; v.x += sb;
+
+  v.m = a.m / b.m;
+  __uint128_t r = a.m % b.m;
+
+  for(int n = 0; n < 3; ++n)
+  {
+    r <<= 32;
+    v.m = (v.m << 32) | (r / b.m);
+    r %= b.m;
+  }
+
+  v.m = (v.m << 1) | (r != 0);
+  v.x -= 97;
+
+  return v;
+}
+
+static inline uint64_t dbl_add(uint64_t a, uint64_t b)
+{
+  return dbl_pack(flpt_add(dbl_unpack(a), dbl_unpack(b)));
+}
+
+static inline uint64_t dbl_sub(uint64_t a, uint64_t b)
+{
+flpt_t v = dbl_unpack(b);
+
+  v.neg = !v.neg;
+
+  return dbl_pack(flpt_add(dbl_unpack(a), v));
+}
+
+static inline uint64_t dbl_mul(uint64_t a, uint64_t b)
+{
+  return dbl_pack(flpt_mul(dbl_unpack(a), dbl_unpack(b)));
+}
+
+static inline uint64_t dbl_div(uint64_t a, uint64_t b)
+{
+flpt_t d = dbl_unpack(b);
+
+  if(!d.m)
+    return from_dbl_rnd(to_dbl(a) / to_dbl(b));
+
+  return dbl_pack(flpt_div_s(dbl_unpack(a), d));
+}
+
+#ifdef FLOAT128
+static inline __uint128_t qad_add(__uint128_t a, __uint128_t b)
+{
+  return qad_pack(flpt_add(qad_unpack(a), qad_unpack(b)));
+}
+
+static inline __uint128_t qad_sub(__uint128_t a, __uint128_t b)
+{
+flpt_t v = qad_unpack(b);
+
+  v.neg = !v.neg;
+
+  return qad_pack(flpt_add(qad_unpack(a), v));
+}
+
+static inline __uint128_t qad_mul(__uint128_t a, __uint128_t b)
+{
+  return qad_pack(flpt_mul(qad_unpack(a), qad_unpack(b)));
+}
+
+static inline __uint128_t qad_div(__uint128_t a, __uint128_t b)
+{
+flpt_t d = qad_unpack(b);
+
+  if(!d.m)
+    return from_qad(to_qad(a) / to_qad(b));
+
+  return qad_pack(flpt_div(qad_unpack(a), d));
+}
+#endif
+
+#else
+
+static inline uint64_t dbl_add(uint64_t a, uint64_t b)
+{
+  return from_dbl_rnd(to_dbl(a) + to_dbl(b));
+}
+
+static inline uint64_t dbl_sub(uint64_t a, uint64_t b)
+{
+  return from_dbl_rnd(to_dbl(a) - to_dbl(b));
+}
+
+static inline uint64_t dbl_mul(uint64_t a, uint64_t b)
+{
+  return from_dbl_rnd(to_dbl(a) * to_dbl(b));
+}
+
+static inline uint64_t dbl_div(uint64_t a, uint64_t b)
+{
+  return from_dbl_rnd(to_dbl(a) / to_dbl(b));
+}
+#endif
+
 #endif
 
 
@@ -0,0 +1,205 @@
+/* Instruction Pair Fusion
+ *
+ *
+ * Copyright Notice:
+ *
+ *   Copyright (C) 1999-2020 Jan Jaeger, All Rights Reserved.
+ *
+ *
+ * This file is part of the Prime 50 Series Emulator (em50).
+ *
+ *
+ * License Statement:
+ *
+ *   The Prime 50 Series Emulator (em50) is free software:
+ *   You can redistribute it and/or modify it under the terms
+ *   of the GNU General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License,
+ *   or (at your option) any later version.
+ *
+ *   em50 is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *   See the GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with em50.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+
+#include "emu.h"
+
+#include "mode.h"
+
+#include "opcode.h"
+
+#include "move.h"
+
+#include "int.h"
+
+#include "skip.h"
+
+#include "pctlj.h"
+
+#include "bran.h"
+
+#include "fuse.h"
+
+
+/* A fused handler executes the first instruction of a pair and, when
+ * the instruction that follows is the expected second one, fetches and
+ * executes it directly rather than returning to the dispatch loop.
+ * The pair is only continued at a boundary where the burst loop would
+ * carry on: no interrupt attention is pending, the first instruction
+ * completed normally, the next word is in the bound icache page and
+ * is not an address trap.
+ */
+static inline inst_t E50X(fuse_peek)(cpu_t *cpu)
+{
+  if(atomic_load_explicit(&cpu->intr.attn, memory_order_acquire)
+#if defined(ENDOP_RETURN)
+    || cpu->eop != endop_run
+#endif
+    || (cpu->pb & em50_page_mask) != cpu->icache.vp
+#if defined V_MODE || defined I_MODE
+    || ISAT(cpu, cpu->pb))
+#else
+    || ISAT(cpu, cpu->p))
+#endif
+    return NULL;
+
+  return cpu->icache.h[ea_off(cpu->pb)];
+}
+
+
+static inline void E50X(fuse_fetch)(cpu_t *cpu)
+{
+  logopr(cpu);
+
+  cpu->exec = 0;
+  ++cpu->c;
+  cpu->po = cpu->pb;
+  cpu->inst = *(uint16_t *)(cpu->icache.m + (ea_off(cpu->pb) << 1));
+  cpu->p++;
+}
+
+
+#define FUSE(_h) \
+  if(h == E50X(_h)) \
+  { \
+    E50X(fuse_fetch)(cpu); \
+    E50X(_h)(cpu, cpu->op); \
+    return; \
+  }
+
+#define FUSEF(_h) \
+  if(h == E50X(_h) || h == E50X(fuse_ ## _h)) \
+  { \
+    E50X(fuse_fetch)(cpu); \
+    E50X(_h)(cpu, cpu->op); \
+    return; \
+  }
+
+
+#ifndef I_MODE
+static E50I(fuse_cas);
+
+// LDA followed by STA, ADD, SUB, CAS, BEQ or BNE
+static E50I(fuse_lda)
+{
+  E50X(lda)(cpu, op);
+
+  inst_t h = E50X(fuse_peek)(cpu);
+
+  FUSE(sta);
+  FUSE(add);
+  FUSE(sub);
+  FUSEF(cas);
+#if defined R_MODE || defined V_MODE
+  FUSE(beq);
+  FUSE(bne);
+#endif
+}
+
+
+// CAS followed by JMP, the skip returns to the JMP or past it
+static E50I(fuse_cas)
+{
+  E50X(cas)(cpu, op);
+
+  inst_t h = E50X(fuse_peek)(cpu);
+
+  FUSE(jmp);
+}
+
+
+// TAX followed by JMP
+static E50I(fuse_tax)
+{
+  E50X(tax)(cpu, op);
+
+  inst_t h = E50X(fuse_peek)(cpu);
+
+  FUSE(jmp);
+}
+#else
+static E50I(fuse_c);
+
+// L followed by ST or C
+static E50I(fuse_l)
+{
+  E50X(l)(cpu, op);
+
+  inst_t h = E50X(fuse_peek)(cpu);
+
+  FUSE(st);
+  FUSEF(c);
+}
+
+
+// C followed by a branch on condition code
+static E50I(fuse_c)
+{
+  E50X(c)(cpu, op);
+
+  inst_t h = E50X(fuse_peek)(cpu);
+
+  FUSE(bceq);
+  FUSE(bcne);
+  FUSE(bclt);
+  FUSE(bcge);
+}
+#endif
+
+
+/* Select the handler cached for an instruction, profiling counts the
+ * pairs as executed and therefore disables fusion
+ */
+inst_t E50X(fuse_bind)(cpu_t *cpu, inst_t h)
+{
+  if(cpu->pairs || cpu->sys->nofuse)
+    return h;
+
+#ifndef I_MODE
+  if(h == E50X(lda))
+    return E50X(fuse_lda);
+  if(h == E50X(cas))
+    return E50X(fuse_cas);
+  if(h == E50X(tax))
+    return E50X(fuse_tax);
+#else
+  if(h == E50X(l))
+    return E50X(fuse_l);
+  if(h == E50X(c))
+    return E50X(fuse_c);
+#endif
+
+  return h;
+}
+
+
+#ifndef EMDE
+ #include __FILE__
+#endif
@@ -0,0 +1,94 @@
+/* Instruction Pair Fusion
+ *
+ *
+ * Copyright Notice:
+ *
+ *   Copyright (C) 1999-2020 Jan Jaeger, All Rights Reserved.
+ *
+ *
+ * This file is part of the Prime 50 Series Emulator (em50).
+ *
+ *
+ * License Statement:
+ *
+ *   The Prime 50 Series Emulator (em50) is free software:
+ *   You can redistribute it and/or modify it under the terms
+ *   of the GNU General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License,
+ *   or (at your option) any later version.
+ *
+ *   em50 is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *   See the GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with em50.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+
+#ifndef _fuse_h
+#define _fuse_h
+
+#define PAIRS_SIZE  4096
+#define PAIRS_MASK  (PAIRS_SIZE-1)
+#define PAIRS_PROBE 8
+#define PAIRS_HASH(_a, _b) \
+  ((((uintptr_t)(_a) >> 4) ^ ((uintptr_t)(_b) >> 2) * 0x9e37) & PAIRS_MASK)
+
+/* Adjacent instruction pair counts, keyed on the resolved handlers
+ * which are distinct per mode, w holds a sample instruction word
+ */
+typedef struct pairs_t {
+  inst_t   prev;
+  uint16_t w;
+  uint64_t other;              // Pairs not recorded, table crowded
+  struct {
+    inst_t   a, b;
+    uint16_t wa, wb;
+    uint64_t n;
+  } e[PAIRS_SIZE];
+} pairs_t;
+
+static inline void pairs_count(pairs_t *p, inst_t h, uint16_t w)
+{
+  if(p->prev)
+  {
+    unsigned x = PAIRS_HASH(p->prev, h);
+    int n;
+
+    for(n = 0; n < PAIRS_PROBE; ++n, x = (x + 1) & PAIRS_MASK)
+      if(p->e[x].a == p->prev && p->e[x].b == h)
+      {
+        ++p->e[x].n;
+        break;
+      }
+      else
+        if(!p->e[x].n)
+        {
+          p->e[x].a = p->prev;
+          p->e[x].b = h;
+          p->e[x].wa = p->w;
+          p->e[x].wb = w;
+          p->e[x].n = 1;
+          break;
+        }
+
+    if(n == PAIRS_PROBE)
+      ++p->other;
+  }
+
+  p->prev = h;
+  p->w = w;
+}
+
+extern inst_t e16s_fuse_bind(cpu_t *, inst_t);
+extern inst_t e32s_fuse_bind(cpu_t *, inst_t);
+extern inst_t e64r_fuse_bind(cpu_t *, inst_t);
+extern inst_t e32r_fuse_bind(cpu_t *, inst_t);
+extern inst_t e32i_fuse_bind(cpu_t *, inst_t);
+extern inst_t e64v_fuse_bind(cpu_t *, inst_t);
+
+#endif
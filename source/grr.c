@@ -69,13 +69,10 @@ E50I(aip)
   uint32_t r = G_R(cpu, dr) & (ea_s|ea_w);
   uint32_t s = E50X(vfetch_il)(cpu, ea);
 
-  int eq, lt, car, ovf;
+  int ovf;
 
-  r = add_d(s, r, &eq, &lt, &car, &ovf);
+  r = add_d_cc(cpu, s, r, &ovf);
 
-  cpu->crs->km.eq = eq;
-  cpu->crs->km.lt = lt;
-  cpu->crs->km.link = car;
   cpu->crs->km.cbit = ovf;
 
   S_R(cpu, dr, r);
@@ -208,6 +205,7 @@ E50I(tcnp)
 
   uint32_t r = E50X(efetch_d)(cpu, op);
 
+  cc_sync(cpu);
   cpu->crs->km.eq = (r & 0x1fffffff) == 0 ? 1 : 0;
   cpu->crs->km.lt = 0;
 }
@@ -220,6 +218,7 @@ int dr = op_dr(op);
 
   uint32_t r = G_R(cpu, dr);
 
+  cc_sync(cpu);
   cpu->crs->km.eq = (r & 0x1fffffff) == 0 ? 1 : 0;
   cpu->crs->km.lt = 0;
 }
@@ -207,6 +207,99 @@ help_t help_lights = { "Display console lights",
 "  Displays the value of the console lights continuously,\n"
 "  terminate with <control> C" };
 
+help_t help_tlb = { "Display or set TLB configuration",
+"TLB\n"
+"  Displays the TLB size and the hit, miss and eviction counts of each way.\n"
+"\n"
+"TLB [entries]\n"
+"  Sets the number of TLB entries, which must be a power of 2.\n"
+"  The CPU must not be running.\n"
+"\n"
+"TLB Reset\n"
+"  Resets the TLB counters." };
+
+help_t help_pairs = { "Display or control instruction pair profiling and fusion",
+"PAIRS [n]\n"
+"  Displays the n (default 20) most frequent adjacent instruction\n"
+"  pairs executed by the CPU since profiling was switched on, with\n"
+"  a sample instruction word for each, the names show the mode.\n"
+"\n"
+"PAIRS On|Off\n"
+"  Starts or ends counting pairs. Fusion is suspended while counting.\n"
+"\n"
+"PAIRS Fuse On|Off\n"
+"  Executes frequent pairs (e.g. LDA STA, CAS JMP, TAX JMP) through\n"
+"  a single fused handler, which is the default.\n"
+"  The CPUs must not be running.\n"
+"\n"
+"PAIRS Reset\n"
+"  Resets the pair counts." };
+
+help_t help_save = { "Save the machine state to a file",
+"SAVE filename\n"
+"  Writes storage, the CPU registers and the device state to a\n"
+"  snapshot file. Running CPUs are held while the file is written\n"
+"  and then continue.\n"
+"  Disk and tape files are not part of the snapshot, they must not\n"
+"  be changed before the snapshot is restored." };
+
+help_t help_restore = { "Restore the machine state from a file",
+"RESTore filename\n"
+"  Resumes the machine from a snapshot written by SAVE, the CPUs\n"
+"  that were running when it was saved are started. Storage is\n"
+"  mapped from the file and read as it is referenced.\n"
+"  The storage size and the devices must match the saved system,\n"
+"  the same snapshot can be restored at startup with --restore." };
+
+help_t help_clone = { "Start copies of the running machine",
+"CLone [count [port [pncport]]]\n"
+"  Saves the machine to <path>/clone/snap<n> and starts count copies\n"
+"  of the emulator resuming from it, without a CP and with console\n"
+"  output in <path>/clone/<n>/console. Storage is shared with the\n"
+"  snapshot until it is written.\n"
+"  Each copy starts from the disks as this machine sees them, its\n"
+"  disk writes go to overlays of its own in <path>/clone/<n>. This\n"
+"  machine from the first CLONE on writes to <path>/clone/0, or to\n"
+"  the overlays it already has, disk files remain unchanged.\n"
+"  CLONE can be repeated, copies are numbered on. A machine that\n"
+"  already has overlays keeps its copies in clone in the overlay\n"
+"  directory, so that copies can be cloned in turn.\n"
+"  The copies of one CLONE listen on AMLC ports from port and PNC\n"
+"  ports from pncport on, by default 100 and 200 above the ports of\n"
+"  this machine plus the number of copies started before.\n"
+"  Without arguments the copies are listed." };
+
+help_t help_checkpoint = { "Save the machine state incrementally",
+"CHECKpoint [BASE] filename\n"
+"  The first checkpoint, or one with BASE, is a full snapshot. Disk\n"
+"  writes from then on go to overlays in filename.disk, the disk\n"
+"  files stay as they were at the base.\n"
+"  Each later checkpoint holds only the storage pages and the disk\n"
+"  records written since the previous one, which it names as its\n"
+"  parent, so the CPUs are held for a time that follows the amount\n"
+"  written.\n"
+"  RESTORE or --restore of a checkpoint replays the chain from its\n"
+"  base, with disk records in overlays in filename.restored." };
+
+help_t help_migrate = { "Move the running machine to another emulator",
+"MIGrate socket\n"
+"  Sends the machine to an emulator started with --incoming socket,\n"
+"  a unix socket path, with the same devices and storage size.\n"
+"  Storage is sent while the CPUs run, then the pages written\n"
+"  meanwhile, in rounds, so that the CPUs are held only for the last\n"
+"  few pages and the register and device state. Telnet sessions on\n"
+"  AMLC lines are passed over and continue on the destination, which\n"
+"  takes over the ports once this emulator has exited.\n"
+"  Disk files are shared, disk overlays are copied to overlays in\n"
+"  socket.restored. This emulator exits once the destination runs." };
+
+help_t help_dirty = { "Display or reset the written page count",
+"DIRty [RESET | SOFT [ON | OFF]]\n"
+"  Displays the number of 2KB storage pages written since the count\n"
+"  was last reset. RESET starts a new count.\n"
+"  SOFT ON also merges the host soft-dirty bits, which record every\n"
+"  store to storage, where the host kernel supports them." };
+
 help_t help_display = { "Display register or memory content",
 "Display Real [address] [length]\n"
 "  Displays the real storage location at the given address.\n"
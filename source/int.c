@@ -86,15 +86,12 @@ E50I(a1a)
 {
 uint16_t a = G_A(cpu);
 uint16_t r;
-int eq, lt, car, ovf;
+int ovf;
 
   logop1(op, "a1a");
 
-  r = add_w(a, 1, &eq, &lt, &car, &ovf);
+  r = add_w_cc(cpu, a, 1, &ovf);
 
-  cpu->crs->km.eq = eq;
-  cpu->crs->km.lt = lt;
-  cpu->crs->km.link = car;
   cpu->crs->km.cbit = ovf;
  
   S_A(cpu, r);
@@ -114,15 +111,12 @@ E50I(a2a)
 {
 uint16_t a = G_A(cpu);
 uint16_t r;
-int eq, lt, car, ovf;
+int ovf;
 
   logop1(op, "a2a");
 
-  r = add_w(a, 2, &eq, &lt, &car, &ovf);
+  r = add_w_cc(cpu, a, 2, &ovf);
 
-  cpu->crs->km.eq = eq;
-  cpu->crs->km.lt = lt;
-  cpu->crs->km.link = car;
   cpu->crs->km.cbit = ovf;
 
   S_A(cpu, r);
@@ -142,15 +136,12 @@ E50I(aca)
 {
 uint16_t a = G_A(cpu);
 uint16_t r;
-int eq, lt, car, ovf;
+int ovf;
 
   logop1(op, "aca");
 
-  r = add_w(a, cpu->crs->km.cbit ? 1 : 0, &eq, &lt, &car, &ovf);
+  r = add_w_cc(cpu, a, cpu->crs->km.cbit ? 1 : 0, &ovf);
 
-  cpu->crs->km.eq = eq;
-  cpu->crs->km.lt = lt;
-  cpu->crs->km.link = car;
   cpu->crs->km.cbit = ovf;
 
   S_A(cpu, r);
@@ -179,15 +170,12 @@ uint32_t ea = E50X(ea)(cpu, op);
   uint32_t s = E50X(vfetch_d)(cpu, ea);
   uint32_t l = G_L(cpu);
   int32_t r;
-  int eq, lt, car, ovf;
+  int ovf;
 
     logopxoo(op, "dad", ea, (uint32_t)l);
 
-    r = add_d31(l, s, &eq, &lt, &car, &ovf);
+    r = add_d31_cc(cpu, l, s, &ovf);
 
-    cpu->crs->km.eq = eq;
-    cpu->crs->km.lt = lt;
-    cpu->crs->km.link = car;
     cpu->crs->km.cbit = ovf;
 
     S_L(cpu, r);
@@ -201,15 +189,12 @@ uint32_t ea = E50X(ea)(cpu, op);
   uint16_t s = E50X(vfetch_w)(cpu, ea);
   uint16_t a = G_A(cpu);
   uint16_t r;
-  int eq, lt, car, ovf;
+  int ovf;
 
     logopxoo(op, "add", ea, s);
 
-    r = add_w(a, s, &eq, &lt, &car, &ovf);
+    r = add_w_cc(cpu, a, s, &ovf);
 
-    cpu->crs->km.eq = eq;
-    cpu->crs->km.lt = lt;
-    cpu->crs->km.link = car;
     cpu->crs->km.cbit = ovf;
 
     S_A(cpu, r);
@@ -233,15 +218,12 @@ uint32_t ea = E50X(ea)(cpu, op);
 uint32_t s = E50X(vfetch_d)(cpu, ea);
 uint32_t l = G_L(cpu);
 uint32_t r;
-int eq, lt, car, ovf;
+int ovf;
 
   logopxoo(op, "adl", ea, s);
 
-  r = add_d(l, s, &eq, &lt, &car, &ovf);
+  r = add_d_cc(cpu, l, s, &ovf);
 
-  cpu->crs->km.eq = eq;
-  cpu->crs->km.lt = lt;
-  cpu->crs->km.link = car;
   cpu->crs->km.cbit = ovf;
 
   S_L(cpu, r);
@@ -261,15 +243,12 @@ E50I(adll)
 {
 uint32_t l = G_L(cpu);
 uint32_t r;
-int eq, lt, car, ovf;
+int ovf;
 
   logop1(op, "adll");
 
-  r = add_d(l, cpu->crs->km.link ? 1 : 0, &eq, &lt, &car, &ovf);
+  r = add_d_cc(cpu, l, CC_LINK(cpu) ? 1 : 0, &ovf);
 
-  cpu->crs->km.eq = eq;
-  cpu->crs->km.lt = lt;
-  cpu->crs->km.link = car;
   cpu->crs->km.cbit = ovf;
 
   S_L(cpu, r);
@@ -284,15 +263,12 @@ E50I(s1a)
 {
 uint16_t a = G_A(cpu);
 uint16_t r;
-int eq, lt, car, ovf;
+int ovf;
 
   logop1(op, "s1a");
 
-  r = sba_w(a, 1, &eq, &lt, &car, &ovf);
+  r = sba_w_cc(cpu, a, 1, &ovf);
 
-  cpu->crs->km.eq = eq;
-  cpu->crs->km.lt = lt;
-  cpu->crs->km.link = car;
   cpu->crs->km.cbit = ovf;
 
   S_A(cpu, r);
@@ -306,15 +282,12 @@ E50I(s2a)
 {
 uint16_t a = G_A(cpu);
 uint16_t r;
-int eq, lt, car, ovf;
+int ovf;
 
   logop1(op, "s2a");
 
-  r = sba_w(a, 2, &eq, &lt, &car, &ovf);
+  r = sba_w_cc(cpu, a, 2, &ovf);
 
-  cpu->crs->km.eq = eq;
-  cpu->crs->km.lt = lt;
-  cpu->crs->km.link = car;
   cpu->crs->km.cbit = ovf;
 
   S_A(cpu, r);
@@ -328,15 +301,12 @@ E50I(tca)
 {
 uint16_t a = G_A(cpu);
 uint16_t r;
-int eq, lt, car, ovf;
+int ovf;
 
   logop1(op, "tca");
 
-  r = sba_w(0, a, &eq, &lt, &car, &ovf);
+  r = sba_w_cc(cpu, 0, a, &ovf);
 
-  cpu->crs->km.eq = eq;
-  cpu->crs->km.lt = lt;
-  cpu->crs->km.link = car;
   cpu->crs->km.cbit = ovf;
 
   S_A(cpu, r);
@@ -350,15 +320,12 @@ E50I(tcl)
 {
 uint32_t l = G_L(cpu);
 uint32_t r;
-int eq, lt, car, ovf;
+int ovf;
 
   logop1(op, "tcl");
 
-  r = sba_d(0, l, &eq, &lt, &car, &ovf);
+  r = sba_d_cc(cpu, 0, l, &ovf);
 
-  cpu->crs->km.eq = eq;
-  cpu->crs->km.lt = lt;
-  cpu->crs->km.link = car;
   cpu->crs->km.cbit = ovf;
 
   S_L(cpu, r);
@@ -401,15 +368,12 @@ uint32_t ea = E50X(ea)(cpu, op);
   uint32_t s = E50X(vfetch_d)(cpu, ea);
   uint32_t l = G_L(cpu);
   uint32_t r;
-  int eq, lt, car, ovf;
+  int ovf;
 
     logopxoo(op, "dsb", ea, (uint32_t)l);
 
-    r = sba_d31(l, s, &eq, &lt, &car, &ovf);
+    r = sba_d31_cc(cpu, l, s, &ovf);
 
-    cpu->crs->km.eq = eq;
-    cpu->crs->km.lt = lt;
-    cpu->crs->km.link = car;
     cpu->crs->km.cbit = ovf;
 
     S_L(cpu, r);
@@ -423,15 +387,12 @@ uint32_t ea = E50X(ea)(cpu, op);
   uint16_t s = E50X(vfetch_w)(cpu, ea);
   uint16_t a = G_A(cpu);
   uint16_t r;
-  int eq, lt, car, ovf;
+  int ovf;
 
     logopxoo(op, "sub", ea, s);
 
-    r = sba_w(a, s, &eq, &lt, &car, &ovf);
+    r = sba_w_cc(cpu, a, s, &ovf);
 
-    cpu->crs->km.eq = eq;
-    cpu->crs->km.lt = lt;
-    cpu->crs->km.link = car;
     cpu->crs->km.cbit = ovf;
 
     S_A(cpu, r);
@@ -448,15 +409,12 @@ uint32_t ea = E50X(ea)(cpu, op);
 uint32_t s = E50X(vfetch_d)(cpu, ea);
 uint32_t l = G_L(cpu);
 uint32_t r;
-int eq, lt, car, ovf;
+int ovf;
 
   logopxoo(op, "sbl", ea, s);
 
-  r = sba_d(l, s, &eq, &lt, &car, &ovf);
+  r = sba_d_cc(cpu, l, s, &ovf);
 
-  cpu->crs->km.eq = eq;
-  cpu->crs->km.lt = lt;
-  cpu->crs->km.link = car;
   cpu->crs->km.cbit = ovf;
 
   S_L(cpu, r);
@@ -716,15 +674,12 @@ E50I(a)
 int dr = op_dr(op);
 uint32_t r = G_R(cpu, dr);
 uint32_t v = E50X(efetch_d)(cpu, op);
-int eq, lt, car, ovf;
+int ovf;
 
   logop2o3(op, "a", dr, r, v);
 
-  int32_t d = add_d(r, v, &eq, &lt, &car, &ovf);
+  int32_t d = add_d_cc(cpu, r, v, &ovf);
 
-  cpu->crs->km.eq = eq;
-  cpu->crs->km.lt = lt;
-  cpu->crs->km.link = car;
   cpu->crs->km.cbit = ovf;
  
   S_R(cpu, dr, d);
@@ -740,15 +695,12 @@ E50I(adlr)
 {
 int dr = op_dr(op);
 uint32_t r = G_R(cpu, dr);
-int eq, lt, car, ovf;
+int ovf;
 
   logop2oo(op, "adlr", dr, r);
 
-  uint32_t d = add_d(r, cpu->crs->km.link ? 1 : 0, &eq, &lt, &car, &ovf);
+  uint32_t d = add_d_cc(cpu, r, CC_LINK(cpu) ? 1 : 0, &ovf);
 
-  cpu->crs->km.eq = eq;
-  cpu->crs->km.lt = lt;
-  cpu->crs->km.link = car;
   cpu->crs->km.cbit = ovf;
  
   S_R(cpu, dr, d);
@@ -765,15 +717,12 @@ E50I(ah)
 int dr = op_dr(op);
 uint16_t r = G_RH(cpu, dr);
 uint16_t v = E50X(efetch_w)(cpu, op);
-int eq, lt, car, ovf;
+int ovf;
 
   logop2o3(op, "ah", dr, r, v);
 
-  uint16_t h = add_w(r, v, &eq, &lt, &car, &ovf);
+  uint16_t h = add_w_cc(cpu, r, v, &ovf);
 
-  cpu->crs->km.eq = eq;
-  cpu->crs->km.lt = lt;
-  cpu->crs->km.link = car;
   cpu->crs->km.cbit = ovf;
  
   S_RH(cpu, dr, h);
@@ -793,12 +742,7 @@ uint32_t v = E50X(efetch_d)(cpu, op);
 
   logop2oo(op, "c", dr, v);
 
-  int eq, lt, car;
-  sba_d(r, v, &eq, &lt, &car, NULL);
-
-  cpu->crs->km.eq = eq;
-  cpu->crs->km.lt = lt;
-  cpu->crs->km.link = car;
+  sba_d_cc(cpu, r, v, NULL);
 }
 #endif
 
@@ -812,12 +756,7 @@ uint16_t v = E50X(efetch_w)(cpu, op);
 
   logop2oo(op, "ch", dr, v);
 
-  int eq, lt, car;
-  sba_w(r, v, &eq, &lt, &car, NULL);
-
-  cpu->crs->km.eq = eq;
-  cpu->crs->km.lt = lt;
-  cpu->crs->km.link = car;
+  sba_w_cc(cpu, r, v, NULL);
 }
 #endif
 
@@ -894,15 +833,12 @@ E50I(dh1)
 {
 int dr = op_dr(op);
 uint16_t r = G_RH(cpu, dr);
-int eq, lt, car, ovf;
+int ovf;
 
   logop1oo(op, "dh1", dr, r);
 
-  uint16_t h = sba_w(r, 1, &eq, &lt, &car, &ovf);
+  uint16_t h = sba_w_cc(cpu, r, 1, &ovf);
 
-  cpu->crs->km.eq = eq;
-  cpu->crs->km.lt = lt;
-  cpu->crs->km.link = car;
   cpu->crs->km.cbit = ovf;
 
   S_RH(cpu, dr, h);
@@ -918,15 +854,12 @@ E50I(dh2)
 {
 int dr = op_dr(op);
 uint16_t r = G_RH(cpu, dr);
-int eq, lt, car, ovf;
+int ovf;
 
   logop1oo(op, "dh2", dr, r);
 
-  uint16_t h = sba_w(r, 2, &eq, &lt, &car, &ovf);
+  uint16_t h = sba_w_cc(cpu, r, 2, &ovf);
 
-  cpu->crs->km.eq = eq;
-  cpu->crs->km.lt = lt;
-  cpu->crs->km.link = car;
   cpu->crs->km.cbit = ovf;
 
   S_RH(cpu, dr, h);
@@ -942,15 +875,12 @@ E50I(dr1)
 {
 int dr = op_dr(op);
 int32_t r = G_R(cpu, dr);
-int eq, lt, car, ovf;
+int ovf;
 
   logop1oo(op, "dr1", dr, r);
 
-  int32_t h = sba_d(r, 1, &eq, &lt, &car, &ovf);
+  int32_t h = sba_d_cc(cpu, r, 1, &ovf);
 
-  cpu->crs->km.eq = eq;
-  cpu->crs->km.lt = lt;
-  cpu->crs->km.link = car;
   cpu->crs->km.cbit = ovf;
 
   S_R(cpu, dr, h);
@@ -966,15 +896,12 @@ E50I(dr2)
 {
 int dr = op_dr(op);
 uint32_t r = G_R(cpu, dr);
-int eq, lt, car, ovf;
+int ovf;
 
   logop1oo(op, "dr2", dr, r);
 
-  uint32_t h = sba_d(r, 2, &eq, &lt, &car, &ovf);
+  uint32_t h = sba_d_cc(cpu, r, 2, &ovf);
 
-  cpu->crs->km.eq = eq;
-  cpu->crs->km.lt = lt;
-  cpu->crs->km.link = car;
   cpu->crs->km.cbit = ovf;
 
   S_R(cpu, dr, h);
@@ -997,6 +924,7 @@ int eq, lt;
 
   E50X(estore_dx)(cpu, op, r, 0);
 
+  cc_sync(cpu);
   cpu->crs->km.eq = eq;
   cpu->crs->km.lt = lt;
 }
@@ -1015,6 +943,7 @@ int eq, lt;
 
   E50X(estore_wx)(cpu, op, r, 0);
 
+  cc_sync(cpu);
   cpu->crs->km.eq = eq;
   cpu->crs->km.lt = lt;
 }
@@ -1026,15 +955,12 @@ E50I(ih1)
 {
 int dr = op_dr(op);
 uint16_t r = G_RH(cpu, dr);
-int eq, lt, car, ovf;
+int ovf;
 
   logop1oo(op, "ih1", dr ,r);
 
-  uint16_t h = add_w(r, 1, &eq, &lt, &car, &ovf);
+  uint16_t h = add_w_cc(cpu, r, 1, &ovf);
 
-  cpu->crs->km.eq = eq;
-  cpu->crs->km.lt = lt;
-  cpu->crs->km.link = car;
   cpu->crs->km.cbit = ovf;
 
   S_RH(cpu, dr, h);
@@ -1050,15 +976,12 @@ E50I(ih2)
 {
 int dr = op_dr(op);
 uint16_t r = G_RH(cpu, dr);
-int eq, lt, car, ovf;
+int ovf;
 
   logop1oo(op, "ih2", dr, r);
 
-  uint16_t h = add_w(r, 2, &eq, &lt, &car, &ovf);
+  uint16_t h = add_w_cc(cpu, r, 2, &ovf);
 
-  cpu->crs->km.eq = eq;
-  cpu->crs->km.lt = lt;
-  cpu->crs->km.link = car;
   cpu->crs->km.cbit = ovf;
 
   S_RH(cpu, dr, h);
@@ -1074,15 +997,12 @@ E50I(ir1)
 {
 int dr = op_dr(op);
 uint32_t r = G_R(cpu, dr);
-int eq, lt, car, ovf;
+int ovf;
 
   logop1oo(op, "ir1", dr, r);
 
-  uint32_t d = add_d(r, 1, &eq, &lt, &car, &ovf);
+  uint32_t d = add_d_cc(cpu, r, 1, &ovf);
 
-  cpu->crs->km.eq = eq;
-  cpu->crs->km.lt = lt;
-  cpu->crs->km.link = car;
   cpu->crs->km.cbit = ovf;
 
   S_R(cpu, dr, d);
@@ -1098,15 +1018,12 @@ E50I(ir2)
 {
 int dr = op_dr(op);
 uint32_t r = G_R(cpu, dr);
-int eq, lt, car, ovf;
+int ovf;
 
   logop1oo(op, "ir2", dr, r);
 
-  uint32_t d = add_d(r, 2, &eq, &lt, &car, &ovf);
+  uint32_t d = add_d_cc(cpu, r, 2, &ovf);
 
-  cpu->crs->km.eq = eq;
-  cpu->crs->km.lt = lt;
-  cpu->crs->km.link = car;
   cpu->crs->km.cbit = ovf;
 
   S_R(cpu, dr, d);
@@ -1129,6 +1046,7 @@ int eq, lt;
 
   E50X(estore_dx)(cpu, op, r, 0);
 
+  cc_sync(cpu);
   cpu->crs->km.eq = eq;
   cpu->crs->km.lt = lt;
 }
@@ -1147,6 +1065,7 @@ int eq, lt;
 
   E50X(estore_wx)(cpu, op, r, 0);
 
+  cc_sync(cpu);
   cpu->crs->km.eq = eq;
   cpu->crs->km.lt = lt;
 }
@@ -1272,15 +1191,12 @@ E50I(s)
 int dr = op_dr(op);
 uint32_t r = G_R(cpu, dr);
 uint32_t v = E50X(efetch_d)(cpu, op);
-int eq, lt, car, ovf;
+int ovf;
 
   logop2o3(op, "s", dr, r, v);
 
-  uint32_t d = sba_d(r, v, &eq, &lt, &car, &ovf);
+  uint32_t d = sba_d_cc(cpu, r, v, &ovf);
 
-  cpu->crs->km.eq = eq;
-  cpu->crs->km.lt = lt;
-  cpu->crs->km.link = car;
   cpu->crs->km.cbit = ovf;
  
   S_R(cpu, dr, d);
@@ -1297,15 +1213,12 @@ E50I(sh)
 int dr = op_dr(op);
 uint16_t r = G_RH(cpu, dr);
 uint16_t v = E50X(efetch_w)(cpu, op);
-int eq, lt, car, ovf;
+int ovf;
 
   logop2o3(op, "sh", dr, r, v);
 
-  uint16_t h = sba_w(r, v, &eq, &lt, &car, &ovf);
+  uint16_t h = sba_w_cc(cpu, r, v, &ovf);
 
-  cpu->crs->km.eq = eq;
-  cpu->crs->km.lt = lt;
-  cpu->crs->km.link = car;
   cpu->crs->km.cbit = ovf;
  
   S_RH(cpu, dr, h);
@@ -1321,15 +1234,12 @@ E50I(tc)
 {
 int dr = op_dr(op);
 uint32_t r = G_R(cpu, dr);
-int eq, lt, car, ovf;
+int ovf;
 
   logop1oo(op, "tc", dr, r);
 
-  r = sba_d(0, r, &eq, &lt, &car, &ovf);
+  r = sba_d_cc(cpu, 0, r, &ovf);
 
-  cpu->crs->km.eq = eq;
-  cpu->crs->km.lt = lt;
-  cpu->crs->km.link = car;
   cpu->crs->km.cbit = ovf;
 
   S_R(cpu, dr, r);
@@ -1345,15 +1255,12 @@ E50I(tch)
 {
 int dr = op_dr(op);
 uint16_t r = G_RH(cpu, dr);
-int eq, lt, car, ovf;
+int ovf;
 
   logop1oo(op, "tch", dr, r);
 
-  r = sba_w(0, r, &eq, &lt, &car, &ovf);
+  r = sba_w_cc(cpu, 0, r, &ovf);
 
-  cpu->crs->km.eq = eq;
-  cpu->crs->km.lt = lt;
-  cpu->crs->km.link = car;
   cpu->crs->km.cbit = ovf;
 
   S_RH(cpu, dr, r);
@@ -1373,6 +1280,7 @@ int32_t r = E50X(efetch_d)(cpu, op);
 
   int eq, lt;
   sba_d(r, 0, &eq, &lt, NULL, NULL);
+  cc_sync(cpu);
   cpu->crs->km.eq = eq;
   cpu->crs->km.lt = lt;
 }
@@ -1388,6 +1296,7 @@ int16_t r = E50X(efetch_w)(cpu, op);
 
   int eq, lt;
   sba_w(r, 0, &eq, &lt, NULL, NULL);
+  cc_sync(cpu);
   cpu->crs->km.eq = eq;
   cpu->crs->km.lt = lt;
 }
@@ -127,6 +127,61 @@ static inline uint32_t sba_d31(uint32_t a, uint32_t b, int *eq, int *lt, int *ca
   return fr31h(sba_d(to31h(a), to31h(b), eq, lt, car, ovf));
 }
 
+/* As above, but EQ, LT and LINK are left to be evaluated lazily from
+ * the operands and result, only the overflow (CBIT) is returned
+ */
+static inline uint16_t _add_w_cc(cpu_t *cpu, uint16_t a, uint16_t b, uint16_t c, int *ovf)
+{
+  uint16_t r = a + b + c;
+
+  CC_LAZY(cpu, a, b, r, 0x8000);
+  if(ovf)
+    *ovf = (((~a ^ b) & (a ^ r) & 0x8000) >> 15) & 1;
+
+  return r;
+}
+
+static inline uint16_t add_w_cc(cpu_t *cpu, uint16_t a, uint16_t b, int *ovf)
+{
+  return _add_w_cc(cpu, a, b, 0, ovf);
+}
+
+static inline uint16_t sba_w_cc(cpu_t *cpu, uint16_t a, uint16_t b, int *ovf)
+{
+  return _add_w_cc(cpu, a, ~b, 1, ovf);
+}
+
+static inline uint32_t _add_d_cc(cpu_t *cpu, uint32_t a, uint32_t b, uint32_t c, int *ovf)
+{
+  uint32_t r = a + b + c;
+
+  CC_LAZY(cpu, a, b, r, 0x80000000);
+  if(ovf)
+    *ovf = (((~a ^ b) & (a ^ r) & 0x80000000) >> 31) & 1;
+
+  return r;
+}
+
+static inline uint32_t add_d_cc(cpu_t *cpu, uint32_t a, uint32_t b, int *ovf)
+{
+  return _add_d_cc(cpu, a, b, 0, ovf);
+}
+
+static inline uint32_t sba_d_cc(cpu_t *cpu, uint32_t a, uint32_t b, int *ovf)
+{
+  return _add_d_cc(cpu, a, ~b, 1, ovf);
+}
+
+static inline uint32_t add_d31_cc(cpu_t *cpu, uint32_t a, uint32_t b, int *ovf)
+{
+  return fr31h(add_d_cc(cpu, to31h(a), to31h(b), ovf));
+}
+
+static inline uint32_t sba_d31_cc(cpu_t *cpu, uint32_t a, uint32_t b, int *ovf)
+{
+  return fr31h(sba_d_cc(cpu, to31h(a), to31h(b), ovf));
+}
+
 #endif
 
 E50I(dbl);
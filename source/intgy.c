@@ -43,7 +43,7 @@ E50I(rmc)
 
   cpu->crs->km.mcm = km_mcn;
 
-  longjmp(cpu->endop, endop_nointr1);
+  ENDOP(cpu, endop_nointr1);
 }
 
 
@@ -65,7 +65,7 @@ E50I(lmcm)
 
   cpu->crs->km.mcm = km_mcn;
 
-  longjmp(cpu->endop, endop_nointr1);
+  ENDOP(cpu, endop_nointr1);
 }
 
 
@@ -45,6 +45,8 @@
 
 #include "prcex.h"
 
+#include "snap.h"
+
 
 #if 0
 #undef logmsg
@@ -121,7 +123,6 @@ static const ioop_t device[0100] = {
 /*076*/ NULL,                    /*      Reserved */
 /*077*/ NULL                     /*      IO Bus tester */
 };
-static void *devparm[sizeof(device)/sizeof(*device)] = { NULL };
 
 static const int ndevices = sizeof(device)/sizeof(*device);
 
@@ -138,14 +139,14 @@ void io_reset(cpu_t *cpu)
 {
   for(int ctrl = 0; ctrl < ndevices; ++ctrl)
     if(device[ctrl])
-      device[ctrl](cpu, IO_TYPE_INI, 0, 0, ctrl, &devparm[ctrl], 0, NULL);
+      device[ctrl](cpu, IO_TYPE_INI, 0, 0, ctrl, &cpu->sys->devparm[ctrl], 0, NULL);
 }
 
 
 static inline int io_execcmd(cpu_t *cpu, int cmd, int ctrl, int unit, int argc, char *argv[])
 {
-  if(devparm[ctrl])
-    return device[ctrl](cpu, cmd, unit, 0, ctrl, &devparm[ctrl], argc, argv);
+  if(cpu->sys->devparm[ctrl])
+    return device[ctrl](cpu, cmd, unit, 0, ctrl, &cpu->sys->devparm[ctrl], argc, argv);
   else
     return 0;
 }
@@ -163,6 +164,37 @@ int io_load(cpu_t *cpu, int ctrl, int unit)
   return io_execcmd(cpu, IO_TYPE_IPL, ctrl, unit, 0, NULL);
 }
 
+
+void io_snap(cpu_t *cpu, snap_t *s)
+{
+  for(int ctrl = 0; ctrl < ndevices; ++ctrl)
+    if(cpu->sys->devparm[ctrl])
+    {
+      snap_tag(s, "DEV ", ctrl);
+      device[ctrl](cpu, IO_TYPE_SNP, 0, 0, ctrl, &cpu->sys->devparm[ctrl], 0, (char **)s);
+    }
+}
+
+
+/* Disk and tape transfers run on their own threads, those are held
+ * at the next order or motion so that storage and device state stay
+ * as they are while the CPUs are stopped
+ */
+void io_hold(cpu_t *cpu, bool hold)
+{
+  for(int ctrl = 0; ctrl < ndevices; ++ctrl)
+    if((device[ctrl] == disk_io || device[ctrl] == tape_io) && cpu->sys->devparm[ctrl])
+      device[ctrl](cpu, IO_TYPE_HLD, 0, 0, ctrl, &cpu->sys->devparm[ctrl], hold, NULL);
+}
+
+
+void io_overlay(cpu_t *cpu)
+{
+  for(int ctrl = 0; ctrl < ndevices; ++ctrl)
+    if(device[ctrl] == disk_io && cpu->sys->devparm[ctrl])
+      disk_io(cpu, IO_TYPE_OVL, 0, 0, ctrl, &cpu->sys->devparm[ctrl], 0, NULL);
+}
+
 #endif
 
 
@@ -181,13 +213,15 @@ int ctrl = io_ctrl(ea);
   logmsg("-> %s ext %o func %o ctrl %o\n", 
     io_type_c[io_type(ea)], io_ext(ea), io_func(ea), io_ctrl(ea));
 
-  if(devparm[ctrl])
+  if(cpu->sys->devparm[ctrl])
   {
-    cpu->crs->km.eq = device[ctrl](cpu, type, ext, func, ctrl, &devparm[ctrl], 0, NULL);
+    cc_sync(cpu);
+    cpu->crs->km.eq = device[ctrl](cpu, type, ext, func, ctrl, &cpu->sys->devparm[ctrl], 0, NULL);
   }
   else
   {
     logall("ctrl %03o invalid\n", ctrl);
+    cc_sync(cpu);
     cpu->crs->km.eq = 0;
   }
 
@@ -207,9 +241,9 @@ int skip = 0;
 
 logmsg("pio %s 0%o 0%o\n", io_type_c[type], func, ctrl);
 
-  if(devparm[ctrl])
+  if(cpu->sys->devparm[ctrl])
   {
-    skip = device[ctrl](cpu, type, 0, func, ctrl, &devparm[ctrl], 0, NULL);
+    skip = device[ctrl](cpu, type, 0, func, ctrl, &cpu->sys->devparm[ctrl], 0, NULL);
   }
   else
   {
@@ -304,7 +338,7 @@ E50I(enb)
 
   cpu->crs->km.ie = 1;
 
-  longjmp(cpu->endop, endop_nointr1);
+  ENDOP(cpu, endop_nointr1);
 }
 
 
@@ -316,7 +350,7 @@ E50I(enbm)
 
   cpu->crs->km.ie = 1;
 
-  longjmp(cpu->endop, endop_nointr1);
+  ENDOP(cpu, endop_nointr1);
 }
 
 
@@ -328,7 +362,7 @@ E50I(enbp)
 
   cpu->crs->km.ie = 1;
 
-  longjmp(cpu->endop, endop_nointr1);
+  ENDOP(cpu, endop_nointr1);
 }
 
 
@@ -340,7 +374,7 @@ E50I(esim)
 
   cpu->crs->km.vim = 0;
 
-  longjmp(cpu->endop, endop_nointr1);
+  ENDOP(cpu, endop_nointr1);
 }
 
 
@@ -352,7 +386,7 @@ E50I(evim)
 
   cpu->crs->km.vim = 1;
 
-  longjmp(cpu->endop, endop_nointr1);
+  ENDOP(cpu, endop_nointr1);
 }
 
 
@@ -365,7 +399,7 @@ E50I(cai)
   if(cpu->crs->km.vim)
   {
     io_clrai(cpu);
-    longjmp(cpu->endop, endop_nointr1);
+    ENDOP(cpu, endop_nointr1);
   }
 }
 
@@ -376,14 +410,23 @@ int32_t c2r(cpu_t *cpu, uint32_t vaddr)
   return i2r(cpu, vaddr);
 }
 
+uint8_t *c2h(cpu_t *cpu, uint32_t vaddr)
+{
+  return i2h(cpu, vaddr);
+}
+
 void istore_w(cpu_t *cpu, uint32_t vaddr, uint16_t val)
 {
-  int32_t raddr = i2r(cpu, vaddr);
+  uint8_t *h = i2h(cpu, vaddr);
 
-  if(raddr >= 0)
-    store_w(physad(cpu, raddr), val);
+  if(h)
+  {
+    store_w(h, val);
+    ic_dma(cpu, h2r(cpu, h), 1);
+    dirty_mark(cpu, h2r(cpu, h));
+  }
 
-  logmsg("istore_w %8.8x %8.8x %4.4x\n", vaddr, raddr, val);
+  logmsg("istore_w %8.8x %8.8x %4.4x\n", vaddr, h ? h2r(cpu, h) : -1, val);
 }
 
 
@@ -396,22 +439,26 @@ void istore_d(cpu_t *cpu, uint32_t vaddr, uint32_t val)
       return;
   }
 
-  int32_t raddr = i2r(cpu, vaddr);
+  uint8_t *h = i2h(cpu, vaddr);
 
-  if(raddr >= 0)
-    store_d(physad(cpu, raddr), val);
+  if(h)
+  {
+    store_d(h, val);
+    ic_dma(cpu, h2r(cpu, h), 2);
+    dirty_mark(cpu, h2r(cpu, h));
+  }
 
-  logmsg("istore_d %8.8x %8.8x %8.8x\n", vaddr, raddr, val);
+  logmsg("istore_d %8.8x %8.8x %8.8x\n", vaddr, h ? h2r(cpu, h) : -1, val);
 }
 
 
 uint16_t ifetch_w(cpu_t *cpu, uint32_t vaddr)
 {
-  int32_t raddr = i2r(cpu, vaddr);
+  uint8_t *h = i2h(cpu, vaddr);
 
-  logmsg("ifetch_w %8.8x %8.8x %4.4x\n", vaddr, raddr, fetch_w(physad(cpu, vaddr)));
+  logmsg("ifetch_w %8.8x %8.8x %4.4x\n", vaddr, h ? h2r(cpu, h) : -1, h ? fetch_w(h) : 0);
 
-  return (raddr >= 0) ? fetch_w(physad(cpu, raddr)) : 0;
+  return h ? fetch_w(h) : 0;
 }
 
 
@@ -422,11 +469,11 @@ uint32_t ifetch_d(cpu_t *cpu, uint32_t vaddr)
       return (ifetch_w(cpu, vaddr) << 16) | ifetch_w(cpu, vaddr + 1);
   }
 
-  int32_t raddr = i2r(cpu, vaddr);
+  uint8_t *h = i2h(cpu, vaddr);
 
-  logmsg("ifetch_d %8.8x %8.8x %8.8x\n", vaddr, raddr, fetch_w(physad(cpu, vaddr)));
+  logmsg("ifetch_d %8.8x %8.8x %8.8x\n", vaddr, h ? h2r(cpu, h) : -1, h ? fetch_d(h) : 0);
 
-  return (raddr >= 0) ? fetch_d(physad(cpu, raddr)) : 0;
+  return h ? fetch_d(h) : 0;
 }
 
 #endif
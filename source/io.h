@@ -34,6 +34,10 @@
 void io_reset(cpu_t *);
 int  io_assign(cpu_t *, int, int, int, char *[]);
 int  io_load(cpu_t *, int, int);
+struct snap_t;
+void io_snap(cpu_t *, struct snap_t *);
+void io_hold(cpu_t *, bool);
+void io_overlay(cpu_t *);
 
 #define IO_DMX_DMC 0x0800
 #define IO_DMA_MSK 0x001F
@@ -51,27 +55,45 @@ uint32_t ifetch_d(cpu_t *, uint32_t);
 void istore_w(cpu_t *, uint32_t, uint16_t);
 void istore_d(cpu_t *, uint32_t, uint32_t);
 int32_t c2r(cpu_t *, uint32_t);
+uint8_t *c2h(cpu_t *, uint32_t);
 
 typedef struct intr_t {
   volatile int      i;
   volatile uint16_t v;
 } intr_t;
 
+/* Interrupt queue
+ *
+ * Multi producer single consumer ring, device threads reserve a
+ * position by incrementing n, store the vector and then publish the
+ * slot by setting its sequence to position + 1.  The CPU takes the
+ * slot at position a once it is published and frees it for position
+ * a + INTR_QSIZE.  The vector stays in the slot until cleared, so
+ * that io_tstint can detect an interrupt that is already queued or
+ * active.
+ */
 static inline void io_intr_init(cpu_t *cpu)
 {
   pthread_mutex_init(&cpu->intr.mutex, NULL);
 #if defined(IDLE_WAIT)
   pthread_cond_init(&cpu->intr.cond, NULL);
+  atomic_init(&cpu->intr.idle, 0);
 #endif
-  cpu->intr.a = cpu->intr.n = 0;
+  cpu->intr.a = 0;
+  atomic_init(&cpu->intr.n, 0);
   for(int n = 0; n < INTR_QSIZE; ++n)
-    cpu->intr.v[n] = -1;
+  {
+    atomic_init(&cpu->intr.v[n], -1);
+    atomic_init(&cpu->intr.s[n], n);
+  }
   cpu->intr.c = -1;
+  atomic_init(&cpu->intr.attn, 0);
+  cpu->intr.burst = INTR_BURST_MIN;
 }
 
 static inline int io_pending(cpu_t *cpu)
 {
-  return cpu->intr.a != cpu->intr.n;
+  return cpu->intr.a != atomic_load_explicit(&cpu->intr.n, memory_order_relaxed);
 }
 
 #if defined(IDLE_WAIT)
@@ -83,14 +105,21 @@ static inline int io_idle_wait(cpu_t *cpu, int val)
   ts.tv_sec  += ts.tv_nsec / 1000000000ULL;
   ts.tv_nsec %= 1000000000ULL;
   pthread_mutex_lock(&cpu->intr.mutex);
-  int rc = io_pending(cpu) ? 0 : pthread_cond_timedwait(&cpu->intr.cond, &cpu->intr.mutex, &ts);
+  atomic_store(&cpu->intr.idle, 1);
+  int rc = (cpu->intr.a != atomic_load(&cpu->intr.n)) ? 0 : pthread_cond_timedwait(&cpu->intr.cond, &cpu->intr.mutex, &ts);
+  atomic_store(&cpu->intr.idle, 0);
   pthread_mutex_unlock(&cpu->intr.mutex);
   return rc != ETIMEDOUT;
 }
 
 static inline void io_idle_post(cpu_t *cpu)
 {
+  if(!atomic_load(&cpu->intr.idle))
+    return;
+
+  pthread_mutex_lock(&cpu->intr.mutex);
   pthread_cond_broadcast(&cpu->intr.cond);
+  pthread_mutex_unlock(&cpu->intr.mutex);
 }
 #endif
 
@@ -117,19 +146,9 @@ static uint16_t slot = num_fixed_slots;
   return io_devslot(devid, slot++);
 }
 
-static inline int io_incrnxt(int i)
-{
-  return (i + 1) & INTR_QMASK;
-}
-
-static inline int io_incrint(volatile int *i)
-{
-  return (*i = io_incrnxt(*i));
-}
-
 static inline int io_tstint(cpu_t *cpu, intr_t *intr)
 {
-  return intr->i >= 0 && intr->v == cpu->intr.v[intr->i];
+  return intr->i >= 0 && intr->v == atomic_load(&cpu->intr.v[intr->i]);
 }
 
 static inline void io_setintv(cpu_t *cpu, intr_t *intr, uint16_t v)
@@ -137,39 +156,45 @@ static inline void io_setintv(cpu_t *cpu, intr_t *intr, uint16_t v)
   if(io_tstint(cpu, intr))
     return;
 
-  pthread_mutex_lock(&cpu->intr.mutex);
-  int n = io_incrint(&cpu->intr.n);
-  cpu->intr.v[n] = v;
+  unsigned p = atomic_fetch_add(&cpu->intr.n, 1);
+  int n = p & INTR_QMASK;
+  while(atomic_load_explicit(&cpu->intr.s[n], memory_order_acquire) != p)
+    sched_yield(); // Queue full
+  atomic_store_explicit(&cpu->intr.v[n], v, memory_order_relaxed);
   intr->i = n;
   intr->v = v;
+  atomic_store_explicit(&cpu->intr.s[n], p + 1, memory_order_release);
+  atomic_store_explicit(&cpu->intr.attn, 1, memory_order_release);
 #if defined(IDLE_WAIT)
   io_idle_post(cpu);
 #endif
-  pthread_mutex_unlock(&cpu->intr.mutex);
 logall("\nsetint v %4.4x i %d (%d)\n", intr->v, n, intr->i);
 }
 
 static inline int32_t io_intvec(cpu_t *cpu)
 {
 int32_t r = -1;
-int a;
-
-  if(pthread_mutex_trylock(&cpu->intr.mutex))
-    return -1;
+int a = -1;
 
   while(io_pending(cpu))
   {
-        a = io_incrint(&cpu->intr.a);
+    unsigned p = cpu->intr.a;
+    a = p & INTR_QMASK;
 
-    if(cpu->intr.v[a] >= 0)
+    if(atomic_load_explicit(&cpu->intr.s[a], memory_order_acquire) != p + 1)
+      break; // Reserved but not yet published
+
+    int32_t v = atomic_load_explicit(&cpu->intr.v[a], memory_order_relaxed);
+    cpu->intr.a = p + 1;
+    atomic_store_explicit(&cpu->intr.s[a], p + INTR_QSIZE, memory_order_release);
+
+    if(v >= 0)
     {
-      r = cpu->intr.c = cpu->intr.v[a];
+      r = cpu->intr.c = v;
       break;
     }
   }
 
-  pthread_mutex_unlock(&cpu->intr.mutex);
-
 logall("\nintvec v %4.4x [%d]\n", r, a);
 
   return r;
@@ -177,13 +202,15 @@ logall("\nintvec v %4.4x [%d]\n", r, a);
 
 static inline int io_clrint(cpu_t *cpu, intr_t *intr)
 {
-int rc;
+int rc = 0;
 logall("\nclrint v %4.4x i %d\n", intr->v, intr->i);
-  if(io_tstint(cpu, intr))
-    rc = cpu->intr.v[intr->i] = -1;
-  else
-    rc = 0;
-  
+  if(intr->i >= 0)
+  {
+    int v = intr->v;
+    if(atomic_compare_exchange_strong(&cpu->intr.v[intr->i], &v, -1))
+      rc = -1;
+  }
+
   intr->i = -1;
 
   return rc;
@@ -191,11 +218,12 @@ logall("\nclrint v %4.4x i %d\n", intr->v, intr->i);
 
 static inline void io_clrai(cpu_t *cpu)
 {
-logall("\nclrai v %4.4x i %d\n", cpu->intr.v[cpu->intr.a], cpu->intr.a);
+int a = (cpu->intr.a - 1) & INTR_QMASK;
+logall("\nclrai v %4.4x i %d\n", atomic_load(&cpu->intr.v[a]), a);
   if(cpu->intr.c >= 0)
   {
-    cpu->intr.c = cpu->intr.v[cpu->intr.a] = -1;
-//  io_incrint(&cpu->intr.a);
+    cpu->intr.c = -1;
+    atomic_store(&cpu->intr.v[a], -1);
   }
 }
 
@@ -314,9 +342,12 @@ static inline int cpload(cpu_t *cpu, char *fn)
   uint8_t *load = physad(cpu, from_be_16(cphdr.sa));
 
   read(fd, load, (1+from_be_16(cphdr.ea)-from_be_16(cphdr.sa))<<1);
+  dirty_range(cpu, from_be_16(cphdr.sa), 1+from_be_16(cphdr.ea)-from_be_16(cphdr.sa));
 
   close(fd);
 
+  ic_purge(cpu);
+
   S_RB(cpu, from_be_16(cphdr.pc));
   S_A(cpu, from_be_16(cphdr.a));
   S_B(cpu, from_be_16(cphdr.b));
@@ -344,5 +375,8 @@ static inline int cpboot(cpu_t *cpu)
 #define IO_TYPE_CLS 5
 #define IO_TYPE_IPL 6
 #define IO_TYPE_ASN 7
+#define IO_TYPE_SNP 8  // Save or restore device state, argv is the snap_t
+#define IO_TYPE_OVL 9  // Move disk writes to overlays in sys->overlay
+#define IO_TYPE_HLD 10 // Hold (argc 1) or release (argc 0) transfers to storage
 
 #endif
@@ -40,6 +40,7 @@ E50I(ink)
 {
   logop1(op, "ink");
 
+  cc_sync(cpu);
   km_t km = cpu->crs->km;
   km.vsc = G_VSC(cpu);
   S_A(cpu, km.keys);
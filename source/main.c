@@ -32,6 +32,12 @@
 
 #include "cmd.h"
 
+#include "io.h"
+
+#include "sysc.h"
+
+#include "snap.h"
+
 #define RCFILE "%s/rc"
 
 int main(int argc, char *argv[], char **envp)
@@ -44,6 +50,10 @@ static const char short_options[] =
    "l:"
    "i:"
    "o:"
+   "r:"
+   "O:"
+   "I:"
+   "d"
 #ifdef DEBUG
    "v"
 #endif
@@ -57,6 +67,10 @@ static const struct option long_options[] = {
   {"port",                    1, 0, 'l'},
   {"pncbind",                 1, 0, 'i'},
   {"pncport",                 1, 0, 'o'},
+  {"restore",                 1, 0, 'r'},
+  {"overlay",                 1, 0, 'O'},
+  {"incoming",                1, 0, 'I'},
+  {"detach",                  0, 0, 'd'},
 #ifdef DEBUG
   {"verbose",                 2, 0, 'v'},
 #endif
@@ -65,8 +79,9 @@ static const struct option long_options[] = {
 };
 
 char c;
+int incfd = -1;
 
-sys_t sys = { .physsize = physsize_default, .hdir = hdir_default,
+sys_t sys = { .progname = argv[0], .physsize = physsize_default, .hdir = hdir_default,
               .serial = { 'F', 'N', ' ', ' ', ' ', ' ', ' ', ' ', '0', '1', '2', '3', '4', '5', ' ', ' ' } };
 
   while((c = getopt_long(argc, argv, short_options, long_options, NULL)) != (char)-1)
@@ -102,6 +117,33 @@ sys_t sys = { .physsize = physsize_default, .hdir = hdir_default,
         sys.pncport = optarg;
         break;
 
+      case 'r':
+        sys.restore = optarg;
+        if(!(sys.physsize = snap_physsize(optarg)))
+        {
+          fprintf(stderr, "%s: not a snapshot: %s\n", optarg, strerror(errno));
+          exit(EXIT_FAILURE);
+        }
+        break;
+
+      case 'O':
+        if(!isdir(optarg))
+          sys.overlay = strdup(optarg);
+        break;
+
+      case 'I':
+        sys.incoming = optarg;
+        if((incfd = snap_accept(optarg, &sys.physsize)) < 0)
+        {
+          fprintf(stderr, "%s: no migration: %s\n", optarg, strerror(errno));
+          exit(EXIT_FAILURE);
+        }
+        break;
+
+      case 'd':
+        sys.detach = true;
+        break;
+
 #ifdef DEBUG
       case 'v':
         sys.verbose = 1;
@@ -165,5 +207,20 @@ sys_t sys = { .physsize = physsize_default, .hdir = hdir_default,
   if(sys.rcfile && *sys.rcfile)
     cmd_mainrc(&cpu, sys.rcfile);
 
+  if(sys.restore && snap_restore(&cpu, sys.restore))
+  {
+    fprintf(stderr, "Restore of %s failed: %s\n", sys.restore, strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+
+  if(sys.incoming && snap_incoming(&cpu, incfd))
+  {
+    fprintf(stderr, "Migration to %s failed: %s\n", sys.incoming, strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+
+  if(sys.detach)
+    exit(sysc_detach(&cpu));
+
   exit(cmd_main(&cpu));
 }
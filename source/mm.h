@@ -111,12 +111,69 @@ static inline uint32_t sdt_len(dtar_t dtar)
 }
 
 
+static inline tlbe_t *tlb_set(cpu_t *cpu, uint32_t vaddr)
+{
+  return cpu->tlb.t + ((ea_pgad(vaddr) >> em50_page_shift) & cpu->tlb.mask) * TLB_WAYS;
+}
+
+
+static inline tlbe_t *tlb_find(cpu_t *cpu, uint32_t vaddr, acc_t acc)
+{
+tlbe_t *t = tlb_set(cpu, vaddr);
+uint32_t w = (acc == acc_wr || acc == acc_wx) ? TLB_W : 0;
+uint32_t k = ea_pgad(vaddr) | TLB_V | w;
+uint32_t m = ~TLB_W | w;
+uint32_t d = G_DTAR(cpu, ea_dtar(vaddr));
+
+  for(int n = 0; n < TLB_WAYS; ++n, ++t)
+    if((t->e & m) == k && t->d == d)
+    {
+      t->u = ++cpu->tlb.clock;
+      cpu->tlb.hit[n]++;
+      return t;
+    }
+
+  return NULL;
+}
+
+
+static inline tlbe_t *tlb_fill(cpu_t *cpu, uint32_t vaddr)
+{
+tlbe_t *t = tlb_set(cpu, vaddr);
+uint32_t k = ea_pgad(vaddr) | TLB_V;
+uint32_t d = G_DTAR(cpu, ea_dtar(vaddr));
+int v = 0;
+
+  for(int n = 0; n < TLB_WAYS; ++n)
+  {
+    if((t[n].e & ~TLB_W) == k && t[n].d == d)
+    {
+      v = n;
+      break;
+    }
+    if(t[n].u < t[v].u)
+      v = n;
+  }
+
+  cpu->tlb.miss[v]++;
+  if((t[v].e & TLB_V) && ((t[v].e & ~TLB_W) != k || t[v].d != d))
+    cpu->tlb.evict[v]++;
+
+  t[v].u = ++cpu->tlb.clock;
+
+  return &t[v];
+}
+
+
 static inline void mm_itlb(cpu_t *cpu, uint32_t vaddr)
 {
-  uint32_t x = CACHE_INDEX(vaddr, acc_nn);
+  tlbe_t *t = tlb_set(cpu, vaddr);
 
-  cpu->tlb.v[x^0] = 0;
-  cpu->tlb.v[x^1] = 0;
+  for(int n = 0; n < TLB_WAYS; ++n)
+    if((t[n].e & ~(TLB_V|TLB_W)) == ea_pgad(vaddr))
+      t[n].e = 0;
+
+  ic_unbind(cpu);
 
   if(io_seg(vaddr))
     cpu->iotlb.v[IOTLB_INDEX(vaddr)] = 0;
@@ -285,6 +342,8 @@ static inline void rstore_w(cpu_t *cpu, uint32_t addr, uint16_t val)
 {
 if(addr < 0100) logmsg("\n@STORE %4.4x %4.4hx\n", addr, val);
   store_w(physad(cpu, addr), val);
+  ic_store(cpu, addr, 1);
+  dirty_mark(cpu, addr);
 }
 
 
@@ -292,6 +351,8 @@ static inline void rstore_d(cpu_t *cpu, uint32_t addr, uint32_t val)
 {
 if(addr < 0100) logmsg("\n@STORE %4.4x %8.8x\n", addr, val);
   store_d(physad(cpu, addr), val);
+  ic_store(cpu, addr, 2);
+  dirty_range(cpu, addr, 2);
 }
 
 
@@ -299,6 +360,8 @@ static inline void rstore_q(cpu_t *cpu, uint32_t addr, uint64_t val)
 {
 if(addr < 0100) logmsg("\n@STORE %4.4x %16.16jx\n", addr, (uintmax_t)val);
   store_q(physad(cpu, addr), val);
+  ic_store(cpu, addr, 4);
+  dirty_range(cpu, addr, 4);
 }
 
 
@@ -329,6 +392,39 @@ if(addr < 0100) logmsg("\n@FETCH %4.4x %16.16jx\n", addr, (uintmax_t)q);
 }
 
 
+static inline uint8_t *r2h(cpu_t *cpu, uint32_t addr)
+{
+  return (addr < cpu->maxmem) ? cpu->sys->physstor + (addr << 1) : NULL;
+}
+
+
+static inline uint32_t h2r(cpu_t *cpu, uint8_t *h)
+{
+  return (h - cpu->sys->physstor) >> 1;
+}
+
+
+static inline void hstore_w(cpu_t *cpu, uint8_t *h, uint16_t val)
+{
+  store_w(h, val);
+  ic_store(cpu, h2r(cpu, h), 1);
+}
+
+
+static inline void hstore_d(cpu_t *cpu, uint8_t *h, uint32_t val)
+{
+  store_d(h, val);
+  ic_store(cpu, h2r(cpu, h), 2);
+}
+
+
+static inline void hstore_q(cpu_t *cpu, uint8_t *h, uint64_t val)
+{
+  store_q((uint64_t *)h, val);
+  ic_store(cpu, h2r(cpu, h), 4);
+}
+
+
 #endif
 
 
@@ -445,7 +541,7 @@ int access = sdw_aaa(sdw, ring);
 }
 
 
-static inline int32_t E50X(xlatv2r)(cpu_t *cpu, uint32_t sdw, uint32_t vaddr, acc_t acc, void (*pfault)(cpu_t *, uint32_t))
+static inline int32_t E50X(xlatv2r)(cpu_t *cpu, uint32_t sdw, uint32_t vaddr, acc_t acc, void (*pfault)(cpu_t *, uint32_t), uint32_t *map)
 {
   uint32_t p = ea_page(vaddr);
   uint32_t o = ea_off(vaddr);
@@ -469,10 +565,13 @@ logall("FAULT raddr %8.8x pmt %8.8x vaddr %8.8x ie %d\n", h + (p << 1), pmt, vad
         pfault(cpu, vaddr);
       return -1;
     }
-    pmt |= pmt_u;
+    uint32_t n = pmt | pmt_u;
     if(acc == acc_wr || acc == acc_wx)
-      pmt &= ~pmt_m;
-    rstore_d(cpu, h + (p << 1), pmt);
+      n &= ~pmt_m;
+    if(n != pmt)
+      rstore_d(cpu, h + (p << 1), n);
+    if(map)
+      *map = h + (p << 1);
 #if !defined(MODEL)
     if(cpu->model.have_pmt == pmtx)
 #endif
@@ -500,10 +599,13 @@ logall("FAULT raddr %8.8x hmap %4.4x vaddr %8.8x ie %d\n", h + p, hmap, vaddr, c
         pfault(cpu, vaddr);
       return -1;
     }
-    hmap |= hmap_u;
+    uint16_t n = hmap | hmap_u;
     if(acc == acc_wr || acc == acc_wx)
-      hmap &= ~hmap_m;
-    rstore_w(cpu, h + p, hmap);
+      n &= ~hmap_m;
+    if(n != hmap)
+      rstore_w(cpu, h + p, n);
+    if(map)
+      *map = h + p;
     r = ((hmap & hmap_phy) << 10) | o;
   }
 #endif
@@ -512,35 +614,83 @@ logall("FAULT raddr %8.8x hmap %4.4x vaddr %8.8x ie %d\n", h + p, hmap, vaddr, c
 }
 
 
+/* Record the modification of a page that is already in the TLB
+ * for reading, the PMT/HMAP entry is only rewritten when the
+ * unmodified bit is still set
+ */
+static inline void E50X(xlatmod)(cpu_t *cpu, uint32_t map)
+{
+#if !defined(MODEL)
+  if(cpu->model.have_pmt)
+#endif
+#if !defined(MODEL) || defined(em50_have_pmt)
+  {
+    uint32_t pmt = rfetch_d(cpu, map);
+    if((pmt & pmt_m))
+      rstore_d(cpu, map, pmt & ~pmt_m);
+  }
+#endif
+#if !defined(MODEL)
+  else
+#endif
+#if !defined(MODEL) || !defined(em50_have_pmt)
+  {
+    uint16_t hmap = rfetch_w(cpu, map);
+    if((hmap & hmap_m))
+      rstore_w(cpu, map, hmap & ~hmap_m);
+  }
+#endif
+}
+
+
 static inline uint32_t E50X(v2rx)(cpu_t *cpu, uint32_t vaddr, acc_t acc)
 {
   vaddr |= cpu->pb & ea_r;
 
-  uint32_t x = CACHE_INDEX(vaddr, acc);
+  tlbe_t *t = tlb_find(cpu, vaddr, acc);
+
+  if(t)
+  {
+    E50X(acc_check)(cpu, t->s, vaddr, acc);
+    return t->r | (vaddr & em50_page_offm);
+  }
 
-  if(cpu->tlb.v[x] && cpu->tlb.e[x] == ea_pgad(vaddr))
+  if((acc == acc_wr || acc == acc_wx) && (t = tlb_find(cpu, vaddr, acc_rd)))
   {
-    E50X(acc_check)(cpu, cpu->tlb.s[x], vaddr, acc);
-    return cpu->tlb.r[x] | (vaddr & em50_page_offm);
+    E50X(acc_check)(cpu, t->s, vaddr, acc);
+    E50X(xlatmod)(cpu, t->p);
+    t->e |= TLB_W;
+    dirty_mark(cpu, t->r);
+    return t->r | (vaddr & em50_page_offm);
   }
 
   uint32_t sdw = E50X(fetch_sdw)(cpu, vaddr, E50X(segment_fault));
   E50X(acc_check)(cpu, sdw, vaddr, acc);
 
-  uint32_t r = E50X(xlatv2r)(cpu, sdw, vaddr, acc, E50X(page_fault));
+  uint32_t map;
+  uint32_t r = E50X(xlatv2r)(cpu, sdw, vaddr, acc, E50X(page_fault), &map);
+
+  uint8_t *h = r2h(cpu, r & em50_page_mask);
+
+  if(acc == acc_wr || acc == acc_wx)
+    dirty_mark(cpu, r);
 
   if(acc != acc_io)
   {
-    cpu->tlb.e[x & ~1] = cpu->tlb.e[x] = ea_pgad(vaddr);
-    cpu->tlb.r[x & ~1] = cpu->tlb.r[x] = r & em50_page_mask;
-    cpu->tlb.s[x & ~1] = cpu->tlb.s[x] = sdw;
-    cpu->tlb.v[x & ~1] = cpu->tlb.v[x] = 1;
+    t = tlb_fill(cpu, vaddr);
+    t->e = ea_pgad(vaddr) | TLB_V | ((acc == acc_wr || acc == acc_wx) ? TLB_W : 0);
+    t->r = r & em50_page_mask;
+    t->s = sdw;
+    t->d = G_DTAR(cpu, ea_dtar(vaddr));
+    t->p = map;
+    t->h = h;
   }
 
   if(io_seg(vaddr))
   {
     int i = IOTLB_INDEX(vaddr);
     cpu->iotlb.i[i] = r & em50_page_mask;
+    cpu->iotlb.h[i] = h;
     cpu->iotlb.v[i] = 1;
   }
 
@@ -558,12 +708,74 @@ if((vaddr & ea_f)) PRINTF("bug2\n");
 #endif
 
   if(!cpu->crs->km.sm)
+  {
+    if(acc == acc_wr || acc == acc_wx)
+      dirty_mark(cpu, vaddr & 0x0fffffff);
     return vaddr & 0x0fffffff;
+  }
 
   return E50X(v2rx)(cpu, vaddr, acc);
 }
 
 
+static inline uint8_t *E50X(v2h)(cpu_t *cpu, uint32_t vaddr, acc_t acc)
+{
+#if defined E16S || defined E32S || defined E32R || defined E64R
+  vaddr |= (cpu->b << 16);
+#else
+  vaddr |= (cpu->b << 16) & ea_r;
+#endif
+
+  if(!cpu->crs->km.sm)
+  {
+    if(acc == acc_wr || acc == acc_wx)
+      dirty_mark(cpu, vaddr & 0x0fffffff);
+    return physad(cpu, vaddr & 0x0fffffff);
+  }
+
+  tlbe_t *t = tlb_find(cpu, vaddr, acc);
+
+  if(t && t->h)
+  {
+    E50X(acc_check)(cpu, t->s, vaddr, acc);
+    return t->h + ((vaddr & em50_page_offm) << 1);
+  }
+
+  return physad(cpu, E50X(v2rx)(cpu, vaddr, acc));
+}
+
+
+/* Word access translation when it needs no more than a TLB hit (or
+ * no segmentation at all), NULL otherwise. Kept small so that it is
+ * inlined, misses and address traps take the out of line path.
+ */
+static inline uint8_t *E50X(v2h_hit)(cpu_t *cpu, uint32_t vaddr, acc_t acc)
+{
+#if defined E16S || defined E32S || defined E32R || defined E64R
+  vaddr |= (cpu->b << 16);
+#else
+  vaddr |= (cpu->b << 16) & ea_r;
+#endif
+
+  if(!cpu->crs->km.sm)
+  {
+    if((vaddr & 0x0fffffff) >= cpu->maxmem)
+      return NULL;
+    if(acc == acc_wr || acc == acc_wx)
+      dirty_mark(cpu, vaddr & 0x0fffffff);
+    return cpu->sys->physstor + ((vaddr & 0x0fffffff) << 1);
+  }
+
+  tlbe_t *t = tlb_find(cpu, vaddr, acc);
+
+  if(!t || !t->h)
+    return NULL;
+
+  E50X(acc_check)(cpu, t->s, vaddr, acc);
+  return t->h + ((vaddr & em50_page_offm) << 1);
+}
+
+
 #if defined(HMDE)
 static inline int32_t i2r(cpu_t *cpu, uint32_t vaddr)
 {
@@ -579,25 +791,50 @@ int i = IOTLB_INDEX(vaddr);
   uint32_t sdw = E50X(fetch_sdw)(cpu, vaddr, NULL);
   if((sdw & sdw_f))
     return -1;
-  return E50X(xlatv2r)(cpu, sdw, vaddr, acc_nn, NULL);
+  return E50X(xlatv2r)(cpu, sdw, vaddr, acc_nn, NULL, NULL);
 #endif
 
   return -1;
 }
+
+
+static inline uint8_t *i2h(cpu_t *cpu, uint32_t vaddr)
+{
+int i = IOTLB_INDEX(vaddr);
+
+  if(!cpu->crs->km.mio)
+    return physad(cpu, vaddr & 0x0fffffff);
+
+  if(io_seg(vaddr) && cpu->iotlb.v[i])
+  {
+    if(cpu->iotlb.h[i])
+      return cpu->iotlb.h[i] + (ea_off(vaddr) << 1);
+    return physad(cpu, cpu->iotlb.i[i] | ea_off(vaddr));
+  }
+
+  return NULL;
+}
 #endif
 
 
+static __attribute__ ((noinline, unused)) uint16_t E50X(vfetch_ws)(cpu_t *cpu, uint32_t addr, acc_t acc)
+{
+  if(!ISAT(cpu, addr))
+    return fetch_w(E50X(v2h)(cpu, addr, acc));
+  else
+    return tfetch_w(cpu, addr);
+}
+
+
 static inline uint16_t E50X(vfetch_wx)(cpu_t *cpu, uint32_t addr, acc_t acc)
 {
-uint16_t r;
+uint8_t *h;
 logmsg("\n\n*** " E50S " %4.4x vfetch_w %8.8x %4.4x %s***\n\n", cpu->crs->ownerl, addr, rfetch_w(cpu, E50X(v2r)(cpu, addr, acc_nn)), ISAT(cpu, addr) ? "ATR " : "");
 
-  if(!ISAT(cpu, addr))
-    r = rfetch_w(cpu, E50X(v2r)(cpu, addr, acc));
-  else
-    r = tfetch_w(cpu, addr);
+  if(!ISAT(cpu, addr) && (h = E50X(v2h_hit)(cpu, addr, acc)))
+    return fetch_w(h);
 
-  return r;
+  return E50X(vfetch_ws)(cpu, addr, acc);
 }
 
 
@@ -614,7 +851,7 @@ logmsg("\n\n*** " E50S " %4.4x vfetch_d %8.8x %8.8x %s***\n\n", cpu->crs->ownerl
 
   if(!page_cross_d(addr))
     if(!ISAT(cpu, addr))
-      r = rfetch_d(cpu, E50X(v2r)(cpu, addr, acc));
+      r = fetch_d(E50X(v2h)(cpu, addr, acc));
     else
       r = tfetch_d(cpu, addr);
   else
@@ -637,7 +874,7 @@ logmsg("\n\n*** " E50S " %4.4x vfetch_q %8.8x %16.16jx %s***\n\n", cpu->crs->own
 
   if(!page_cross_q(addr))
     if(!ISAT(cpu, addr))
-      r = rfetch_q(cpu, E50X(v2r)(cpu, addr, acc));
+      r = fetch_q(E50X(v2h)(cpu, addr, acc));
     else
       r = tfetch_q(cpu, addr);
   else
@@ -689,9 +926,16 @@ uint16_t r;
   if(!cpu->exec)
   {
 #if defined V_MODE || defined I_MODE
-    r = E50X(vfetch_wx)(cpu, cpu->pb, acc_ex);
+    if((cpu->pb & em50_page_mask) == cpu->icache.vp && !ISAT(cpu, cpu->pb))
 #else
-    r = E50X(vfetch_wx)(cpu, cpu->p, acc_ex);
+    if((cpu->pb & em50_page_mask) == cpu->icache.vp && !ISAT(cpu, cpu->p))
+#endif
+      r = fetch_w(cpu->icache.m + (ea_off(cpu->pb) << 1));
+    else
+#if defined V_MODE || defined I_MODE
+      r = E50X(vfetch_wx)(cpu, cpu->pb, acc_ex);
+#else
+      r = E50X(vfetch_wx)(cpu, cpu->p, acc_ex);
 #endif
     cpu->p++;
   }
@@ -719,10 +963,18 @@ static inline uint32_t E50X(vfetch_id)(cpu_t *cpu)
 {
   if(!cpu->exec)
   {
+uint32_t r;
 #if defined V_MODE || defined I_MODE
-    uint32_t r = E50X(vfetch_dx)(cpu, cpu->pb, acc_ex);
+    if((cpu->pb & em50_page_mask) == cpu->icache.vp && !page_cross_d(cpu->pb) && !ISAT(cpu, cpu->pb))
 #else
-    uint32_t r = E50X(vfetch_dx)(cpu, cpu->p, acc_ex);
+    if((cpu->pb & em50_page_mask) == cpu->icache.vp && !page_cross_d(cpu->pb) && !ISAT(cpu, cpu->p))
+#endif
+      r = fetch_d(cpu->icache.m + (ea_off(cpu->pb) << 1));
+    else
+#if defined V_MODE || defined I_MODE
+      r = E50X(vfetch_dx)(cpu, cpu->pb, acc_ex);
+#else
+      r = E50X(vfetch_dx)(cpu, cpu->p, acc_ex);
 #endif
     cpu->p += 2;
     return r;
@@ -746,16 +998,27 @@ static inline uint32_t E50X(vfetch_id_be)(cpu_t *cpu)
 }
 
 
-static inline void E50X(vstore_wx)(cpu_t *cpu, uint32_t addr, uint16_t val, acc_t acc)
+static __attribute__ ((noinline, unused)) void E50X(vstore_ws)(cpu_t *cpu, uint32_t addr, uint16_t val, acc_t acc)
 {
-logmsg("\n\n*** " E50S " %4.4x vstore_w %8.8x %4.4x %s***\n\n", cpu->crs->ownerl, addr, val, ISAT(cpu, addr) ? "ATR " : "");
   if(!ISAT(cpu, addr))
-    rstore_w(cpu, E50X(v2r)(cpu, addr, acc), val);
+    hstore_w(cpu, E50X(v2h)(cpu, addr, acc), val);
   else
     tstore_w(cpu, addr, val);
 }
 
 
+static inline void E50X(vstore_wx)(cpu_t *cpu, uint32_t addr, uint16_t val, acc_t acc)
+{
+uint8_t *h;
+logmsg("\n\n*** " E50S " %4.4x vstore_w %8.8x %4.4x %s***\n\n", cpu->crs->ownerl, addr, val, ISAT(cpu, addr) ? "ATR " : "");
+
+  if(!ISAT(cpu, addr) && (h = E50X(v2h_hit)(cpu, addr, acc)))
+    hstore_w(cpu, h, val);
+  else
+    E50X(vstore_ws)(cpu, addr, val, acc);
+}
+
+
 static inline void E50X(vstore_w)(cpu_t *cpu, uint32_t addr, uint16_t val)
 {
   E50X(vstore_wx)(cpu, WXX(addr), val, acc_wr);
@@ -767,7 +1030,7 @@ static inline void E50X(vstore_dx)(cpu_t *cpu, uint32_t addr, uint32_t val, acc_
 logmsg("\n\n*** " E50S " %4.4x vstore_d %8.8x %8.8x %s***\n\n", cpu->crs->ownerl, addr, val, ISAT(cpu, addr) ? "ATR " : "");
   if(!page_cross_d(addr))
     if(!ISAT(cpu, addr))
-      rstore_d(cpu, E50X(v2r)(cpu, addr, acc), val);
+      hstore_d(cpu, E50X(v2h)(cpu, addr, acc), val);
     else
       tstore_d(cpu, addr, val);
   else
@@ -789,7 +1052,7 @@ static inline void E50X(vstore_qx)(cpu_t *cpu, uint32_t addr, uint64_t val, acc_
 logmsg("\n\n*** " E50S " %4.4x vstore_q %8.8x %16.16jx %s***\n\n", cpu->crs->ownerl, addr, (uintmax_t)val, ISAT(cpu, addr) ? "ATR " : "");
   if(!page_cross_q(addr))
     if(!ISAT(cpu, addr))
-      rstore_q(cpu, E50X(v2r)(cpu, addr, acc), val);
+      hstore_q(cpu, E50X(v2h)(cpu, addr, acc), val);
     else
       tstore_q(cpu, addr, val);
   else
@@ -115,3 +115,7 @@
 #undef  E50I
 #define E50I(_n) \
   void E50X(_n)(cpu_t *cpu, op_t op)
+
+#undef  E50R
+#define E50R(_n) \
+  inst_t E50X(_n)(op_t op)
@@ -347,6 +347,7 @@ uint16_t s = E50X(vfetch_w)(cpu, ap);
 
   logop1o(op, "stac", ap);
 
+  cc_sync(cpu);
   if(b == s)
   {
     uint16_t a = G_A(cpu);
@@ -367,6 +368,7 @@ uint32_t s = E50X(vfetch_d)(cpu, ap);
 
   logop1o(op, "stlc", ap);
 
+  cc_sync(cpu);
   if(e == s)
   {
     uint32_t l = G_L(cpu);
@@ -389,6 +391,7 @@ uint16_t s = E50X(vfetch_w)(cpu, ap);
 
   logop1o(op, "stch", ap);
 
+  cc_sync(cpu);
   if(rl == s)
   {
     E50X(vstore_w)(cpu, ap, G_RH(cpu, dr));
@@ -411,6 +414,7 @@ uint32_t s = E50X(vfetch_d)(cpu, ap);
 
   logop1o(op, "stcd", ap);
 
+  cc_sync(cpu);
   if(r1 == s)
   {
     E50X(vstore_d)(cpu, ap, G_R(cpu, dr));
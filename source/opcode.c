@@ -80,7 +80,7 @@ static E50I(ill)
 }
 
 
-static E50I(o00)
+static E50R(o00)
 {
 int opcde = ((op[0] & 0b00000011) << 8) | op[1];
 
@@ -89,364 +89,364 @@ int opcde = ((op[0] & 0b00000011) << 8) | op[1];
 // ALFA 000000101100F001 (V mode format)
 #ifdef V_MODE
        case 0b1011000001:
-       case 0b1011001001: return E50X(alfa)(cpu, op);
+       case 0b1011001001: return E50X(alfa);
 #endif
 
 // ARGT 0000000110000101 (V mode form)
 //#if defined V_MODE || defined I_MODE
-       case 0b0110000101: return E50X(argt)(cpu, op);
+       case 0b0110000101: return E50X(argt);
 //#endif
 
 // CAI  0000000100001001 (S.R, V, I mode form)
-       case 0b0100001001: return E50X(cai)(cpu, op);
+       case 0b0100001001: return E50X(cai);
 
 // CALF 0000000111000101 AP\32 (V mode form)
-       case 0b0111000101: return E50X(calf)(cpu, op);
+       case 0b0111000101: return E50X(calf);
 
 // CEA  0000000001001001 (S R mode form)
-       case 0b0001001001: return E50X(cea)(cpu, op);
+       case 0b0001001001: return E50X(cea);
 
 // CGT  0000001011001100 INTEGER\16 ... (V mode form)
-       case 0b1011001100: return E50X(cgt)(cpu, op);
+       case 0b1011001100: return E50X(cgt);
 
 // CXCS 0000001111001100 (V, I mode form)
-       case 0b1111001100: return E50X(cxcs)(cpu, op);
+       case 0b1111001100: return E50X(cxcs);
       
 // DBL  0000000000000111 (S R mode form)
-       case 0b0000000111: return E50X(dbl)(cpu, op);
+       case 0b0000000111: return E50X(dbl);
 
 // E16S 0000000000001001 (S R V mode form)
-       case 0b0000001001: return E50X(e16s)(cpu, op);
+       case 0b0000001001: return E50X(e16s);
 
 // E32I 0000001000001000 (S R V mode form)
-       case 0b1000001000: return E50X(e32i)(cpu, op);
+       case 0b1000001000: return E50X(e32i);
 
 // E32R 0000001000001011 (S R V mode form)
-       case 0b1000001011: return E50X(e32r)(cpu, op);
+       case 0b1000001011: return E50X(e32r);
 
 // E32S 0000000000001011 (S R V mode form)
-       case 0b0000001011: return E50X(e32s)(cpu, op);
+       case 0b0000001011: return E50X(e32s);
 
 // E64R 0000001000001001 (S R V mode form)
-       case 0b1000001001: return E50X(e64r)(cpu, op);
+       case 0b1000001001: return E50X(e64r);
 
 // E64V 0000000000001000 (S R V mode form)
-       case 0b0000001000: return E50X(e64v)(cpu, op);
+       case 0b0000001000: return E50X(e64v);
 
 // EAFA 000000101100 FAR 000 AP\32 (V mode form)
        case 0b1011000000:
-       case 0b1011001000: return E50X(eafa)(cpu, op);
+       case 0b1011001000: return E50X(eafa);
 
 // EMCM 0000000101000011 (S, R, V, I mode form)
-       case 0b0101000011: return E50X(emcm)(cpu, op);
+       case 0b0101000011: return E50X(emcm);
 
 // ENB  0000000100000001 (S R V  -- ENBL
-       case 0b0100000001: return E50X(enb)(cpu, op);
+       case 0b0100000001: return E50X(enb);
 
 // ENBM 0000000100000000 (S R V mode form)
-       case 0b0100000000: return E50X(enbm)(cpu, op);
+       case 0b0100000000: return E50X(enbm);
 
 // ENBP 0000000100000010 (S R V mode form)
-       case 0b0100000010: return E50X(enbp)(cpu, op);
+       case 0b0100000010: return E50X(enbp);
 
 // ESIM 0000000100001101 (S, R, V, I mode form)
-       case 0b0100001101: return E50X(esim)(cpu, op);
+       case 0b0100001101: return E50X(esim);
 
 // EVIM 0000000100001111 (S, R, V, I mode form)
-       case 0b0100001111: return E50X(evim)(cpu, op);
+       case 0b0100001111: return E50X(evim);
 
 // HLT  0000000000000000 (R, V mode form)
-       case 0b0000000000: return E50X(hlt)(cpu, op);
+       case 0b0000000000: return E50X(hlt);
 
 // IAB  0000000010000001 (S, R, V mode form)
-       case 0b0010000001: return E50X(iab)(cpu, op);
+       case 0b0010000001: return E50X(iab);
 
 // INBC 0000001010001111 AP\32 (V mode form)
-       case 0b1010001111: return E50X(inbc)(cpu, op);
+       case 0b1010001111: return E50X(inbc);
 
 // INBN 0000001010001101 AP\32 (V mode form)
-       case 0b1010001101: return E50X(inbn)(cpu, op);
+       case 0b1010001101: return E50X(inbn);
 
 // INEC 0000001010001110 AP\32 (V mode form)
-       case 0b1010001110: return E50X(inec)(cpu, op);
+       case 0b1010001110: return E50X(inec);
 
 // INEN 0000001010001100 AP\32 (V mode form)
-       case 0b1010001100: return E50X(inen)(cpu, op);
+       case 0b1010001100: return E50X(inen);
 
 // INH  0000001000000001 (S, R, V mode form) -- INHL
-       case 0b1000000001: return E50X(inh)(cpu, op);
+       case 0b1000000001: return E50X(inh);
 
 // INHM 0000001000000000 (S, R, V mode form)
-       case 0b1000000000: return E50X(inhm)(cpu, op);
+       case 0b1000000000: return E50X(inhm);
 
 // INHP 0000001000000010 (S, R, V mode form)
-       case 0b1000000010: return E50X(inhp)(cpu, op);
+       case 0b1000000010: return E50X(inhp);
 
 #if defined S_MODE || defined R_MODE || defined V_MODE
 // INK  0000000000100011 (S, R mode form)
-       case 0b0000100011: return E50X(ink)(cpu, op);
+       case 0b0000100011: return E50X(ink);
 #endif
 
 // IRTC 0000000110000011 (V mode form)
-       case 0b0110000011: return E50X(irtc)(cpu, op);
+       case 0b0110000011: return E50X(irtc);
 
 // IRTN 0000000110000001 (V mode form)
-       case 0b0110000001: return E50X(irtn)(cpu, op);
+       case 0b0110000001: return E50X(irtn);
 
 // ITLB 0000000110001101 (V mode form)
-       case 0b0110001101: return E50X(itlb)(cpu, op);
+       case 0b0110001101: return E50X(itlb);
 
 #ifdef V_MODE
 // LDC  000000101100 FLR 010 (V mode form)
        case 0b1011000010:
-       case 0b1011001010: return E50X(ldc)(cpu, op);
+       case 0b1011001010: return E50X(ldc);
 #endif
 
 // LFLI 000000101100 FLR 011 (V mode form)
        case 0b1011000011:
-       case 0b1011001011: return E50X(lfli)(cpu, op);
+       case 0b1011001011: return E50X(lfli);
 
 // EPMX 0000000010011111 (000237)
-       case 0b0010011111: return E50X(epmx)(cpu,op);
+       case 0b0010011111: return E50X(epmx);
 
 // LPMX 0000000010011101 (000235)
-       case 0b0010011101: return E50X(lpmx)(cpu,op);
+       case 0b0010011101: return E50X(lpmx);
 
 // EVMX 0000000111010011 (000723)
-       case 0b0111010011: return E50X(evmx)(cpu,op);
+       case 0b0111010011: return E50X(evmx);
 
 // ERMX 0000000111010001 (000721)
-       case 0b0111010001: return E50X(ermx)(cpu,op);
+       case 0b0111010001: return E50X(ermx);
 
 // EPMJ 0000000010001111 (000217)
-       case 0b0010001111: return E50X(epmj)(cpu,op);
+       case 0b0010001111: return E50X(epmj);
 
 // LPMJ 0000000010001101 (000215)
-       case 0b0010001101: return E50X(lpmj)(cpu,op);
+       case 0b0010001101: return E50X(lpmj);
 
 // EVMJ 0000000111000011 (000703)
-       case 0b0111000011: return E50X(evmj)(cpu,op);
+       case 0b0111000011: return E50X(evmj);
 
 // ERMJ 0000000111000001 (000701)
-       case 0b0111000001: return E50X(ermj)(cpu,op);
+       case 0b0111000001: return E50X(ermj);
 
 #if defined S_MODE || defined R_MODE
 // ISI  0000000101001001 (000511)
-       case 0b0101001001: return E50X(isi)(cpu,op);
+       case 0b0101001001: return E50X(isi);
 
 // OSI  0000000101001101 (000515)
-       case 0b0101001101: return E50X(osi)(cpu,op);
+       case 0b0101001101: return E50X(osi);
 #endif
 
 // LMCM 0000000101000001 (S, R, V, I mode form)
-       case 0b0101000001: return E50X(lmcm)(cpu, op);
+       case 0b0101000001: return E50X(lmcm);
 
 // LMCS 0000001111001000 (V, I mode form)
-       case 0b1111001000: return E50X(lwcs)(cpu, op);
+       case 0b1111001000: return E50X(lwcs);
 
 // MDEI 0000001011000100 (V, I mode form)
-       case 0b1011000100: return E50X(mdei)(cpu, op);
+       case 0b1011000100: return E50X(mdei);
 
 // MDII 0000001011000101 (V, I mode form)
-       case 0b1011000101: return E50X(mdii)(cpu, op);
+       case 0b1011000101: return E50X(mdii);
 
 // MDIW 0000001011010100 (V, I mode form)
-       case 0b1011010100: return E50X(mdiw)(cpu, op);
+       case 0b1011010100: return E50X(mdiw);
 
 // MDRS 0000001011000110 (V, I mode form)
-       case 0b1011000110: return E50X(mdrs)(cpu, op);
+       case 0b1011000110: return E50X(mdrs);
 
 // MDWC 0000001011000111 (V, I mode form)
-       case 0b1011000111: return E50X(mdwc)(cpu, op);
+       case 0b1011000111: return E50X(mdwc);
 
 // NRM  0000000001000001 (S, R mode form)
-       case 0b0001000001: return E50X(nrm)(cpu, op);
+       case 0b0001000001: return E50X(nrm);
 
 // LIOT 0000000000100100 AP\32 (V mode form)
-       case 0b0000100100: return E50X(liot)(cpu, op);
+       case 0b0000100100: return E50X(liot);
 
 // LPID 0000000110001111 (V mode form)
-       case 0b0110001111: return E50X(lpid)(cpu, op);
+       case 0b0110001111: return E50X(lpid);
 
 // LPSW 0000000111001001 AP\32 (V mode form)
-       case 0b0111001001: return E50X(lpsw)(cpu, op);
+       case 0b0111001001: return E50X(lpsw);
 
 // NFYB 0000001010001001 AP\32 (V mode form)
-       case 0b1010001001: return E50X(nfyb)(cpu, op);
+       case 0b1010001001: return E50X(nfyb);
 
 // NFYE 0000001010001000 AP\32 (V mode form)
-       case 0b1010001000: return E50X(nfye)(cpu, op);
+       case 0b1010001000: return E50X(nfye);
 
 // NOP  0000000000000001 (S, R, V mode form)
-       case 0b0000000001: return E50X(nop)(cpu, op);
+       case 0b0000000001: return E50X(nop);
 
 #if defined S_MODE || defined R_MODE
 // OTK  0000000100000101 (S, R mode form)
-       case 0b0100000101: return E50X(otk)(cpu, op);
+       case 0b0100000101: return E50X(otk);
 #endif
 
 // PID  0000000010001001 (S, R mode form)
-       case 0b0010001001: return E50X(pid)(cpu, op);
+       case 0b0010001001: return E50X(pid);
 
 // PIDA 0000000001001101 (V mode form)
-       case 0b0001001101: return E50X(pida)(cpu, op);
+       case 0b0001001101: return E50X(pida);
 
 // PIDL 0000000011000101 (V mode form)
-       case 0b0011000101: return E50X(pidl)(cpu, op);
+       case 0b0011000101: return E50X(pidl);
 
 // PIM  0000000010000101 (S, R mode form)
-       case 0b0010000101: return E50X(pim)(cpu, op);
+       case 0b0010000101: return E50X(pim);
 
 // PIMA 0000000000001101 (V mode form)
-       case 0b0000001101: return E50X(pima)(cpu, op);
+       case 0b0000001101: return E50X(pima);
 
 // PIML 0000000011000001 (V mode form)
-       case 0b0011000001: return E50X(piml)(cpu, op);
+       case 0b0011000001: return E50X(piml);
 
 // PRTN 0000000110001001 (V mode foim)
-       case 0b0110001001: return E50X(prtn)(cpu, op);
+       case 0b0110001001: return E50X(prtn);
 
 // PTLB 0000000000110100 (V mode foim)
-       case 0b0000110100: return E50X(ptlb)(cpu, op);
+       case 0b0000110100: return E50X(ptlb);
 
 // RMC  0000000000010001 (S, R, V mode form)
-       case 0b0000010001: return E50X(rmc)(cpu, op);
+       case 0b0000010001: return E50X(rmc);
 
 // RRST 0000000111001111 AP\32 (V mode form)
-       case 0b0111001111: return E50X(rrst)(cpu, op);
+       case 0b0111001111: return E50X(rrst);
 
 // RSAV 0000000111001101 AP\32 (V mode form)
-       case 0b0111001101: return E50X(rsav)(cpu, op);
+       case 0b0111001101: return E50X(rsav);
 
 #if defined R_MODE
 // RTN  0000000001000101 (R mode form)
-       case 0b0001000101: return E50X(rtn)(cpu, op);
+       case 0b0001000101: return E50X(rtn);
 #endif
 
 #if defined V_MODE
 // RTS  0000000101001001 (V mode form)
-       case 0b0101001001: return E50X(rts)(cpu, op);
+       case 0b0101001001: return E50X(rts);
 #endif
 
 // SCA  0000000000100001 (S, R mode form)
-       case 0b0000100001: return E50X(sca)(cpu, op);
+       case 0b0000100001: return E50X(sca);
 
 // SGL  0000000000000101 (S, R mode form)  -- Enter Single Precision mode  AFFECTS LDA STA ADD SUB
-       case 0b0000000101: return E50X(sgl)(cpu, op);
+       case 0b0000000101: return E50X(sgl);
 
 // STAC 0000001010000000 AP\32 (V mode form)
-       case 0b1010000000: return E50X(stac)(cpu, op);
+       case 0b1010000000: return E50X(stac);
 
 // STC  000000101101 FLR 010 AP\32 (V mode form)
        case 0b1011010010:
-       case 0b1011011010: return E50X(stc)(cpu, op);
+       case 0b1011011010: return E50X(stc);
 
 // STEX 0000001011001101 (V mode form)
-       case 0b1011001101: return E50X(stex)(cpu, op);
+       case 0b1011001101: return E50X(stex);
 
 // STFA 000000101101 FAR 000 AP\32 (V mode form)
        case 0b1011010000:
-       case 0b1011011000: return E50X(stfa)(cpu, op);
+       case 0b1011011000: return E50X(stfa);
 
 // STLC 0000001010000100 AP\32 (V mode form)
-       case 0b1010000100: return E50X(stlc)(cpu, op);
+       case 0b1010000100: return E50X(stlc);
 
 // STPM 0000000000010100 (V mode form)
-       case 0b0000010100: return E50X(stpm)(cpu, op);
+       case 0b0000010100: return E50X(stpm);
 
 // STTM 0000000101001000 (V mode form)
-       case 0b0101001000: return E50X(sttm)(cpu, op);
+       case 0b0101001000: return E50X(sttm);
 
 // SVC  0000000101000101 (S, R, V mode form)
-       case 0b0101000101: return E50X(svc)(cpu, op);
+       case 0b0101000101: return E50X(svc);
 
 #if defined V_MODE || defined R_MODE
 // TAK  0000001000001101 (V mode form)
-       case 0b1000001101: return E50X(tak)(cpu, op);
+       case 0b1000001101: return E50X(tak);
 #endif
 
 // TFLL 000000101101 FLR 011 (V mode form)
        case 0b1011010011:
-       case 0b1011011011: return E50X(tfll)(cpu, op);
+       case 0b1011011011: return E50X(tfll);
 
 //#if defined V_MODE || defined R_MODE || defined S_MODE
 // TKA  0000001000000101 (V mode form)
-       case 0b1000000101: return E50X(tka)(cpu, op);
+       case 0b1000000101: return E50X(tka);
 //#endif
 
 // TLFL 000000101101 FLR 001 (V mode form)
        case 0b1011010001:
-       case 0b1011011001: return E50X(tlfl)(cpu, op);
+       case 0b1011011001: return E50X(tlfl);
 
 // VIRY 0000000011001001 (S, R, V mode form)
-       case 0b0011001001: return E50X(viry)(cpu, op);
+       case 0b0011001001: return E50X(viry);
 
 // WAIT 0000000011001101 AP\32 (V mode form)
-       case 0b0011001101: return E50X(wait)(cpu, op);
+       case 0b0011001101: return E50X(wait);
 
 // XAD  0000001001000000 (V mode form)
-       case 0b1001000000: return E50X(xad)(cpu, op);
+       case 0b1001000000: return E50X(xad);
 
 // XMP  0000001001000100 (V mode form)
-       case 0b1001000100: return E50X(xmp)(cpu, op);
+       case 0b1001000100: return E50X(xmp);
 
 // XBTD 0000001001100101 (V mode form)
-       case 0b1001100101: return E50X(xbtd)(cpu, op);
+       case 0b1001100101: return E50X(xbtd);
 
 // XCM  0000001001000010 (V mode form)
-       case 0b1001000010: return E50X(xcm)(cpu, op);
+       case 0b1001000010: return E50X(xcm);
 
 // XDTB 0000001001100110 (V mode form)
-       case 0b1001100110: return E50X(xdtb)(cpu, op);
+       case 0b1001100110: return E50X(xdtb);
 
 // XDV  0000001001000111 (V mode form)
-       case 0b1001000111: return E50X(xdv)(cpu, op);
+       case 0b1001000111: return E50X(xdv);
 
 // XED  0000001001001010 (V mode form)
-       case 0b1001001010: return E50X(xed)(cpu, op);
+       case 0b1001001010: return E50X(xed);
 
 // XMV  0000001001000001 (V mode form)
-       case 0b1001000001: return E50X(xmv)(cpu, op);
+       case 0b1001000001: return E50X(xmv);
 
 // XVRY 0000001001001011 (S, R, V mode form)
-       case 0b1001001011: return E50X(xvry)(cpu, op);
+       case 0b1001001011: return E50X(xvry);
 
 // ZCM  0000001001001111 (V mode form)
-       case 0b1001001111: return E50X(zcm)(cpu, op);
+       case 0b1001001111: return E50X(zcm);
 
 // ZED  0000001001001001 (V mode form)
-       case 0b1001001001: return E50X(zed)(cpu, op);
+       case 0b1001001001: return E50X(zed);
 
 // ZFIL 0000001001001110 (V mode form)
-       case 0b1001001110: return E50X(zfil)(cpu, op);
+       case 0b1001001110: return E50X(zfil);
 
 // ZMV  0000001001001100 (V mode form)
-       case 0b1001001100: return E50X(zmv)(cpu, op);
+       case 0b1001001100: return E50X(zmv);
 
 // ZMVD 0000001001001101 (V mode form)
-       case 0b1001001101: return E50X(zmvd)(cpu, op);
+       case 0b1001001101: return E50X(zmvd);
 
 // ZTRN 0000001001001000 (V mode form)
-       case 0b1001001000: return E50X(ztrn)(cpu, op);
+       case 0b1001001000: return E50X(ztrn);
 
 // ???  0000000000000011
-       case 0b0000000011: return E50X(003)(cpu, op); // ZZ ???
+       case 0b0000000011: return E50X(003); // ZZ ???
 
     default:
       switch(opcde & 0b1111000000)
       {
 // WCS  0000001110 N\6 (R, V, I mode form)
-       case 0b1110000000: return E50X(wcs)(cpu, op);
+       case 0b1110000000: return E50X(wcs);
 // DBG  0000001111 N\6 (R, V, I mode form)
-       case 0b1111000000: return E50X(ill)(cpu, op); // ZZ ???
+       case 0b1111000000: return E50X(ill); // ZZ ???
       }
   }
 
-  return E50X(ill)(cpu, op);
+  return E50X(ill);
 }
 
 
-static E50I(o60)
+static E50R(o60)
 {
 int opcde = ((op[0] & 0b00000011) << 8) | op[1];
 
@@ -454,428 +454,428 @@ int opcde = ((op[0] & 0b00000011) << 8) | op[1];
   {
 #ifndef I_MODE
 // A1A  1100001010000110 (S, R, V mode form)
-       case 0b1010000110: return E50X(a1a)(cpu, op);
+       case 0b1010000110: return E50X(a1a);
 
 // A2A  1100000011000100 (S, R, V mode form)
-       case 0b0011000100: return E50X(a2a)(cpu, op);
+       case 0b0011000100: return E50X(a2a);
 #endif
 
 // ABQ  1100001111001110 (V mode form)
 #ifdef V_MODE
-       case 0b1111001110: return E50X(abq)(cpu, op);
+       case 0b1111001110: return E50X(abq);
 #endif
 
 #ifndef I_MODE
 // ACA  1100001010001110 (S, R, V mode form)
-       case 0b1010001110: return E50X(aca)(cpu, op);
+       case 0b1010001110: return E50X(aca);
 #endif
 
 // ALL  1100001000000000 (V mode form)
 #ifdef V_MODE
-       case 0b1000000000: return E50X(adll)(cpu, op);
+       case 0b1000000000: return E50X(adll);
 #endif
 
 // ATQ  1100001111001111 AP\32 (V mode form)
 #ifdef V_MODE
-       case 0b1111001111: return E50X(atq)(cpu, op);
+       case 0b1111001111: return E50X(atq);
 #endif
 
 #if defined R_MODE || defined V_MODE || defined I_MODE
 // BCEQ 1100001110000010 ADDRESS\16 (V mode form)
-       case 0b1110000010: return E50X(bceq)(cpu, op);
+       case 0b1110000010: return E50X(bceq);
 
 // BCGE 1100001110000101 ADDRESS\16 (V mode form)
-       case 0b1110000101: return E50X(bcge)(cpu, op);
+       case 0b1110000101: return E50X(bcge);
 
 // BCGT 1100001110000001 ADDRESS\16 (V mode form)
-       case 0b1110000001: return E50X(bcgt)(cpu, op);
+       case 0b1110000001: return E50X(bcgt);
 
 // BCLE 1100001110000000 ADDRESS\16 (V mode form)
-       case 0b1110000000: return E50X(bcle)(cpu, op);
+       case 0b1110000000: return E50X(bcle);
 
 // BCLT 1100001110000100 ADDRESS\16 (V mode form)
-       case 0b1110000100: return E50X(bclt)(cpu, op);
+       case 0b1110000100: return E50X(bclt);
 
 // BCNE 1100001110000011 ADDRESS\16 (V mode form)
-       case 0b1110000011: return E50X(bcne)(cpu, op);
+       case 0b1110000011: return E50X(bcne);
 
 // BCR  1100001111000101 ADDRESS\16 (V mode form)
-       case 0b1111000101: return E50X(bcr)(cpu, op);
+       case 0b1111000101: return E50X(bcr);
 
 // BCS  1100001111000100 ADDRESS\16 (V mode form)
-       case 0b1111000100: return E50X(bcs)(cpu, op); 
+       case 0b1111000100: return E50X(bcs); 
 #endif
 
 #if defined R_MODE || defined V_MODE
 // BDX  1100000111011100 ADDRESS\16 (V mode form)
-       case 0b0111011100: return E50X(bdx)(cpu, op);
+       case 0b0111011100: return E50X(bdx);
 
 // BEQ  1100000110001010 ADDRESS\16 (V mode form)
-       case 0b0110001010: return E50X(beq)(cpu, op);
+       case 0b0110001010: return E50X(beq);
 #endif
 
 #if defined R_MODE || defined V_MODE
 // BDY  1100000111010100 ADDRESS\16 (V mode form)
-       case 0b0111010100: return E50X(bdy)(cpu, op);
+       case 0b0111010100: return E50X(bdy);
 
 // BIY  1100001011010100 ADDRESS\16 (V mode form)
-       case 0b1011010100: return E50X(biy)(cpu, op);
+       case 0b1011010100: return E50X(biy);
 #endif
 
 #if defined R_MODE || defined V_MODE
 // BFEQ 1100001110001010 ADDRESS\16 (V mode form)
-       case 0b1110001010: return E50X(bfeq)(cpu, op);
+       case 0b1110001010: return E50X(bfeq);
 
 // BFGE 1100001110001101 ADDRESS\16 (V mode form)
-       case 0b1110001101: return E50X(bfge)(cpu, op);
+       case 0b1110001101: return E50X(bfge);
 
 // BFGT 1100001110001001 ADDRESS\16 (V mode form)
-       case 0b1110001001: return E50X(bfgt)(cpu, op);
+       case 0b1110001001: return E50X(bfgt);
 
 // BFLE 1100001110001000 ADDRESS\16 (V mode form)
-       case 0b1110001000: return E50X(bfle)(cpu, op);
+       case 0b1110001000: return E50X(bfle);
 
 // BFLT 1100001110001100 ADDRESS\16 (V mode form)
-       case 0b1110001100: return E50X(bflt)(cpu, op);
+       case 0b1110001100: return E50X(bflt);
 
 // BFNE 1100001110001011 ADDRESS\16 (V mode form)
-       case 0b1110001011: return E50X(bfne)(cpu, op);
+       case 0b1110001011: return E50X(bfne);
 
 // BGE  1100000110001101 ADDRESS\16 (V mode form)
-       case 0b0110001101: return E50X(bge)(cpu, op);
+       case 0b0110001101: return E50X(bge);
 
 // BGT  1100000110001001 ADDRESS\16 (V mode form)
-       case 0b0110001001: return E50X(bgt)(cpu, op);
+       case 0b0110001001: return E50X(bgt);
 
 // BIX  1100001011011100 ADDRESS\16 (V mode form)
-       case 0b1011011100: return E50X(bix)(cpu, op);
+       case 0b1011011100: return E50X(bix);
 
 // BLE  1100000110001000 ADDRESS\16 (V mode form)
-       case 0b0110001000: return E50X(ble)(cpu, op);
+       case 0b0110001000: return E50X(ble);
 
 // BLEQ 1100000111000010 ADDRESS\16 (V mode form)
-       case 0b0111000010: return E50X(bleq)(cpu, op);
+       case 0b0111000010: return E50X(bleq);
 
 // BLGE 1100000110001101 ADDRESS\16 (V mode form)
-// BGE case 0b0110001101: return E50X(blge)(cpu, op);
+// BGE case 0b0110001101: return E50X(blge);
 
 // BLGT 1100000111000001 ADDRESS\16 (V mode form)
-       case 0b0111000001: return E50X(blgt)(cpu, op);
+       case 0b0111000001: return E50X(blgt);
 
 // BLLE 1100000111000000 ADDRESS\16 (V mode form)
-       case 0b0111000000: return E50X(blle)(cpu, op);
+       case 0b0111000000: return E50X(blle);
 
 // BLLT 1100000110001100 ADDRESS\16 (V mode form)
-// BLT case 0b0110001100: return E50X(bllt)(cpu, op);
+// BLT case 0b0110001100: return E50X(bllt);
 
 // BLNE 1100000111000011 ADDRESS\16 (V mode form)
-       case 0b0111000011: return E50X(blne)(cpu, op);
+       case 0b0111000011: return E50X(blne);
 #endif
 
 #if defined R_MODE || defined V_MODE || defined I_MODE
 // BLR  1100001111000111 ADDRESS\16 (V mode form)
-       case 0b1111000111: return E50X(blr)(cpu, op);
+       case 0b1111000111: return E50X(blr);
 
 // BLS  1100001111000110 ADDRESS\16 (V mode form)
-       case 0b1111000110: return E50X(bls)(cpu, op);
+       case 0b1111000110: return E50X(bls);
 #endif
 
 #if defined V_MODE || defined R_MODE
 // BLT  1100000110001100 ADDRESS\16 (V mode form)
-       case 0b0110001100: return E50X(blt)(cpu, op);
+       case 0b0110001100: return E50X(blt);
 #endif
 
 #if defined V_MODE || defined I_MODE
 // BMEQ 1100001110000010 ADDRESS\16 (V mode form)
-//BCEQ case 0b1110000010: return E50X(bmeq)(cpu, op);
+//BCEQ case 0b1110000010: return E50X(bmeq);
 
 // BMGE 1100001111000110 ADDRESS\16 (V mode form)
-// BLS case 0b1111000110: return E50X(bmge)(cpu, op);
+// BLS case 0b1111000110: return E50X(bmge);
 
 // BMGT 1100001111001000 ADDRESS\16 (V mode form)
-       case 0b1111001000: return E50X(bmgt)(cpu, op);
+       case 0b1111001000: return E50X(bmgt);
 
 // BMLE 1100001111001001 ADDRESS\16 (V mode form)
-       case 0b1111001001: return E50X(bmle)(cpu, op);
+       case 0b1111001001: return E50X(bmle);
 
 // BMLT 1100001111000111 ADDRESS\16 (V mode form)
-// BLR case 0b1111000111: return E50X(bmlt)(cpu, op);
+// BLR case 0b1111000111: return E50X(bmlt);
 
 // BMNE 1100001110000011 ADDRESS\16 (V mode form)
-//BCNE case 0b1110000011: return E50X(bmne)(cpu, op);
+//BCNE case 0b1110000011: return E50X(bmne);
 #endif
 
 // BNE  1100000110001011 ADDRESS\16 (V mode form)
-       case 0b0110001011: return E50X(bne)(cpu, op);
+       case 0b0110001011: return E50X(bne);
 
 // CAL  1100001000101000 (S R V mode form)
-       case 0b1000101000: return E50X(cal)(cpu, op);
+       case 0b1000101000: return E50X(cal);
 
 // CAR  1100001000100100 (S R V mode form)
-       case 0b1000100100: return E50X(car)(cpu, op);
+       case 0b1000100100: return E50X(car);
 
 // CAZ  1100000010001100 (S R V mode form)
-       case 0b0010001100: return E50X(caz)(cpu, op);
+       case 0b0010001100: return E50X(caz);
 
 // CHS  1100000000010100 (S R V mode form)
-       case 0b0000010100: return E50X(chs)(cpu, op);
+       case 0b0000010100: return E50X(chs);
 
 // CMA  1100000100000001 (S R V mode form)
-       case 0b0100000001: return E50X(cma)(cpu, op);
+       case 0b0100000001: return E50X(cma);
 
 // CRA  1100000000100000 (S R V mode form)
-       case 0b0000100000: return E50X(cra)(cpu, op);
+       case 0b0000100000: return E50X(cra);
 
 // CRB  1100000000001101 (S R V mode form)
-       case 0b0000001101: return E50X(crb)(cpu, op);
+       case 0b0000001101: return E50X(crb);
 
 // CRBx 1100000000001100 (S R V mode form)
-       case 0b0000001100: return E50X(crbx)(cpu, op);
+       case 0b0000001100: return E50X(crbx);
 
 // CRE  1100001100000100 (V mode form)
-       case 0b1100000100: return E50X(cre)(cpu, op);
+       case 0b1100000100: return E50X(cre);
 
 // CRL  1100000000001000 (S R V mode form)
-       case 0b0000001000: return E50X(crl)(cpu, op);
+       case 0b0000001000: return E50X(crl);
 
 // CRLE 1100001100001000 (V mode form)
-       case 0b1100001000: return E50X(crle)(cpu, op);
+       case 0b1100001000: return E50X(crle);
 
 // CSA  1100000011010000 (S R V mode form)
-       case 0b0011010000: return E50X(csa)(cpu, op);
+       case 0b0011010000: return E50X(csa);
 
 // DFCM 1100000101111100 (R V mode form)
-       case 0b0101111100: return E50X(dfcm)(cpu, op);
+       case 0b0101111100: return E50X(dfcm);
 
 // DRX  1100000010001000 (S R V mode form)
-       case 0b0010001000: return E50X(drx)(cpu, op);
+       case 0b0010001000: return E50X(drx);
 
 // FCDQ 1100000101111001 (V mode form)
 // DRNM 1100000101111001 (V mode form)
-       case 0b0101111001: return E50X(fcdq)(cpu, op);
+       case 0b0101111001: return E50X(fcdq);
 
 // FCM  1100000101011000 (R, V mode form)
-       case 0b0101011000: return E50X(fcm)(cpu, op);
+       case 0b0101011000: return E50X(fcm);
 
 // FDBL 1100000000001110 (V mode form)
-       case 0b0000001110: return E50X(fdbl)(cpu, op);
+       case 0b0000001110: return E50X(fdbl);
 
 // FLOT 1100000101101000 (R mode form)
-       case 0b0101101000: return E50X(flot)(cpu, op);
+       case 0b0101101000: return E50X(flot);
 
 // FLTA 1100000101011010 (V mode form)
-       case 0b0101011010: return E50X(flta)(cpu, op);
+       case 0b0101011010: return E50X(flta);
 
 // FLTL 1100000101011101 (V mode form)
-       case 0b0101011101: return E50X(fltl)(cpu, op);
+       case 0b0101011101: return E50X(fltl);
 
 // FRN  1100000101011100 (R, V mode form)
-       case 0b0101011100: return E50X(frn)(cpu, op);
+       case 0b0101011100: return E50X(frn);
 
 #if defined R_MODE || defined V_MODE
 // FSGT 1100000101001101 (R, V mode form)
-       case 0b0101001101: return E50X(fsgt)(cpu, op);
+       case 0b0101001101: return E50X(fsgt);
 
 // FSLE 1100000101001100 (R, V mode form)
-       case 0b0101001100: return E50X(fsle)(cpu, op);
+       case 0b0101001100: return E50X(fsle);
 
 // FSMI 1100000101001010 (R, V mode form)
-       case 0b0101001010: return E50X(fsmi)(cpu, op);
+       case 0b0101001010: return E50X(fsmi);
 
 // FSNZ 1100000101001001 (R, V mode form)
-       case 0b0101001001: return E50X(fsnz)(cpu, op);
+       case 0b0101001001: return E50X(fsnz);
 
 // FSPL 1100000101001011 (R, V mode form)
-       case 0b0101001011: return E50X(fspl)(cpu, op);
+       case 0b0101001011: return E50X(fspl);
 
 // FSZE 1100000101001000 (R, V mode form)
-       case 0b0101001000: return E50X(fsze)(cpu, op);
+       case 0b0101001000: return E50X(fsze);
 #endif
 
 // ICA  1100001011100000 (S, R, V mode form)
-       case 0b1011100000: return E50X(ica)(cpu, op);
+       case 0b1011100000: return E50X(ica);
 
 // ICL  1100001001100000 (S, R, V mode form)
-       case 0b1001100000: return E50X(icl)(cpu, op);
+       case 0b1001100000: return E50X(icl);
 
 // ICR  1100001010100000 (S, R, V mode form)
-       case 0b1010100000: return E50X(icr)(cpu, op);
+       case 0b1010100000: return E50X(icr);
 
 // ILE  1100001100001100 (S, R, V mode form)
-       case 0b1100001100: return E50X(ile)(cpu, op);
+       case 0b1100001100: return E50X(ile);
 
 // INT  1100000101101100 (S, R mode form)
-       case 0b0101101100: return E50X(int)(cpu, op);
+       case 0b0101101100: return E50X(int);
 
 // INTA 1100000101011001 (V mode form)
-       case 0b0101011001: return E50X(inta)(cpu, op);
+       case 0b0101011001: return E50X(inta);
 
 // INTL 1100000101011011 (V mode form)
-       case 0b0101011011: return E50X(intl)(cpu, op);
+       case 0b0101011011: return E50X(intl);
 
 // IRX  1100000001001100 (S, R, V mode form)
-       case 0b0001001100: return E50X(irx)(cpu, op);
+       case 0b0001001100: return E50X(irx);
 
 // LCEQ 1100001101000011 (V mode form)
-       case 0b1101000011: return E50X(lceq)(cpu, op);
+       case 0b1101000011: return E50X(lceq);
 
 // LCGE 1100001101000100 (V mode form)
-       case 0b1101000100: return E50X(lcge)(cpu, op);
+       case 0b1101000100: return E50X(lcge);
 
 // LCGT 1100001101000101 (V mode form)
-       case 0b1101000101: return E50X(lcgt)(cpu, op);
+       case 0b1101000101: return E50X(lcgt);
 
 // LCLE 1100001101000001 (V mode form)
-       case 0b1101000001: return E50X(lcle)(cpu, op);
+       case 0b1101000001: return E50X(lcle);
 
 // LCLT 1100001101000000 (V mode form)
-       case 0b1101000000: return E50X(lclt)(cpu, op);
+       case 0b1101000000: return E50X(lclt);
 
 // LCNE 1100001101000010 (V mode form)
-       case 0b1101000010: return E50X(lcne)(cpu, op);
+       case 0b1101000010: return E50X(lcne);
 
 // LEQ  1100000100001011 (S, R, V mode form)
-       case 0b0100001011: return E50X(leq)(cpu, op);
+       case 0b0100001011: return E50X(leq);
 
 #if defined R_MODE || defined V_MODE
 // LFEQ 1100001001001011 (V mode form)
-       case 0b1001001011: return E50X(lfeq)(cpu, op);
+       case 0b1001001011: return E50X(lfeq);
 
 // LFGE 1100001001001100 (V mode form)
-       case 0b1001001100: return E50X(lfge)(cpu, op);
+       case 0b1001001100: return E50X(lfge);
 
 // LFGT 1100001001001101 (V mode form)
-       case 0b1001001101: return E50X(lfgt)(cpu, op);
+       case 0b1001001101: return E50X(lfgt);
 
 // LFLE 1100001001001001 (V mode form)
-       case 0b1001001001: return E50X(lfle)(cpu, op);
+       case 0b1001001001: return E50X(lfle);
 
 // LFLT 1100001001001000 (V mode form)
-       case 0b1001001000: return E50X(lflt)(cpu, op);
+       case 0b1001001000: return E50X(lflt);
 
 // LFNE 1100001001001010 (V mode form)
-       case 0b1001001010: return E50X(lfne)(cpu, op);
+       case 0b1001001010: return E50X(lfne);
 #endif
 
 // LGE  1100000100001100 (S, R, V mode form)
-       case 0b0100001100: return E50X(lge)(cpu, op);
+       case 0b0100001100: return E50X(lge);
 
 // LGT  1100000100001101 (S, R, V mode form)
-       case 0b0100001101: return E50X(lgt)(cpu, op);
+       case 0b0100001101: return E50X(lgt);
 
 // LLE  1100000100001001 (S, R, V mode form)
-       case 0b0100001001: return E50X(lle)(cpu, op);
+       case 0b0100001001: return E50X(lle);
 
 // LLEQ 1100001101001011 (V mode form)
-       case 0b1101001011: return E50X(lleq)(cpu, op);
+       case 0b1101001011: return E50X(lleq);
 
 // LLGE 1100000100001100 (V mode form)
-// LLE case 0b0100001100: return E50X(llge)(cpu, op);
+// LLE case 0b0100001100: return E50X(llge);
 
 // LLGT 1100001101001101 (V mode form)
-       case 0b1101001101: return E50X(llgt)(cpu, op);
+       case 0b1101001101: return E50X(llgt);
 
 // LLLE 1100001101001001 (V mode form)
-       case 0b1101001001: return E50X(llle)(cpu, op);
+       case 0b1101001001: return E50X(llle);
 
 // LLLT 1100000100001000 (V mode form)
-// LLT case 0b0100001000: return E50X(lllt)(cpu, op);
+// LLT case 0b0100001000: return E50X(lllt);
 
 // LLNE 1100001101001010 (V mode form)
-       case 0b1101001010: return E50X(llne)(cpu, op);
+       case 0b1101001010: return E50X(llne);
 
 // LLT  1100000100001000 (S, R, V mode form)
-       case 0b0100001000: return E50X(llt)(cpu, op);
+       case 0b0100001000: return E50X(llt);
 
 // LNE  1100000100001010 (S, R, V mode form)
-       case 0b0100001010: return E50X(lne)(cpu, op);
+       case 0b0100001010: return E50X(lne);
 
 // LF   1100000100001110 (S, R, V mode form)
-       case 0b0100001110: return E50X(lf)(cpu, op);
+       case 0b0100001110: return E50X(lf);
 
 // LT   1100000100001111 (S, R, V mode form)
-       case 0b0100001111: return E50X(lt)(cpu, op);
+       case 0b0100001111: return E50X(lt);
 
 // QFCM 1100000101111000 (V mode form)
-       case 0b0101111000: return E50X(qfcm)(cpu, op);
+       case 0b0101111000: return E50X(qfcm);
 
 // QINQ 1100000101111010 (V mode form)
-       case 0b0101111010: return E50X(qinq)(cpu, op);
+       case 0b0101111010: return E50X(qinq);
 
 // QIQR 1100000101111011 (V mode form)
-       case 0b0101111011: return E50X(qiqr)(cpu, op);
+       case 0b0101111011: return E50X(qiqr);
 
 #ifdef V_MODE
 // RBQ  1100001111001101 AP\32 (V mode form)
-       case 0b1111001101: return E50X(rbq)(cpu, op);
+       case 0b1111001101: return E50X(rbq);
 #endif
 
 // RCB  1100000010000000 (S, R, V mode form)
-       case 0b0010000000: return E50X(rcb)(cpu, op);
+       case 0b0010000000: return E50X(rcb);
 
 #ifdef V_MODE
 // RTQ  1100001111001100 AP\32 (V mode form)
-       case 0b1111001100: return E50X(rtq)(cpu, op);
+       case 0b1111001100: return E50X(rtq);
 #endif
 
 // S1A  1100000001001000 (S, R, V mode form)
-       case 0b0001001000: return E50X(s1a)(cpu, op);
+       case 0b0001001000: return E50X(s1a);
 
 // S2A  1100000011001000 (S, R, V mode form)
-       case 0b0011001000: return E50X(s2a)(cpu, op);
+       case 0b0011001000: return E50X(s2a);
 
 // SCB  1100000110000000 (S, R, V mode form)
-       case 0b0110000000: return E50X(scb)(cpu, op);
+       case 0b0110000000: return E50X(scb);
 
 // SSM  1100000101000000 (S, R, V mode form)
-       case 0b0101000000: return E50X(ssm)(cpu, op);
+       case 0b0101000000: return E50X(ssm);
 
 // SSP  1100000001000000 (S, R, V mode form)
-       case 0b0001000000: return E50X(ssp)(cpu, op);
+       case 0b0001000000: return E50X(ssp);
 
 // TAB  1100000011001100 (V mode form)
-       case 0b0011001100: return E50X(tab)(cpu, op);
+       case 0b0011001100: return E50X(tab);
 
 // TAX  1100000101000100 (V mode form)
-       case 0b0101000100: return E50X(tax)(cpu, op);
+       case 0b0101000100: return E50X(tax);
 
 // TAY  1100000101000101 (V mode form)
-       case 0b0101000101: return E50X(tay)(cpu, op);
+       case 0b0101000101: return E50X(tay);
 
 // TBA  1100000110000100 (V mode form)
-       case 0b0110000100: return E50X(tba)(cpu, op);
+       case 0b0110000100: return E50X(tba);
 
 // TCA  1100000100000111 (S, R, V mode form)
-       case 0b0100000111: return E50X(tca)(cpu, op);
+       case 0b0100000111: return E50X(tca);
 
 // TCL  1100001010001000 (V mode form)
-       case 0b1010001000: return E50X(tcl)(cpu, op);
+       case 0b1010001000: return E50X(tcl);
 
 #ifdef V_MODE
 // TSTQ 1100001111101111 AP\32 (V mode form)
-       case 0b1111101111: return E50X(tstq)(cpu, op);
+       case 0b1111101111: return E50X(tstq);
 #endif
 
 // TXA  1100001000011100 (V mode form)
-       case 0b1000011100: return E50X(txa)(cpu, op);
+       case 0b1000011100: return E50X(txa);
 
 // TYA  1100001001010100 (V mode form)
-       case 0b1001010100: return E50X(tya)(cpu, op);
+       case 0b1001010100: return E50X(tya);
 
 // XCA  1100000001000100 (S, R, V mode form)
-       case 0b0001000100: return E50X(xca)(cpu, op);
+       case 0b0001000100: return E50X(xca);
 
 // XCB  1100000010000100 (S, R, V mode form)
-       case 0b0010000100: return E50X(xcb)(cpu, op);
+       case 0b0010000100: return E50X(xcb);
 
   }
 
-  return E50X(ill)(cpu, op);
+  return E50X(ill);
 }
 
 
 #if defined E16S || defined E32S || defined E32R || defined E64R || defined E64V
-static inline E50I(ix1101_decode)
+static inline E50R(ix1101_decode)
 {
 static const inst_t ix1101_tab[8] = {
 // DFLX I0 1101 11000Y10 BR\2 DISPLACEMENT\16 (V mode form)
@@ -914,11 +914,11 @@ int opcde = (op[0] & 0b01000000) >> 4;
   if(op_is_long(op))
     opcde |= ((op[1] & 0b1100) >> 2);
   
-  return ix1101_tab[opcde](cpu, op);
+  return ix1101_tab[opcde];
 }
 
 
-static inline E50I(ix_decode)
+static inline E50R(ix_decode)
 {
 static const inst_t ix_tab[64] = {
   E50X(uii),
@@ -1144,10 +1144,10 @@ static const inst_t ix_tab[64] = {
 //      I0 1101 11000000 CB\2 DISPLACEMENT\16 (R mode long)
 //      I0 1101 DISPLACEMENT\10 (S mode; R, V mode short)
 // STY  I1 1101 11000Y10 BR\2 DISPLACEMENT\16 (V mode form)
-  E50X(ix1101_decode),
-  E50X(ix1101_decode),
-  E50X(ix1101_decode),
-  E50X(ix1101_decode),
+  NULL,   // ix1101_decode
+  NULL,
+  NULL,
+  NULL,
 // DFMP IX 1110 11000Y10 BR\2 DISPLACEMENT\16 (V mode form)
 //      IX 1110 11000010 CB\2 DISPLACEMENT\16 (R mode form)
 // FMP  IX 1110 11000Y01 BR\2 DISPLACEMENT\16 (V mode long)
@@ -1198,45 +1198,48 @@ static const inst_t ix_tab[64] = {
 };
 int opcde = (op[0] & 0b111100);
 
+  if(opcde == 0b110100)
+    return E50X(ix1101_decode)(op);
+
   if(op_is_long(op))
     opcde |= ((op[1] & 0b1100) >> 2);
   
-  return ix_tab[opcde](cpu, op);
+  return ix_tab[opcde];
 }
 
 
-static E50I(o21)
+static E50R(o21)
 {
 int opcde = ((op[0] & 0b00000011) << 8) | op[1];
 
   switch(opcde)
   {
 // DRN  0100000011000000 (V mode form)
-       case 0b0011000000: return E50X(drn)(cpu, op);
+       case 0b0011000000: return E50X(drn);
 
 // DRNP 0100000011000001 (V mode form)
-       case 0b0011000001: return E50X(drnp)(cpu, op);
+       case 0b0011000001: return E50X(drnp);
 
 // DRNZ 0100000011000010 (V mode form)
-       case 0b0011000010: return E50X(drnz)(cpu, op);
+       case 0b0011000010: return E50X(drnz);
 
 // FRNM 0100000011010000 (V mode form)
-       case 0b0011010000: return E50X(frnm)(cpu, op);
+       case 0b0011010000: return E50X(frnm);
 
 // FRNP 0100000011000011 (V mode form)
-       case 0b0011000011: return E50X(frnp)(cpu, op);
+       case 0b0011000011: return E50X(frnp);
 
 // FRNZ 0100000011010001 (V mode form)
-       case 0b0011010001: return E50X(frnz)(cpu, op);
+       case 0b0011010001: return E50X(frnz);
 
 // SSSN 0100000011001000 (V mode form)
-       case 0b0011001000: return E50X(sssn)(cpu, op);
+       case 0b0011001000: return E50X(sssn);
   }
 
-  return E50X(uii)(cpu, op);
+  return E50X(uii);
 }
 
-static E50I(o20)
+static E50R(o20)
 {
 static const inst_t o20_tab[16] = {
              // 12 3456 7890 123456
@@ -1244,7 +1247,7 @@ static const inst_t o20_tab[16] = {
   E50X(lrl), //         0000
   E50X(lrs), //         0001
   E50X(lrr), //         0010
-  E50X(o21), //         0011
+  NULL,      //         0011 o21
   E50X(arl), //         0100
   E50X(ars), //         0101
   E50X(arr), //         0110
@@ -1259,114 +1262,117 @@ static const inst_t o20_tab[16] = {
   E50X(uii)  //         1111
 };
 int opcde = ((op[0] & 0b00000011) << 2) | ((op[1] & 0b11000000) >> 6);
+
+  if(opcde == 0b0011)
+    return E50X(o21)(op);
   
-  return o20_tab[opcde](cpu, op);
+  return o20_tab[opcde];
 }
 
 
-static E50I(o40)
+static E50R(o40)
 {
 int opcde = ((op[0] & 0b00000011) << 8) | op[1];
 
   switch(opcde)
   {
 // SS1  1000001000010000 (S, R, V mode form)
-       case 0b1000010000: return E50X(ss1)(cpu, op);
+       case 0b1000010000: return E50X(ss1);
 
 // SR1  1000000000010000 (S, R, V mode form)
-       case 0b0000010000: return E50X(sr1)(cpu, op);
+       case 0b0000010000: return E50X(sr1);
 
 // SS2  1000001000001000 (S, R, V mode form)
-       case 0b1000001000: return E50X(ss2)(cpu, op);
+       case 0b1000001000: return E50X(ss2);
 
 // SR2  1000000000001000 (S, R, V mode form)
-       case 0b0000001000: return E50X(sr2)(cpu, op);
+       case 0b0000001000: return E50X(sr2);
 
 // SR3  1000000000000100 (S, R, V mode form)
-       case 0b0000000100: return E50X(sr3)(cpu, op);
+       case 0b0000000100: return E50X(sr3);
 
 // SS3  1000001000000100 (S, R, V mode form)
-       case 0b1000000100: return E50X(ss3)(cpu, op);
+       case 0b1000000100: return E50X(ss3);
 
 // SS4  1000001000000010 (S, R, V mode form)
-       case 0b1000000010: return E50X(ss4)(cpu, op);
+       case 0b1000000010: return E50X(ss4);
 
 // SR4  1000000000000010 (S, R, V mode form)
-       case 0b0000000010: return E50X(sr4)(cpu, op);
+       case 0b0000000010: return E50X(sr4);
 
 // SSS  1000001000011110 (S, R, V mode form)
-       case 0b1000011110: return E50X(sss)(cpu, op);
+       case 0b1000011110: return E50X(sss);
 
 // SSR  1000000000011110 (S, R, V mode form)
-       case 0b0000011110: return E50X(ssr)(cpu, op);
+       case 0b0000011110: return E50X(ssr);
 
 // NOP  1000001000000000 (S, R, V mode form)
-       case 0b1000000000: return E50X(nop)(cpu, op);
+       case 0b1000000000: return E50X(nop);
 
 // SGT  1000000010010000 (S, R, V mode form)
-       case 0b0010010000: return E50X(sgt)(cpu, op);
+       case 0b0010010000: return E50X(sgt);
 
 // SKP  1000000000000000 (S, R, V mode form)
-       case 0b0000000000: return E50X(skp)(cpu, op);
+       case 0b0000000000: return E50X(skp);
 
 // SLE  1000001010010000 (S, R, V mode form)
-       case 0b1010010000: return E50X(sle)(cpu, op);
+       case 0b1010010000: return E50X(sle);
 
 // SLN  1000001001000000 (S, R, V mode form)
-       case 0b1001000000: return E50X(sln)(cpu, op);
+       case 0b1001000000: return E50X(sln);
 
 // SLZ  1000000001000000 (S, R, V mode form)
-       case 0b0001000000: return E50X(slz)(cpu, op);
+       case 0b0001000000: return E50X(slz);
 
 // SMCR 1000000010000000 (S, R, V mode form)
-       case 0b0010000000: return E50X(smcr)(cpu, op);
+       case 0b0010000000: return E50X(smcr);
 
 // SMCS 1000001010000000 (S, R, V mode form)
-       case 0b1010000000: return E50X(smcs)(cpu, op);
+       case 0b1010000000: return E50X(smcs);
 
 // SMI  1000001100000000 (S, R, V mode form) -- also slt
-       case 0b1100000000: return E50X(smi)(cpu, op);
+       case 0b1100000000: return E50X(smi);
 
 // SNZ  1000001000100000 (S, R, V mode form) -- also sne
-       case 0b1000100000: return E50X(snz)(cpu, op);
+       case 0b1000100000: return E50X(snz);
 
 // SPL  1000000100000000 (S, R, V mode form) -- also sge
-       case 0b0100000000: return E50X(spl)(cpu, op);
+       case 0b0100000000: return E50X(spl);
 
 // SRC  1000000000000001 (S, R, V mode form)
-       case 0b0000000001: return E50X(src)(cpu, op);
+       case 0b0000000001: return E50X(src);
 
 // SSC  1000001000000001 (S, R, V mode form)
-       case 0b1000000001: return E50X(ssc)(cpu, op);
+       case 0b1000000001: return E50X(ssc);
 
 // SZE  1000000000100000 (S, R, V mode form) -- also seq
-       case 0b0000100000: return E50X(sze)(cpu, op);
+       case 0b0000100000: return E50X(sze);
 
     default:
       switch((opcde & 0b1111110000))
       {
 // SAR  100000001011 N\4 (S, R, V mode form)
-       case 0b0010110000: return E50X(sar)(cpu, op);
+       case 0b0010110000: return E50X(sar);
 
 // SAS  100000101011 N\4 (S, R, V mode form)
-       case 0b1010110000: return E50X(sas)(cpu, op);
+       case 0b1010110000: return E50X(sas);
 
 // SNR  100000001010 N\4 (S, R, V mode form)
-       case 0b0010100000: return E50X(snr)(cpu, op);
+       case 0b0010100000: return E50X(snr);
 
 // SNS  100000101010 N\4 (S, R, V mode form)
-       case 0b1010100000: return E50X(sns)(cpu, op);
+       case 0b1010100000: return E50X(sns);
       }
 
   }
 
-  return E50X(uii)(cpu, op);
+  return E50X(uii);
 }
 
 
-E50I(decode)
+E50R(resolve)
 {
-static const inst_t ix_tab[4] = {
+static const decode_t ix_tab[4] = {
   E50X(o00),  // 00 0000 Generic B Instructions
   E50X(o20),  // 01 0000 Shift Instructions
   E50X(o40),  // 10 0000 Skip Instructions
@@ -1375,15 +1381,15 @@ static const inst_t ix_tab[4] = {
 int opcde = op[0] >> 6;
 
   if((op[0] & 0b00111100) == 0)
-    return ix_tab[opcde](cpu, op);
+    return ix_tab[opcde](op);
   else
-    return E50X(ix_decode)(cpu, op);
+    return E50X(ix_decode)(op);
 }
 
 #elif defined E32I
 
 
-static E50I(o06)
+static E50R(o06)
 {
 static const inst_t op_tab[8] = {
   E50X(fl),    // 000 0F0
@@ -1397,11 +1403,11 @@ static const inst_t op_tab[8] = {
 };
 int opcde = ((op[0] & 0b11) << 1) | (op[1] >> 7);
 
-  return op_tab[opcde](cpu, op);
+  return op_tab[opcde];
 }
 
 
-static E50I(o10)
+static E50R(o10)
 {
 int opcde = ((op[0] & 0b11) << 8) | op[1];
 
@@ -1409,117 +1415,117 @@ int opcde = ((op[0] & 0b11) << 8) | op[1];
 
 // BFEQ 0010000 F 01010010 ADDRESS\16
          case 0b0001010010:
-         case 0b0101010010: return E50X(bfeq)(cpu, op);
+         case 0b0101010010: return E50X(bfeq);
 
 // BFGE 0010000 F 01010101 ADDRESS\16
          case 0b0001010101:
-         case 0b0101010101: return E50X(bfge)(cpu, op);
+         case 0b0101010101: return E50X(bfge);
 
 // BFGT 0010000 F 01010001 ADDRESS\16
          case 0b0001010001:
-         case 0b0101010001: return E50X(bfgt)(cpu, op);
+         case 0b0101010001: return E50X(bfgt);
 
 // BFLE 0010000 F 01010000 ADDRESS\16
          case 0b0001010000:
-         case 0b0101010000: return E50X(bfle)(cpu, op);
+         case 0b0101010000: return E50X(bfle);
 
 // BFLT 0010000 F 01010100 ADDRESS\16
          case 0b0001010100:
-         case 0b0101010100: return E50X(bflt)(cpu, op);
+         case 0b0101010100: return E50X(bflt);
 
 // BFNE 0010000 F 01010011 ADDRESS\16
          case 0b0001010011:
-         case 0b0101010011: return E50X(bfne)(cpu, op);
+         case 0b0101010011: return E50X(bfne);
 
     default: switch(opcde & 0b01111111) {
 
 // BHD1 001000 R\3 1100100 ADDRESS\16
-            case 0b1100100: return E50X(bhd1)(cpu, op);
+            case 0b1100100: return E50X(bhd1);
 
 // BHD2 001000 R\3 1100101 ADDRESS\16
-            case 0b1100101: return E50X(bhd2)(cpu, op);
+            case 0b1100101: return E50X(bhd2);
 
 // BHD4 001000 R\3 1100110 ADDRESS\16
-            case 0b1100110: return E50X(bhd4)(cpu, op);
+            case 0b1100110: return E50X(bhd4);
 
 // BHEQ 001000 R\3 1001010 ADDRESS\16
-            case 0b1001010: return E50X(bheq)(cpu, op);
+            case 0b1001010: return E50X(bheq);
 
 // BHGE 001000 R\3 1010101 ADDRESS\16
-            case 0b1010101: return E50X(bhge)(cpu, op);
+            case 0b1010101: return E50X(bhge);
 
 // BHGT 001000 R\3 1001001 ADDRESS\16
-            case 0b1001001: return E50X(bhgt)(cpu, op);
+            case 0b1001001: return E50X(bhgt);
 
 // BHLE 001000 R\3 1001000 ADDRESS\16
-            case 0b1001000: return E50X(bhle)(cpu, op);
+            case 0b1001000: return E50X(bhle);
 
 // BHLT 001000 R\3 1001100 ADDRESS\16
-            case 0b1001100: return E50X(bhlt)(cpu, op);
+            case 0b1001100: return E50X(bhlt);
 
 // BHNE 001000 R\3 1001011 ADDRESS\16
-            case 0b1001011: return E50X(bhne)(cpu, op);
+            case 0b1001011: return E50X(bhne);
 
 // BHI1 001000 R\3 1100000 ADDRESS\16
-            case 0b1100000: return E50X(bhi1)(cpu, op);
+            case 0b1100000: return E50X(bhi1);
 
 // BHI2 001000 R\3 1100001 ADDRESS\16
-            case 0b1100001: return E50X(bhi2)(cpu, op);
+            case 0b1100001: return E50X(bhi2);
 
 // BHI4 001000 R\3 1100010 ADDRESS\16
-            case 0b1100010: return E50X(bhi4)(cpu, op);
+            case 0b1100010: return E50X(bhi4);
 
 // BRD1 001000 R\3 1011100 ADDRESS\16
-            case 0b1011100: return E50X(brd1)(cpu, op);
+            case 0b1011100: return E50X(brd1);
 
 // BRD2 001000 R\3 1011101 ADDRESS\16
-            case 0b1011101: return E50X(brd2)(cpu, op);
+            case 0b1011101: return E50X(brd2);
 
 // BRD4 001000 R\3 1011110 ADDRESS\16
-            case 0b1011110: return E50X(brd4)(cpu, op);
+            case 0b1011110: return E50X(brd4);
 
 // BREQ 001000 R\3 1000010 ADDRESS\16
-            case 0b1000010: return E50X(breq)(cpu, op);
+            case 0b1000010: return E50X(breq);
 
 // BRGT 001000 R\3 1000001 ADDRESS\16
-            case 0b1000001: return E50X(brgt)(cpu, op);
+            case 0b1000001: return E50X(brgt);
 
 // BRGE 001000 R\3 1000101 ADDRESS\16
-            case 0b1000101: return E50X(brge)(cpu, op);
+            case 0b1000101: return E50X(brge);
 
 // BRLE 001000 R\3 1000000 ADDRESS\16
-            case 0b1000000: return E50X(brle)(cpu, op);
+            case 0b1000000: return E50X(brle);
 
 // BRLT 001000 R\3 1000100 ADDRESS\16
-            case 0b1000100: return E50X(brlt)(cpu, op);
+            case 0b1000100: return E50X(brlt);
 
 // BRNE 001000 R\3 1000011 ADDRESS\16
-            case 0b1000011: return E50X(brne)(cpu, op);
+            case 0b1000011: return E50X(brne);
 
 // BRI1 001000 R\3 1011000 ADDRESS\16
-            case 0b1011000: return E50X(bri1)(cpu, op);
+            case 0b1011000: return E50X(bri1);
 
 // BRI2 001000 R\3 1011001 ADDRESS\16
-            case 0b1011001: return E50X(bri2)(cpu, op);
+            case 0b1011001: return E50X(bri2);
 
 // BRI4 001000 R\3 1011010 ADDRESS\16
-            case 0b1011010: return E50X(bri4)(cpu, op);
+            case 0b1011010: return E50X(bri4);
 
     default: switch(opcde & 0b01100000) {
 // BRBR 001000 R\3 01 BT\5 ADDRESS\16
-            case 0b0100000: return E50X(brbr)(cpu, op);
+            case 0b0100000: return E50X(brbr);
 
 // BRBS 001000 R\3 00 BT\5 ADDRESS\16
-            case 0b0000000: return E50X(brbs)(cpu, op);
+            case 0b0000000: return E50X(brbs);
 
-            default:        return E50X(uii)(cpu, op);
+            default:        return E50X(uii);
       }
     } 
   }
 }
 
 
-static E50I(o16)
+static E50R(o16)
 {
 static const inst_t op_tab[8] = {
   E50X(fst),   // 000 0F0
@@ -1533,35 +1539,35 @@ static const inst_t op_tab[8] = {
 };
 int opcde = ((op[0] & 0b11) << 1) | (op[1] >> 7);
 
-  return op_tab[opcde](cpu, op);
+  return op_tab[opcde];
 }
 
 
-static E50I(o20)
+static E50R(o20)
 {
 int opcde = ((op[0] & 0b00000011) << 8) | op[1];
 
   switch(opcde)
   {
 // DRNZ 0100000011000010 (I mode form)
-       case 0b0011000010: return E50X(drnz)(cpu, op);
+       case 0b0011000010: return E50X(drnz);
 
 // DRN  0100000011000000 (I mode form)
-       case 0b0011000000: return E50X(drn)(cpu, op);
+       case 0b0011000000: return E50X(drn);
 
 // DRNP 0100000011000001 (I mode form)
-       case 0b0011000001: return E50X(drnp)(cpu, op);
+       case 0b0011000001: return E50X(drnp);
 
 // SSSN 0100000011001000 (I mode form)
-       case 0b0011001000: return E50X(sssn)(cpu, op);
+       case 0b0011001000: return E50X(sssn);
 
   }
 
-  return E50X(uii)(cpu, op);
+  return E50X(uii);
 }
 
 
-static E50I(o26)
+static E50R(o26)
 {
 static const inst_t op_tab[8] = {
   E50X(fs),    // 000 0F0
@@ -1575,325 +1581,325 @@ static const inst_t op_tab[8] = {
 };
 int opcde = ((op[0] & 0b11) << 1) | (op[1] >> 7);
 
-  return op_tab[opcde](cpu, op);
+  return op_tab[opcde];
 }
 
 
-static E50I(o30)
+static E50R(o30)
 {
 int opcde = op[1] & 0b01111111;
 
   switch(opcde) {
 
 // ABQ  011000 R\3 1011100
-            case 0b1011100: return E50X(abq)(cpu, op);
+            case 0b1011100: return E50X(abq);
 
 // ADLR 011000 R\3 0001100
-            case 0b0001100: return E50X(adlr)(cpu, op);
+            case 0b0001100: return E50X(adlr);
 
 // ARFA 011000 R\3 111 FAR 001
             case 0b1110001:
-            case 0b1111001: return E50X(arfa)(cpu, op);
+            case 0b1111001: return E50X(arfa);
 
 // ATQ  011000 R\3 1011101
-            case 0b1011101: return E50X(atq)(cpu, op);
+            case 0b1011101: return E50X(atq);
 
 // CGT  011000 R\3 0010110
-            case 0b0010110: return E50X(cgt)(cpu, op);
+            case 0b0010110: return E50X(cgt);
 
 // CHS  011000 R\3 0100000
-            case 0b0100000: return E50X(chs)(cpu, op);
+            case 0b0100000: return E50X(chs);
 
 // CMH  011000 R\3 0100101
-            case 0b0100101: return E50X(cmh)(cpu, op);
+            case 0b0100101: return E50X(cmh);
 
 // CMR  011000 R\3 0100100
-            case 0b0100100: return E50X(cmr)(cpu, op);
+            case 0b0100100: return E50X(cmr);
 
 // CR   011000 R\3 0101110
-            case 0b0101110: return E50X(cr)(cpu, op);
+            case 0b0101110: return E50X(cr);
 
 // CRBL 011000 R\3 0110010
-            case 0b0110010: return E50X(crbl)(cpu, op);
+            case 0b0110010: return E50X(crbl);
 
 // CRBR 011000 R\3 0110011
-            case 0b0110011: return E50X(crbr)(cpu, op);
+            case 0b0110011: return E50X(crbr);
 
 // CRHL 011000 R\3 0101100
-            case 0b0101100: return E50X(crhl)(cpu, op);
+            case 0b0101100: return E50X(crhl);
 
 // CRHR 011000 R\3 0101101
-            case 0b0101101: return E50X(crhr)(cpu, op);
+            case 0b0101101: return E50X(crhr);
 
 // CSR  011000 R\3 0100001
-            case 0b0100001: return E50X(csr)(cpu, op);
+            case 0b0100001: return E50X(csr);
 
 // DH1  011000 R\3 1011000
-            case 0b1011000: return E50X(dh1)(cpu, op);
+            case 0b1011000: return E50X(dh1);
 
 // DH2  011000 R\3 1011001
-            case 0b1011001: return E50X(dh2)(cpu, op);
+            case 0b1011001: return E50X(dh2);
 
 // DR1  011000 R\3 1010100
-            case 0b1010100: return E50X(dr1)(cpu, op);
+            case 0b1010100: return E50X(dr1);
 
 // DR2  011000 R\3 1010101
-            case 0b1010101: return E50X(dr2)(cpu, op);
+            case 0b1010101: return E50X(dr2);
 
 // INK  011000 R\3 0111000
-            case 0b0111000: return E50X(ink)(cpu, op);
+            case 0b0111000: return E50X(ink);
 
 // LF   011000 R\3 0001110
-            case 0b0001110: return E50X(lf)(cpu, op);
+            case 0b0001110: return E50X(lf);
 
 // LT   011000 R\3 0001111
-            case 0b0001111: return E50X(lt)(cpu, op);
+            case 0b0001111: return E50X(lt);
 
 // LNE  011000 R\3 0000010
-            case 0b0000010: return E50X(lne)(cpu, op);
+            case 0b0000010: return E50X(lne);
 
 // LEQ  011000 R\3 0000011
-            case 0b0000011: return E50X(leq)(cpu, op);
+            case 0b0000011: return E50X(leq);
 
 // LGE  011000 R\3 0000100
-// LHGE     case 0b0000100: return E50X(lge)(cpu, op);
+// LHGE     case 0b0000100: return E50X(lge);
 
 // LGT  011000 R\3 0000101
-            case 0b0000101: return E50X(lgt)(cpu, op);
+            case 0b0000101: return E50X(lgt);
 
 // LLE  011000 R\3 0000001
-            case 0b0000001: return E50X(lle)(cpu, op);
+            case 0b0000001: return E50X(lle);
 
 // LLT  011000 R\3 0000000
-// LHLT     case 0b0000000: return E50X(llt)(cpu, op);
+// LHLT     case 0b0000000: return E50X(llt);
 
 // LCEQ 011000 R\3 1101011
-            case 0b1101011: return E50X(lceq)(cpu, op);
+            case 0b1101011: return E50X(lceq);
 
 // LCGE 011000 R\3 1101100
-            case 0b1101100: return E50X(lcge)(cpu, op);
+            case 0b1101100: return E50X(lcge);
 
 // LCGT 011000 R\3 1101101
-            case 0b1101101: return E50X(lcgt)(cpu, op);
+            case 0b1101101: return E50X(lcgt);
 
 // LCLE 011000 R\3 1101001
-            case 0b1101001: return E50X(lcle)(cpu, op);
+            case 0b1101001: return E50X(lcle);
 
 // LCLT 011000 R\3 1101000
-            case 0b1101000: return E50X(lclt)(cpu, op);
+            case 0b1101000: return E50X(lclt);
 
 // LCNE 011000 R\3 1101010
-            case 0b1101010: return E50X(lcne)(cpu, op);
+            case 0b1101010: return E50X(lcne);
 
 // LHEQ 011000 R\3 0001011
-            case 0b0001011: return E50X(lheq)(cpu, op);
+            case 0b0001011: return E50X(lheq);
 
 // LHGE 011000 R\3 0000100
-            case 0b0000100: return E50X(lhge)(cpu, op);
+            case 0b0000100: return E50X(lhge);
 
 // LHGT 011000 R\3 0001101
-            case 0b0001101: return E50X(lhgt)(cpu, op);
+            case 0b0001101: return E50X(lhgt);
 
 // LHLE 011000 R\3 0001001
-            case 0b0001001: return E50X(lhle)(cpu, op);
+            case 0b0001001: return E50X(lhle);
 
 // LHLT 011000 R\3 0000000
-            case 0b0000000: return E50X(lhlt)(cpu, op);
+            case 0b0000000: return E50X(lhlt);
 
 // LHNE 011000 R\3 0001010
-            case 0b0001010: return E50X(lhne)(cpu, op);
+            case 0b0001010: return E50X(lhne);
 
 // LFEQ 011000 R\3 001F011
             case 0b0010011:
-            case 0b0011011: return E50X(lfeq)(cpu, op);
+            case 0b0011011: return E50X(lfeq);
 
 // LFGE 011000 R\3 001F100
             case 0b0010100:
-            case 0b0011100: return E50X(lfge)(cpu, op);
+            case 0b0011100: return E50X(lfge);
 
 // LFGT 011000 R\3 001F101
             case 0b0010101:
-            case 0b0011101: return E50X(lfgt)(cpu, op);
+            case 0b0011101: return E50X(lfgt);
 
 // LFLE 011000 R\3 001F001
             case 0b0010001:
-            case 0b0011001: return E50X(lfle)(cpu, op);
+            case 0b0011001: return E50X(lfle);
 
 // LFLT 011000 R\3 001F000
             case 0b0010000:
-            case 0b0011000: return E50X(lflt)(cpu, op);
+            case 0b0011000: return E50X(lflt);
 
 // LFNE 011000 R\3 001F010
             case 0b0010010:
-            case 0b0011010: return E50X(lfne)(cpu, op);
+            case 0b0011010: return E50X(lfne);
 
 // ICBL 011000 R\3 0110101
-            case 0b0110101: return E50X(icbl)(cpu, op);
+            case 0b0110101: return E50X(icbl);
 
 // ICBR 011000 R\3 0110110
-            case 0b0110110: return E50X(icbr)(cpu, op);
+            case 0b0110110: return E50X(icbr);
 
 // ICHL 011000 R\3 0110000
-            case 0b0110000: return E50X(ichl)(cpu, op);
+            case 0b0110000: return E50X(ichl);
 
 // ICHR 011000 R\3 0110001
-            case 0b0110001: return E50X(ichr)(cpu, op);
+            case 0b0110001: return E50X(ichr);
 
 // IH1  011000 R\3 1010110
-            case 0b1010110: return E50X(ih1)(cpu, op);
+            case 0b1010110: return E50X(ih1);
 
 // IH2  011000 R\3 1010111
-            case 0b1010111: return E50X(ih2)(cpu, op);
+            case 0b1010111: return E50X(ih2);
 
 // IR1  011000 R\3 1010010
-            case 0b1010010: return E50X(ir1)(cpu, op);
+            case 0b1010010: return E50X(ir1);
 
 // IR2  011000 R\3 1010011
-            case 0b1010011: return E50X(ir2)(cpu, op);
+            case 0b1010011: return E50X(ir2);
 
 // IRB  011000 R\3 0110100
-            case 0b0110100: return E50X(irb)(cpu, op);
+            case 0b0110100: return E50X(irb);
 
 // IRH  011000 R\3 0101111
-            case 0b0101111: return E50X(irh)(cpu, op);
+            case 0b0101111: return E50X(irh);
 
 // OTK  011000 R\3 0111001
-            case 0b0111001: return E50X(otk)(cpu, op);
+            case 0b0111001: return E50X(otk);
 
 // PID  011000 R\3 0101010
-            case 0b0101010: return E50X(pid)(cpu, op);
+            case 0b0101010: return E50X(pid);
 
 // PIDH 011000 R\3 0101011
-            case 0b0101011: return E50X(pidh)(cpu, op);
+            case 0b0101011: return E50X(pidh);
 
 // PIM  011000 R\3 0101000
-            case 0b0101000: return E50X(pim)(cpu, op);
+            case 0b0101000: return E50X(pim);
 
 // PIMH 011000 R\3 0101001
-            case 0b0101001: return E50X(pimh)(cpu, op);
+            case 0b0101001: return E50X(pimh);
 
 // RBQ  011000 R\3 1011011
-            case 0b1011011: return E50X(rbq)(cpu, op);
+            case 0b1011011: return E50X(rbq);
 
 // RTQ  011000 R\3 1011010
-            case 0b1011010: return E50X(rtq)(cpu, op);
+            case 0b1011010: return E50X(rtq);
 
 // SHL1 011000 R\3 0111110
-            case 0b0111110: return E50X(shl1)(cpu, op);
+            case 0b0111110: return E50X(shl1);
 
 // SHL2 011000 R\3 0111111
-            case 0b0111111: return E50X(shl2)(cpu, op);
+            case 0b0111111: return E50X(shl2);
 
 // SHR1 011000 R\3 1010000
-            case 0b1010000: return E50X(shr1)(cpu, op);
+            case 0b1010000: return E50X(shr1);
 
 // SHR2 011000 R\3 1010001
-            case 0b1010001: return E50X(shr2)(cpu, op);
+            case 0b1010001: return E50X(shr2);
 
 // SL1  011000 R\3 0111010
-            case 0b0111010: return E50X(sl1)(cpu, op);
+            case 0b0111010: return E50X(sl1);
 
 // SL2  011000 R\3 0111011
-            case 0b0111011: return E50X(sl2)(cpu, op);
+            case 0b0111011: return E50X(sl2);
 
 // SR1  011000 R\3 0111100
-            case 0b0111100: return E50X(sr1)(cpu, op);
+            case 0b0111100: return E50X(sr1);
 
 // SR2  011000 R\3 0111101
-            case 0b0111101: return E50X(sr2)(cpu, op);
+            case 0b0111101: return E50X(sr2);
 
 // SSM  011000 R\3 0100010
-            case 0b0100010: return E50X(ssm)(cpu, op);
+            case 0b0100010: return E50X(ssm);
 
 // SSP  011000 R\3 0100011
-            case 0b0100011: return E50X(ssp)(cpu, op);
+            case 0b0100011: return E50X(ssp);
 
 // STEX 011000 R\3 0010111
-            case 0b0010111: return E50X(stex)(cpu, op);
+            case 0b0010111: return E50X(stex);
 
 // TC   011000 R\3 0100110
-            case 0b0100110: return E50X(tc)(cpu, op);
+            case 0b0100110: return E50X(tc);
 
 // TCH  011000 R\3 0100111
-            case 0b0100111: return E50X(tch)(cpu, op);
+            case 0b0100111: return E50X(tch);
 
 // TFLR 011000 R\3 111 FLR 101
             case 0b1110011:
-            case 0b1111011: return E50X(tflr)(cpu, op);
+            case 0b1111011: return E50X(tflr);
 
 // TRFL 011000 R\3 111 FLR 101
             case 0b1110101:
-            case 0b1111101: return E50X(trfl)(cpu, op);
+            case 0b1111101: return E50X(trfl);
 
 // TSTQ 011000 R\3 1000100
-            case 0b1000100: return E50X(tstq)(cpu, op);
+            case 0b1000100: return E50X(tstq);
 
 // LDC  011000 R\3 111 FLR 010
             case 0b1110010:
-            case 0b1111010: return E50X(ldc)(cpu, op);
+            case 0b1111010: return E50X(ldc);
 
 // STC  011000 R\3 111 FLR 110
             case 0b1110110:
-            case 0b1111110: return E50X(stc)(cpu, op);
+            case 0b1111110: return E50X(stc);
 
 // STCD 011000 R\3 1011111
-            case 0b1011111: return E50X(stcd)(cpu, op);
+            case 0b1011111: return E50X(stcd);
 
 // STCH 011000 R\3 1011111
-            case 0b1011110: return E50X(stch)(cpu, op);
+            case 0b1011110: return E50X(stch);
 
 // FCM  011000 0F0 1000000
-            case 0b1000000: return E50X(fcm)(cpu, op);
+            case 0b1000000: return E50X(fcm);
 
 // DFCM 011000 0F0 1100100
-            case 0b1100100: return E50X(dfcm)(cpu, op);
+            case 0b1100100: return E50X(dfcm);
 
 // FRN  011000 0F0 1000111
-            case 0b1000111: return E50X(frn)(cpu, op);
+            case 0b1000111: return E50X(frn);
 
 // FRNM 011000 0F0 1100110
-            case 0b1100110: return E50X(frnm)(cpu, op);
+            case 0b1100110: return E50X(frnm);
 
 // FRNP 011000 0F0 1100101
-            case 0b1100101: return E50X(frnp)(cpu, op);
+            case 0b1100101: return E50X(frnp);
 
 // FRNZ 011000 0F0 1100111
-            case 0b1100111: return E50X(frnz)(cpu, op);
+            case 0b1100111: return E50X(frnz);
 
 // DBLE 011000 0F0 1100110
-            case 0b1000110: return E50X(dble)(cpu, op);
+            case 0b1000110: return E50X(dble);
 
 // FLT  011000 R\3 100F101
             case 0b1000101:
-            case 0b1001101: return E50X(flt)(cpu, op);
+            case 0b1001101: return E50X(flt);
 
 // FLTH 011000 R\3 100F010
             case 0b1000010:
-            case 0b1001010: return E50X(flth)(cpu, op);
+            case 0b1001010: return E50X(flth);
 
 // INT  011000 R\3 100F011
             case 0b1000011:
-            case 0b1001011: return E50X(int)(cpu, op);
+            case 0b1001011: return E50X(int);
 
 // INTH 011000 R\3 100F001
             case 0b1000001:
-            case 0b1001001: return E50X(inth)(cpu, op);
+            case 0b1001001: return E50X(inth);
 
 // ICP  011000 R\3 1110111
-            case 0b1110111: return E50X(icp)(cpu, op);
+            case 0b1110111: return E50X(icp);
 
 // DCP  011000 R\3 1110000
-            case 0b1110000: return E50X(dcp)(cpu, op);
+            case 0b1110000: return E50X(dcp);
 
 // TCNP 011000 R\3 1111000
-            case 0b1111000: return E50X(tcnpr)(cpu, op);
+            case 0b1111000: return E50X(tcnpr);
 
-    default: return E50X(uii)(cpu, op);
+    default: return E50X(uii);
   }
 }
 
 
-static E50I(o36)
+static E50R(o36)
 {
 static const inst_t op_tab[8] = {
   E50X(fd),    // 000 0F0
@@ -1907,11 +1913,11 @@ static const inst_t op_tab[8] = {
 };
 int opcde = ((op[0] & 0b11) << 1) | (op[1] >> 7);
 
-  return op_tab[opcde](cpu, op);
+  return op_tab[opcde];
 }
 
 
-static E50I(o46)
+static E50R(o46)
 {
 static inst_t op_tab[8] = {
   E50X(im),      // 100110 000 
@@ -1926,11 +1932,11 @@ static inst_t op_tab[8] = {
 
 int opcde = ((op[0] & 0b11) << 1) | (op[1] >> 7);
 
-  return op_tab[opcde](cpu, op);
+  return op_tab[opcde];
 }
 
 
-static E50I(o56)
+static E50R(o56)
 {
 static inst_t op_tab[8] = {
   E50X(imh),     // 101110 000 
@@ -1945,11 +1951,11 @@ static inst_t op_tab[8] = {
 
 int opcde = ((op[0] & 0b11) << 1) | (op[1] >> 7);
 
-  return op_tab[opcde](cpu, op);
+  return op_tab[opcde];
 }
 
 
-static E50I(o66)
+static E50R(o66)
 {
 static inst_t op_tab[8] = {
   E50X(dm),      // 110110 000 
@@ -1964,11 +1970,11 @@ static inst_t op_tab[8] = {
 
 int opcde = ((op[0] & 0b11) << 1) | (op[1] >> 7);
 
-  return op_tab[opcde](cpu, op);
+  return op_tab[opcde];
 }
 
 
-static E50I(o76)
+static E50R(o76)
 {
 static inst_t op_tab[8] = {
   E50X(dmh),     // 111110 000 
@@ -1983,44 +1989,59 @@ static inst_t op_tab[8] = {
 
 int opcde = ((op[0] & 0b11) << 1) | (op[1] >> 7);
 
-  return op_tab[opcde](cpu, op);
+  return op_tab[opcde];
 }
 
 
-E50I(decode)
+E50R(resolve)
 {
+static const decode_t dc_tab[64] = {
+  [000] = E50X(o00),
+  [006] = E50X(o06),
+  [010] = E50X(o10),
+  [016] = E50X(o16),
+  [020] = E50X(o20),
+  [026] = E50X(o26),
+  [030] = E50X(o30),
+  [036] = E50X(o36),
+  [046] = E50X(o46),
+  [056] = E50X(o56),
+  [060] = E50X(o60),
+  [066] = E50X(o66),
+  [076] = E50X(o76)
+};
 static const inst_t op_tab[64] = {
-  E50X(o00),     // 000000
+  NULL,          // 000000
   E50X(l),       // 000001
   E50X(a),       // 000010
   E50X(n),       // 000011
   E50X(lhl1),    // 000100
   E50X(shl),     // 000101
-  E50X(o06),     // 000110
+  NULL,          // 000110
   E50X(uii),     // 000111
-  E50X(o10),     // 001000
+  NULL,          // 001000
   E50X(lh),      // 001001
   E50X(ah),      // 001010
   E50X(nh),      // 001011
   E50X(lhl2),    // 001100
   E50X(sha),     // 001101
-  E50X(o16),     // 001110
+  NULL,          // 001110
   E50X(uii),     // 001111
-  E50X(o20),     // 010000
+  NULL,          // 010000
   E50X(st),      // 010001
   E50X(s),       // 010010
   E50X(o),       // 010011
   E50X(rot),     // 010100
   E50X(uii),     // 010101
-  E50X(o26),     // 010110
+  NULL,          // 010110
   E50X(uii),     // 010111
-  E50X(o30),     // 011000
+  NULL,          // 011000
   E50X(sth),     // 011001
   E50X(sh),      // 011010
   E50X(oh),      // 011011
   E50X(eio),     // 011100
   E50X(lhl3),    // 011101
-  E50X(o36),     // 011110
+  NULL,          // 011110
   E50X(uii),     // 011111
   E50X(uii),     // 100000
   E50X(i),       // 100001
@@ -2028,7 +2049,7 @@ static const inst_t op_tab[64] = {
   E50X(x),       // 100011
   E50X(ldar),    // 100100
   E50X(lcc_ccp), // 100101
-  E50X(o46),     // 100110
+  NULL,          // 100110
   E50X(uii),     // 100111
   E50X(uii),     // 101000
   E50X(ih),      // 101001
@@ -2036,15 +2057,15 @@ static const inst_t op_tab[64] = {
   E50X(xh),      // 101011
   E50X(star),    // 101100
   E50X(scc_acp), // 101101
-  E50X(o56),     // 101110
+  NULL,          // 101110
   E50X(uii),     // 101111
-  E50X(o60),     // 110000
+  NULL,          // 110000
   E50X(c),       // 110001
   E50X(d),       // 110010
   E50X(ear),     // 110011
   E50X(uii),     // 110100
   E50X(lip),     // 110101
-  E50X(o66),     // 110110
+  NULL,          // 110110
   E50X(uii),     // 110111
   E50X(uii),     // 111000
   E50X(ch),      // 111001
@@ -2052,16 +2073,38 @@ static const inst_t op_tab[64] = {
   E50X(jsr),     // 111011
   E50X(uii),     // 111100
   E50X(aip),     // 111101
-  E50X(o76),     // 111110
+  NULL,          // 111110
   E50X(uii)      // 111111
 };
 int opcde = op[0] >> 2;
 
-  return op_tab[opcde](cpu, op);
+  if(dc_tab[opcde])
+    return dc_tab[opcde](op);
+
+  return op_tab[opcde];
 }
 #endif
 
 
+inst_t E50X(dispatch)[0x10000];
+
+
+void E50X(decode_init)(void)
+{
+  for(int w = 0; w < 0x10000; ++w)
+  {
+    uint8_t op[2] = { w >> 8, w & 0xff };
+    E50X(dispatch)[w] = E50X(resolve)(op);
+  }
+}
+
+
+E50I(decode)
+{
+  E50X(dispatch)[(op[0] << 8) | op[1]](cpu, op);
+}
+
+
 #ifndef EMDE
  #include __FILE__
 #endif
@@ -32,6 +32,8 @@
 #include "ea.h"
 
 
+extern inst_t E50X(dispatch)[0x10000];
+E50R(resolve);
 E50I(decode);
 E50I(eio);
 E50I(pio);
@@ -124,7 +126,7 @@ E50I(cai);
          "-> pb %8.8x sb %8.8x lb %8.8x xb %8.8x\n", \
          G_R(_c, 0), G_R(_c, 1), G_R(_c, 2), G_R(_c, 3), \
          G_R(_c, 4), G_R(_c, 5), G_R(_c, 6), G_R(_c, 7), \
-         (_c)->crs->km.cbit, (_c)->crs->km.link,(_c)->crs->km.eq,(_c)->crs->km.lt, \
+         (_c)->crs->km.cbit, CC_LINK(_c), CC_EQ(_c), CC_LT(_c), \
          (_c)->crs->km.dp, (_c)->crs->km.ie, \
          G_PB(_c), G_SB(_c), G_LB(_c), G_XB(_c))
 #else
@@ -134,7 +136,7 @@ E50I(cai);
          "-> cbit %d link %d eq %d lt %d dp %d ie %d\n" \
          "-> pb %8.8x sb %8.8x lb %8.8x xb %8.8x\n", \
          G_A(_c), G_B(_c), G_X(_c), G_Y(_c), G_E(_c), \
-         (_c)->crs->km.cbit, (_c)->crs->km.link,(_c)->crs->km.eq,(_c)->crs->km.lt, \
+         (_c)->crs->km.cbit, CC_LINK(_c), CC_EQ(_c), CC_LT(_c), \
          (_c)->crs->km.dp, (_c)->crs->km.ie, \
          G_PB(_c), G_SB(_c), G_LB(_c), G_XB(_c))
 #endif
@@ -211,7 +211,7 @@ uint32_t ea = E50X(ea)(cpu, op);
 #endif
 
   if(ea_ring(cpu->pb) == 0)
-    longjmp(cpu->endop, endop_nointr1);
+    ENDOP(cpu, endop_nointr1);
 }
 
 
@@ -538,7 +538,7 @@ uint32_t ea = E50X(ea)(cpu, op);
   E50X(vstore_d)(cpu, sn + 2, ao); // return addr - updated by argt
   E50X(vstore_d)(cpu, sn + 4, G_SB(cpu));
   E50X(vstore_d)(cpu, sn + 6, G_LB(cpu));
-  E50X(vstore_w)(cpu, sn + 8, cpu->crs->km.keys);
+  E50X(vstore_w)(cpu, sn + 8, G_KEYS(cpu));
   E50X(vstore_w)(cpu, sn + 9, cpu->p);
   E50X(vstore_d)(cpu, s0, sn + sfsize);
 
@@ -34,6 +34,8 @@
 
 #include "pnc.h"
 
+#include "snap.h"
+
 #if 0
 #undef logall
 #define logall(...) PRINTF(__VA_ARGS__)
@@ -530,6 +532,27 @@ static void pnc_init(cpu_t *cpu, int type, int ext, int func, int ctrl, pnc_t **
   pthread_create(&(*pnc)->pthread.tid, &(*pnc)->pthread.attr, pnc_thread, (*pnc));
 }
 
+/* Controller state only, links to other nodes are not part of it
+ */
+static void pnc_snap(pnc_t *pnc, snap_t *s)
+{
+  pthread_mutex_lock(&pnc->pthread.mutex);
+  SNAP(s, pnc->nn);
+  SNAP(s, pnc->ns);
+  SNAP(s, pnc->iv);
+  SNAP(s, pnc->im);
+  SNAP(s, pnc->rx);
+  SNAP(s, pnc->tx);
+  SNAP(s, pnc->rs);
+  SNAP(s, pnc->ts);
+  SNAP(s, pnc->dr);
+  SNAP(s, pnc->intrx);
+  SNAP(s, pnc->inttx);
+  SNAP(s, pnc->rxrdy);
+  SNAP(s, pnc->txrdy);
+  pthread_mutex_unlock(&pnc->pthread.mutex);
+}
+
 int pnc_io(cpu_t *cpu, int type, int ext, int func, int ctrl, void **devparm, int argc, char *argv[])
 {
 pnc_t *pnc = *devparm;
@@ -701,6 +724,9 @@ pnc_t *pnc = *devparm;
     case IO_TYPE_INI:
       pnc_init(cpu, type, ext, func, ctrl, (pnc_t **)devparm, argc, argv);
       break;
+    case IO_TYPE_SNP:
+      pnc_snap(pnc, (snap_t *)argv);
+      break;
     case IO_TYPE_ASN:
       {
       char *ahost, *aport;
@@ -32,6 +32,8 @@
 #ifndef _prcex_h
 #define _prcex_h
 
+#include "io.h"
+
 
 #ifdef DEBUG
  #if 0
@@ -57,6 +59,8 @@ static inline void set_crs(cpu_t *cpu, int nrs)
 {
   uint32_t timer = em50_timer();
 
+  cc_sync(cpu);
+
   if(cpu->crs->km.pxm && !cpu->crs->km.in)
     cpu->crs->timer += timer;
 
@@ -74,7 +78,7 @@ static inline void set_crs(cpu_t *cpu, int nrs)
   if(cpu->crs->km.pxm && !cpu->crs->km.in)
     cpu->crs->timer -= timer;
 
-  mm_ptlb(cpu);
+  ic_unbind(cpu);
 }
 
 #endif
@@ -171,6 +175,8 @@ PRINTK("TIMER %8.8x ABRT\n", timer);
 
 static inline void E50X(store_rs)(cpu_t *cpu, int loc, uint32_t value)
 {
+  cc_sync(cpu);
+
   if(loc & 0x4000)
   {
   switch(loc) {
@@ -216,6 +222,8 @@ static inline void E50X(store_rs)(cpu_t *cpu, int loc, uint32_t value)
 
 static inline uint32_t E50X(fetch_rs)(cpu_t *cpu, int loc)
 {
+  cc_sync(cpu);
+
   if(loc & 0x4000)
   {
     switch(loc) {
@@ -338,11 +346,49 @@ static inline void pxm_intrchk(cpu_t *cpu, uint32_t v)
   S_KEYS(cpu, 014000);
   set_cpu_mode(cpu, cpu->crs->km.mode);
 
+  ENDOP(cpu, endop_setjmp);
+}
+
+
+/* Idle, no process on the ready list
+ * Leave the instruction, run_cpu parks the CPU until an interrupt is
+ * pending and takes it, the interrupt return will invoke the
+ * dispatcher again
+ */
+static inline void __attribute__ ((noreturn)) pxm_idle(cpu_t *cpu)
+{
+  cpu->crs->km.ie = 1;
+  cpu->idle = 1;
+
   longjmp(cpu->endop, endop_setjmp);
 }
 
 
-static inline void __attribute__ ((noreturn)) pxm_check(cpu_t *cpu)
+/* Wait while idle, returns when the CPU is to halt so that it halts
+ * between instructions with idle still set, or after taking the
+ * interrupt
+ */
+static inline endop_t pxm_idle_wait(cpu_t *cpu)
+{
+int32_t v;
+
+  while((v = io_intvec(cpu)) < 0)
+  {
+    if(!cpu_started(cpu))
+      return endop_nointr1;
+#if defined(IDLE_WAIT)
+    io_idle_wait(cpu, IDLE_TICK);
+#endif
+  }
+
+  cpu->idle = 0;
+  pxm_intrchk(cpu, v);
+
+  return endop_setjmp;
+}
+
+
+static inline void ENDOP_NORETURN pxm_check(cpu_t *cpu)
 {
 uint32_t vector = 0x00040000 | cpu->fault.vector;
 
@@ -352,11 +398,11 @@ uint32_t vector = 0x00040000 | cpu->fault.vector;
 
   set_cpu_mode(cpu, km_e64v);
 
-  longjmp(cpu->endop, endop_nointr1); // FIXME TODO CHECK
+  ENDOP(cpu, endop_nointr1); // FIXME TODO CHECK
 }
 
 
-static inline void __attribute__ ((noreturn)) pxm_fault(cpu_t *cpu)
+static inline void ENDOP_NORETURN pxm_fault(cpu_t *cpu)
 {
   uint32_t owner  = cpu->crs->owner;
   uint32_t vector = E50X(vfetch_dp)(cpu, owner + cpu->fault.vector);
@@ -373,7 +419,7 @@ fault_name(cpu->fault.vecoff), cpu->fault.offset, cpu->fault.vector,cpu->fault.v
 
   set_cpu_mode(cpu, km_e64v);
 
-  longjmp(cpu->endop, endop_nointr1); // FIXME TODO CHECK
+  ENDOP(cpu, endop_nointr1); // FIXME TODO CHECK
 }
 
 #endif
@@ -464,7 +510,7 @@ PRINTK("pxm_rest pcb %8.8x, level %4.4x smask %4.4x\n", pcba, cpu->srf.mrf.ppa,
   }
   S_RB(cpu, G_P(cpu));
 
-  mm_ptlb(cpu);
+  ic_unbind(cpu);
 
   cpu->crs->km.sd = 0;
   cpu->crs->km.in = 1;
@@ -499,7 +545,6 @@ static inline void __attribute__ ((noreturn)) E50X(pxm_disp)(cpu_t *cpu)
 PRINTK("DISP1 TIMER %8.8X\n", cpu->crs->timer);
   if(!pcb)
   {
-do { ppa = cpu->srf.mrf.ppa;
     uint32_t rl = (seg << 16) | ppa;
 
     do
@@ -509,8 +554,8 @@ do { ppa = cpu->srf.mrf.ppa;
       rl += 2;
     } while (!pcb);
 
-} while(pcb == 1);
-
+    if(pcb == 1)
+      pxm_idle(cpu);
   }
 
 PRINTK("bfore KEYS/MODALS: %6.6o %6.6o pxm %d\n", cpu->crs->km.keys, cpu->crs->km.modals, cpu->crs->km.pxm);
@@ -44,16 +44,16 @@
 
 
 #if defined V_MODE || defined I_MODE
-static inline void E50X(qstore_w)(cpu_t *cpu, uint32_t qadr, uint16_t value)
+static inline uint8_t *E50X(qslot)(cpu_t *cpu, uint32_t qadr)
 {
 uint32_t addr = qadr & 0x0fffffff;
 
   if((qadr & 0x80000000))
-    E50X(vstore_w)(cpu, addr, value);
+    return E50X(v2h)(cpu, addr, acc_wr);
   else
   {
     E50X(rxm_check)(cpu);
-    rstore_w(cpu, addr, value);
+    return physad(cpu, addr);
   }
 }
 
@@ -72,6 +72,19 @@ uint32_t addr = qadr & 0x0fffffff;
 #endif
 
 
+#if defined V_MODE || defined I_MODE
+static inline void E50X(qcb)(cpu_t *cpu, uint32_t ap, qcb_t *q)
+{
+  q->top  = E50X(v2h)(cpu, ap + 0, acc_wr); // TOP
+  q->bot  = E50X(v2h)(cpu, ap + 1, acc_wr); // BOTTOM
+  q->seg  = E50X(vfetch_w)(cpu, ap + 2);    // V SEGMENT
+  q->mask = E50X(vfetch_w)(cpu, ap + 3);    // MASK
+
+  logmsg("-> qcb t1/t2 %8.8x t3 %4.4x t4 %4.4x\n", qload(cpu, q), q->seg, q->mask);
+}
+#endif
+
+
 /* ABQ
  * Add Entry to Bottom of Queue
  * 1100001111001110 (V mode form)
@@ -81,31 +94,18 @@ uint32_t addr = qadr & 0x0fffffff;
 E50I(abq)
 {
 uint32_t ap = E50X(vfetch_iap)(cpu, NULL);
+qcb_t q;
 
   logop2o(op, "*abq", ap);
 
-uint16_t t1 = E50X(vfetch_w)(cpu, ap + 0); // TOP
-uint16_t t2 = E50X(vfetch_w)(cpu, ap + 1); // BOTTOM
-uint16_t t3 = E50X(vfetch_w)(cpu, ap + 2); // V SEGMENT
-uint16_t t4 = E50X(vfetch_w)(cpu, ap + 3); // MASK
+  E50X(qcb)(cpu, ap, &q);
 
-  logmsg("-> abq t1 %4.4x t2 %4.4x t3 %4.4x t4 %4.4x\n", t1, t2, t3, t4);
-
-  uint16_t t5 = (t2 & ~t4) | ((t2 + 1) & t4);
-  logmsg("-> abq -> %4.4x\n", t5);
-
-  if(t1 == t5)
-    cpu->crs->km.eq = 1;
-  else
-  {
+  cc_sync(cpu);
 #if defined I_MODE
-    E50X(qstore_w)(cpu, ((t3 << 16) | t2), G_RH(cpu, op_dr(op)));
+  cpu->crs->km.eq = qadd(cpu, &q, 1, G_RH(cpu, op_dr(op)), E50X(qslot)) ? 1 : 0;
 #else
-    E50X(qstore_w)(cpu, ((t3 << 16) | t2), G_A(cpu));
+  cpu->crs->km.eq = qadd(cpu, &q, 1, G_A(cpu), E50X(qslot)) ? 1 : 0;
 #endif
-    E50X(vstore_w)(cpu, ap + 1, t5);
-    cpu->crs->km.eq = 0;
-  }
   cpu->crs->km.lt = 0;
 }
 #endif
@@ -120,31 +120,18 @@ uint16_t t4 = E50X(vfetch_w)(cpu, ap + 3); // MASK
 E50I(atq)
 {
 uint32_t ap = E50X(vfetch_iap)(cpu, NULL);
+qcb_t q;
 
   logop2o(op, "*atq", ap);
 
-uint16_t t1 = E50X(vfetch_w)(cpu, ap + 0); // TOP
-uint16_t t2 = E50X(vfetch_w)(cpu, ap + 1); // BOTTOM
-uint16_t t3 = E50X(vfetch_w)(cpu, ap + 2); // V SEGMENT
-uint16_t t4 = E50X(vfetch_w)(cpu, ap + 3); // MASK
-
-  logmsg("-> atq t1 %4.4x t2 %4.4x t3 %4.4x t4 %4.4x\n", t1, t2, t3, t4);
+  E50X(qcb)(cpu, ap, &q);
 
-  t1 = (t1 & ~t4) | ((t1 - 1) & t4);
-  logmsg("-> atq -> %4.4x\n", t1);
-
-  if(t1 == t2)
-    cpu->crs->km.eq = 1;
-  else
-  {
+  cc_sync(cpu);
 #if defined I_MODE
-    E50X(qstore_w)(cpu, ((t3 << 16) | t1), G_RH(cpu, op_dr(op)));
+  cpu->crs->km.eq = qadd(cpu, &q, 0, G_RH(cpu, op_dr(op)), E50X(qslot)) ? 1 : 0;
 #else
-    E50X(qstore_w)(cpu, ((t3 << 16) | t1), G_A(cpu));
+  cpu->crs->km.eq = qadd(cpu, &q, 0, G_A(cpu), E50X(qslot)) ? 1 : 0;
 #endif
-    E50X(vstore_w)(cpu, ap + 0, t1);
-    cpu->crs->km.eq = 0;
-  }
   cpu->crs->km.lt = 0;
 }
 #endif
@@ -154,39 +141,21 @@ uint16_t t4 = E50X(vfetch_w)(cpu, ap + 3); // MASK
 E50I(rbq)
 {
 uint32_t ap = E50X(vfetch_iap)(cpu, NULL);
+qcb_t q;
+uint16_t v = 0;
 
   logop2o(op, "*rbq", ap);
 
-uint16_t t1 = E50X(vfetch_w)(cpu, ap + 0); // TOP
-uint16_t t2 = E50X(vfetch_w)(cpu, ap + 1); // BOTTOM
-uint16_t t3 = E50X(vfetch_w)(cpu, ap + 2); // V SEGMENT
-uint16_t t4 = E50X(vfetch_w)(cpu, ap + 3); // MASK
+  E50X(qcb)(cpu, ap, &q);
 
-  logmsg("-> rbq t1 %4.4x t2 %4.4x t3 %4.4x t4 %4.4x\n", t1, t2, t3, t4);
-
-  if(t1 == t2)
-  {
+  cc_sync(cpu);
+  cpu->crs->km.eq = qrem(cpu, &q, 1, &v, E50X(qfetch_w)) ? 1 : 0;
 #if defined I_MODE
-    S_RH(cpu, op_dr(op), 0);
+  S_RH(cpu, op_dr(op), v);
 #else
-    S_A(cpu, 0);
+  S_A(cpu, v);
 #endif
-    cpu->crs->km.eq = 1;
-  }
-  else
-  {
-    t2 = (t2 & ~t4) | ((t2 - 1) & t4);
-#if defined I_MODE
-    S_RH(cpu, op_dr(op), E50X(qfetch_w)(cpu, (t3 << 16) | t2));
-#else
-    S_A(cpu, E50X(qfetch_w)(cpu, (t3 << 16) | t2));
-#endif
-    E50X(vstore_w)(cpu, ap + 1, t2);
-    cpu->crs->km.eq = 0;
-  }
   cpu->crs->km.lt = 0;
-
-  logmsg("-> rbq -> %4.4x\n", t2);
 }
 #endif
 
@@ -195,39 +164,21 @@ uint16_t t4 = E50X(vfetch_w)(cpu, ap + 3); // MASK
 E50I(rtq)
 {
 uint32_t ap = E50X(vfetch_iap)(cpu, NULL);
+qcb_t q;
+uint16_t v = 0;
 
   logop2o(op, "*rtq", ap);
 
-uint16_t t1 = E50X(vfetch_w)(cpu, ap + 0); // TOP
-uint16_t t2 = E50X(vfetch_w)(cpu, ap + 1); // BOTTOM
-uint16_t t3 = E50X(vfetch_w)(cpu, ap + 2); // V SEGMENT
-uint16_t t4 = E50X(vfetch_w)(cpu, ap + 3); // MASK
-
-  logmsg("-> rtq t1 %4.4x t2 %4.4x t3 %4.4x t4 %4.4x\n", t1, t2, t3, t4);
+  E50X(qcb)(cpu, ap, &q);
 
-  if(t1 == t2)
-  {
+  cc_sync(cpu);
+  cpu->crs->km.eq = qrem(cpu, &q, 0, &v, E50X(qfetch_w)) ? 1 : 0;
 #if defined I_MODE
-    S_RH(cpu, op_dr(op), 0);
+  S_RH(cpu, op_dr(op), v);
 #else
-    S_A(cpu, 0);
+  S_A(cpu, v);
 #endif
-    cpu->crs->km.eq = 1;
-  }
-  else
-  {
-#if defined I_MODE
-    S_RH(cpu, op_dr(op), E50X(qfetch_w)(cpu, (t3 << 16) | t1));
-#else
-    S_A(cpu, E50X(qfetch_w)(cpu, (t3 << 16) | t1));
-#endif
-    t1 = (t1 & ~t4) | ((t1 + 1) & t4);
-    E50X(vstore_w)(cpu, ap, t1);
-    cpu->crs->km.eq = 0;
-  }
   cpu->crs->km.lt = 0;
-
-  logmsg("-> rtq -> %4.4x\n", t1);
 }
 #endif
 
@@ -254,6 +205,7 @@ uint16_t t3 = E50X(vfetch_w)(cpu, ap + 2); // V SEGMENT
   S_A(cpu, (t2 - t1) & t4);
 #endif
 
+  cc_sync(cpu);
   cpu->crs->km.eq = (t1 == t2) ? 1 : 0;
   cpu->crs->km.lt = 0;
 }
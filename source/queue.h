@@ -33,125 +33,216 @@
 
 #include "io.h"
 
-// QUICK FIX, QUEUES MUST BE UPDATED WITH INTERLOCKED ATOMICS
-static inline int qvalidate(uint16_t *t1, uint16_t t2, uint16_t m)
+/* Queue Control Block
+ *
+ * TOP, BOTTOM, SEGMENT and MASK words.  TOP and BOTTOM are read and
+ * swapped together, as one 32 bit word when they are adjacent and
+ * aligned in host storage and otherwise under sys->qlock, so that
+ * removing from either end is safe from any number of threads.
+ * Adding takes sys->qlock to store the entry, after its slot has
+ * been translated, which can fault, and while the pointers are
+ * still those the slot was taken from.
+ */
+typedef struct qcb_t {
+  uint8_t *top;
+  uint8_t *bot;
+  uint16_t seg;
+  uint16_t mask;
+} qcb_t;
+
+static inline uint16_t qnext(qcb_t *q, uint16_t t, int d)
 {
-  uint16_t m1 = *t1 & ~m;
-  uint16_t m2 = t2 & ~m;
-
-  if(m1 != m2)
-  {
-    *t1 = m2 | (*t1 & m);
-    return 1;
-  }
-  else
-    return 0;
+  return (t & ~q->mask) | ((t + d) & q->mask);
 }
 
-static inline void qstore_w(cpu_t *cpu, uint32_t addr, uint16_t val)
+static inline bool qpaired(qcb_t *q)
 {
-  store_w(physad(cpu, addr), val);
+  return q->bot == q->top + 2 && !((uintptr_t)q->top & 3);
 }
 
-static inline uint16_t qfetch_w(cpu_t *cpu, uint32_t addr)
+// TOP in the high half and BOTTOM in the low half, sys->qlock is held if not paired
+static inline uint32_t qget(qcb_t *q)
 {
-  return fetch_w(physad(cpu, addr));
+  if(qpaired(q))
+    return from_be_32(__atomic_load_n((uint32_t *)q->top, __ATOMIC_ACQUIRE));
+
+  return (fetch_w(q->top) << 16) | fetch_w(q->bot);
 }
 
-static inline int io_atq(cpu_t *cpu, uint32_t queue, uint16_t value)
+static inline int qset(cpu_t *cpu, qcb_t *q, uint32_t o, uint32_t n)
 {
-uint16_t t1 = ifetch_w(cpu, queue + 0); // TOP
-uint16_t t2 = ifetch_w(cpu, queue + 1); // BOTTOM
-uint16_t t3 = ifetch_w(cpu, queue + 2); // SEGMENT
-uint16_t t4 = ifetch_w(cpu, queue + 3); // MASK
+  if(qpaired(q))
+  {
+    uint32_t e = to_be_32(o);
 
-#ifdef DEBUG
-  int q = qvalidate(&t1, t2, t4);
-  logmsg("io atq t1 %4.4x t2 %4.4x t3 %4.4x t4 %4.4x err %d\n", t1, t2, t3, t4, q);
-#endif
+    if(!__atomic_compare_exchange_n((uint32_t *)q->top, &e, to_be_32(n), false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+      return 0;
+  }
+  else
+  {
+    if(qget(q) != o)
+      return 0;
 
-  t1 = (t1 & ~t4) | ((t1 - 1) & t4);
-  logmsg("io atq -> %4.4x\n", t1);
+    store_w(q->top, n >> 16);
+    store_w(q->bot, n);
+  }
 
-  if(t1 == t2)
-    return -1;
+  ic_dma(cpu, (q->top - cpu->sys->physstor) >> 1, 1);
+  ic_dma(cpu, (q->bot - cpu->sys->physstor) >> 1, 1);
+  dirty_mark(cpu, (q->top - cpu->sys->physstor) >> 1);
+  dirty_mark(cpu, (q->bot - cpu->sys->physstor) >> 1);
+  return 1;
+}
 
-  qstore_w(cpu, ((t3 << 16) | t1), value);
-  istore_w(cpu, queue, t1);
+static inline uint32_t qload(cpu_t *cpu, qcb_t *q)
+{
+  if(qpaired(q))
+    return qget(q);
 
-  return 0;
+  pthread_mutex_lock(&cpu->sys->qlock);
+  uint32_t p = qget(q);
+  pthread_mutex_unlock(&cpu->sys->qlock);
+
+  return p;
 }
 
-static inline int io_abq(cpu_t *cpu, uint32_t queue, uint16_t value)
+static inline int qcas(cpu_t *cpu, qcb_t *q, uint32_t o, uint32_t n)
 {
-uint16_t t1 = ifetch_w(cpu, queue + 0); // TOP
-uint16_t t2 = ifetch_w(cpu, queue + 1); // BOTTOM
-uint16_t t3 = ifetch_w(cpu, queue + 2); // SEGMENT
-uint16_t t4 = ifetch_w(cpu, queue + 3); // MASK
+  if(qpaired(q))
+    return qset(cpu, q, o, n);
 
-#ifdef DEBUG
-  int q = qvalidate(&t2, t1, t4);
-  logmsg("io abq t1 %4.4x t2 %4.4x t3 %4.4x t4 %4.4x err %d\n", t1, t2, t3, t4, q);
-#endif
+  pthread_mutex_lock(&cpu->sys->qlock);
+  int rc = qset(cpu, q, o, n);
+  pthread_mutex_unlock(&cpu->sys->qlock);
 
-  uint16_t t5 = (t2 & ~t4) | ((t2 + 1) & t4);
-  logmsg("io abq -> %4.4x\n", t5);
+  return rc;
+}
 
-  if(t1 == t5)
-    return -1;
+static inline int qadd(cpu_t *cpu, qcb_t *q, int bottom, uint16_t value, uint8_t *(*slot)(cpu_t *, uint32_t))
+{
+uint32_t p;
+uint16_t t1, t2;
+int rc;
+
+  do {
+    p = qload(cpu, q);
+    t1 = p >> 16;
+    t2 = p;
+
+    if(bottom ? qnext(q, t2, 1) == t1 : qnext(q, t1, -1) == t2)
+      return -1;
+
+    uint8_t *h = slot(cpu, (q->seg << 16) | (bottom ? t2 : qnext(q, t1, -1)));
+
+    if(bottom)
+      t2 = qnext(q, t2, 1);
+    else
+      t1 = qnext(q, t1, -1);
+
+    pthread_mutex_lock(&cpu->sys->qlock);
+    if((rc = qget(q) == p))
+    {
+      store_w(h, value);
+      ic_dma(cpu, (h - cpu->sys->physstor) >> 1, 1);
+      dirty_mark(cpu, (h - cpu->sys->physstor) >> 1);
+      rc = qset(cpu, q, p, (t1 << 16) | t2);
+    }
+    pthread_mutex_unlock(&cpu->sys->qlock);
+  } while(!rc);
+
+  logmsg("qadd %s %8.8x -> %4.4x%4.4x\n", bottom ? "bottom" : "top", p, t1, t2);
+
+  return 0;
+}
 
-  qstore_w(cpu, ((t3 << 16) | t2), value);
-  istore_w(cpu, queue + 1, t2);
+static inline int qrem(cpu_t *cpu, qcb_t *q, int bottom, uint16_t *value, uint16_t (*get)(cpu_t *, uint32_t))
+{
+uint32_t p;
+uint16_t t1, t2;
+
+  do {
+    p = qload(cpu, q);
+    t1 = p >> 16;
+    t2 = p;
+
+    if(t1 == t2)
+      return -1;
+
+    if(bottom)
+    {
+      t2 = qnext(q, t2, -1);
+      *value = get(cpu, (q->seg << 16) | t2);
+    }
+    else
+    {
+      *value = get(cpu, (q->seg << 16) | t1);
+      t1 = qnext(q, t1, 1);
+    }
+  } while(!qcas(cpu, q, p, (t1 << 16) | t2));
+
+  logmsg("qrem %s %8.8x -> %4.4x%4.4x\n", bottom ? "bottom" : "top", p, t1, t2);
 
   return 0;
 }
 
-static inline int io_rbq(cpu_t *cpu, uint32_t queue, uint16_t *value)
+static inline uint8_t *qslot(cpu_t *cpu, uint32_t addr)
 {
-uint16_t t1 = ifetch_w(cpu, queue + 0); // TOP
-uint16_t t2 = ifetch_w(cpu, queue + 1); // BOTTOM
-uint16_t t3 = ifetch_w(cpu, queue + 2); // SEGMENT
-uint16_t t4 = ifetch_w(cpu, queue + 3); // MASK
+  return physad(cpu, addr);
+}
 
-#ifdef DEBUG
-  int q = qvalidate(&t2, t1, t4);
-  logmsg("io rbq t1 %4.4x t2 %4.4x t3 %4.4x t4 %4.4x err %d\n", t1, t2, t3, t4, q);
-#endif
+static inline uint16_t qfetch_w(cpu_t *cpu, uint32_t addr)
+{
+  return fetch_w(physad(cpu, addr));
+}
 
-  if(t1 == t2)
-    return -1;
+static inline int io_qcb(cpu_t *cpu, uint32_t queue, qcb_t *q)
+{
+  q->top = c2h(cpu, queue + 0);
+  q->bot = c2h(cpu, queue + 1);
+  q->seg = ifetch_w(cpu, queue + 2);
+  q->mask = ifetch_w(cpu, queue + 3);
 
-  t2 = (t2 & ~t4) | ((t2 - 1) & t4);
+  return (q->top && q->bot) ? 0 : -1;
+}
 
-  *value = qfetch_w(cpu, (t3 << 16) | t2);
+static inline int io_atq(cpu_t *cpu, uint32_t queue, uint16_t value)
+{
+qcb_t q;
 
-  istore_w(cpu, queue + 1, t2);
+  if(io_qcb(cpu, queue, &q))
+    return -1;
 
-  return 0;
+  return qadd(cpu, &q, 0, value, qslot);
 }
 
-static inline int io_rtq(cpu_t *cpu, uint32_t queue, uint16_t *value)
+static inline int io_abq(cpu_t *cpu, uint32_t queue, uint16_t value)
 {
-uint16_t t1 = ifetch_w(cpu, queue + 0); // TOP
-uint16_t t2 = ifetch_w(cpu, queue + 1); // BOTTOM
-uint16_t t3 = ifetch_w(cpu, queue + 2); // SEGMENT
-uint16_t t4 = ifetch_w(cpu, queue + 3); // MASK
+qcb_t q;
 
-#ifdef DEBUG
-  int q = qvalidate(&t1, t2, t4);
-  logmsg("io rtq t1 %4.4x t2 %4.4x t3 %4.4x t4 %4.4x err %d\n", t1, t2, t3, t4, q);
-#endif
+  if(io_qcb(cpu, queue, &q))
+    return -1;
 
-  if(t1 == t2)
+  return qadd(cpu, &q, 1, value, qslot);
+}
+
+static inline int io_rbq(cpu_t *cpu, uint32_t queue, uint16_t *value)
+{
+qcb_t q;
+
+  if(io_qcb(cpu, queue, &q))
     return -1;
 
-  *value = qfetch_w(cpu, (t3 << 16) | t1);
+  return qrem(cpu, &q, 1, value, qfetch_w);
+}
 
-  t1 = (t1 & ~t4) | ((t1 + 1) & t4);
+static inline int io_rtq(cpu_t *cpu, uint32_t queue, uint16_t *value)
+{
+qcb_t q;
 
-  istore_w(cpu, queue, t1);
+  if(io_qcb(cpu, queue, &q))
+    return -1;
 
-  return 0;
+  return qrem(cpu, &q, 0, value, qfetch_w);
 }
 
 static inline int io_tstq(cpu_t *cpu, uint32_t queue, uint16_t *value)
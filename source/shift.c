@@ -55,6 +55,7 @@ int o;
 
   S_A(cpu, a);
 
+  cc_sync(cpu);
   cpu->crs->km.cbit = cpu->crs->km.link = o ? 1 : 0;
 }
 
@@ -75,6 +76,7 @@ int o;
 
   S_A(cpu, a);
 
+  cc_sync(cpu);
   cpu->crs->km.cbit = cpu->crs->km.link = o ? 1 : 0;
 }
 
@@ -95,6 +97,7 @@ int o;
 
   S_A(cpu, a);
 
+  cc_sync(cpu);
   cpu->crs->km.cbit = cpu->crs->km.link = o ? 1 : 0;
 }
 
@@ -111,6 +114,7 @@ int o;
 
   S_L(cpu, l);
 
+  cc_sync(cpu);
   cpu->crs->km.cbit = cpu->crs->km.link = o ? 1 : 0;
 }
 
@@ -137,6 +141,7 @@ int o;
 
   S_L(cpu, l);
 
+  cc_sync(cpu);
   cpu->crs->km.cbit = cpu->crs->km.link = o ? 1 : 0;
 }
 
@@ -152,6 +157,7 @@ int o;
 
   S_L(cpu, l);
 
+  cc_sync(cpu);
   cpu->crs->km.cbit = cpu->crs->km.link = o ? 1 : 0;
 }
 
@@ -167,6 +173,7 @@ int o;
 
   S_L(cpu, l);
 
+  cc_sync(cpu);
   cpu->crs->km.cbit = cpu->crs->km.link = o ? 1 : 0;
 }
 
@@ -210,6 +217,7 @@ int o;
 
   S_L(cpu, l);
 
+  cc_sync(cpu);
   cpu->crs->km.cbit = cpu->crs->km.link = o ? 1 : 0;
 }
 
@@ -231,6 +239,7 @@ int o;
 
   S_A(cpu, a);
 
+  cc_sync(cpu);
   cpu->crs->km.cbit = cpu->crs->km.link = o ? 1 : 0;
 }
 #endif
@@ -275,6 +284,7 @@ uint16_t a = G_A(cpu);
 
   S_A(cpu, a);
 
+  cc_sync(cpu);
   cpu->crs->km.cbit = cpu->crs->km.link = o ? 1 : 0;
 }
 #endif
@@ -313,6 +323,7 @@ int o;
     S_R(cpu, dr, r);
   }
 
+  cc_sync(cpu);
   cpu->crs->km.cbit = cpu->crs->km.link = o ? 1 : 0;
 }
 
@@ -351,7 +362,10 @@ int o;
 
   cpu->crs->km.cbit = o ? 1 : 0;
   if(!(ea & 0x8000))
+  {
+    cc_sync(cpu);
     cpu->crs->km.link = cpu->crs->km.cbit;
+  }
   else
     if(cpu->crs->km.cbit)
       E50X(int_ovf)(cpu);
@@ -390,6 +404,7 @@ int o;
     S_R(cpu, dr, r);
   }
 
+  cc_sync(cpu);
   cpu->crs->km.cbit = cpu->crs->km.link = o ? 1 : 0;
 }
 
@@ -404,6 +419,7 @@ int dr = op_dr(op);
   int o = shift_left_logical16(&r, 1);
   S_RH(cpu, dr, r);
 
+  cc_sync(cpu);
   cpu->crs->km.cbit = cpu->crs->km.link = o ? 1 : 0;
 }
 
@@ -418,6 +434,7 @@ int dr = op_dr(op);
   int o = shift_left_logical16(&r, 2);
   S_RH(cpu, dr, r);
 
+  cc_sync(cpu);
   cpu->crs->km.cbit = cpu->crs->km.link = o ? 1 : 0;
 }
 
@@ -432,6 +449,7 @@ int dr = op_dr(op);
   int o = shift_right_logical16(&r, 1);
   S_RH(cpu, dr, r);
 
+  cc_sync(cpu);
   cpu->crs->km.cbit = cpu->crs->km.link = o ? 1 : 0;
 }
 
@@ -446,6 +464,7 @@ int dr = op_dr(op);
   int o = shift_right_logical16(&r, 2);
   S_RH(cpu, dr, r);
 
+  cc_sync(cpu);
   cpu->crs->km.cbit = cpu->crs->km.link = o ? 1 : 0;
 }
 
@@ -460,6 +479,7 @@ int dr = op_dr(op);
   int o = shift_left_logical32(&r, 1);
   S_R(cpu, dr, r);
 
+  cc_sync(cpu);
   cpu->crs->km.cbit = cpu->crs->km.link = o ? 1 : 0;
 }
 
@@ -474,6 +494,7 @@ int dr = op_dr(op);
   int o = shift_left_logical32(&r, 2);
   S_R(cpu, dr, r);
 
+  cc_sync(cpu);
   cpu->crs->km.cbit = cpu->crs->km.link = o ? 1 : 0;
 }
 
@@ -488,6 +509,7 @@ int dr = op_dr(op);
   int o = shift_right_logical32(&r, 1);
   S_R(cpu, dr, r);
 
+  cc_sync(cpu);
   cpu->crs->km.cbit = cpu->crs->km.link = o ? 1 : 0;
 }
 
@@ -502,6 +524,7 @@ int dr = op_dr(op);
   int o = shift_right_logical32(&r, 2);
   S_R(cpu, dr, r);
 
+  cc_sync(cpu);
   cpu->crs->km.cbit = cpu->crs->km.link = o ? 1 : 0;
 }
 
@@ -399,12 +399,7 @@ int16_t a = G_A(cpu);
 
   logop1(op, "caz");
 
-  int eq, lt, car;
-  sba_w(a, 0, &eq, &lt, &car, NULL);
-
-  cpu->crs->km.eq = eq;
-  cpu->crs->km.lt = lt;
-  cpu->crs->km.link = car;
+  sba_w_cc(cpu, a, 0, NULL);
 
   if(CC_LT(cpu))
     cpu->p += 2;
@@ -422,12 +417,7 @@ int16_t s = E50X(vfetch_w)(cpu, ea);
 
   logopxoo(op, "cas", ea, s & 0xffff);
 
-  int eq, lt, car;
-  sba_w(a, s, &eq, &lt, &car, NULL);
-
-  cpu->crs->km.eq = eq;
-  cpu->crs->km.lt = lt;
-  cpu->crs->km.link = car;
+  sba_w_cc(cpu, a, s, NULL);
 
   if(CC_LT(cpu))
     cpu->p += 2;
@@ -445,12 +435,7 @@ int32_t s = E50X(vfetch_d)(cpu, ea);
 
   logop2oo(op, "cls", ea, s);
 
-  int eq, lt, car;
-  sba_d(l, s, &eq, &lt, &car, NULL);
-
-  cpu->crs->km.eq = eq;
-  cpu->crs->km.lt = lt;
-  cpu->crs->km.link = car;
+  sba_d_cc(cpu, l, s, NULL);
 
   if(CC_LT(cpu))
     cpu->p += 2;
@@ -0,0 +1,934 @@
+/* Machine Snapshots
+ *
+ *
+ * Copyright Notice:
+ *
+ *   Copyright (C) 1999-2020 Jan Jaeger, All Rights Reserved.
+ *
+ *
+ * This file is part of the Prime 50 Series Emulator (em50).
+ *
+ *
+ * License Statement:
+ *
+ *   The Prime 50 Series Emulator (em50) is free software:
+ *   You can redistribute it and/or modify it under the terms
+ *   of the GNU General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License,
+ *   or (at your option) any later version.
+ *
+ *   em50 is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *   See the GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with em50.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "emu.h"
+
+#include "io.h"
+
+#include "amlc.h"
+
+#include "pnc.h"
+
+#include "dirty.h"
+
+#include "snap.h"
+
+
+void snap_io(snap_t *s, void *v, size_t n)
+{
+  if(s->err)
+    return;
+
+  if((s->wr ? fwrite(v, n, 1, s->f) : fread(v, n, 1, s->f)) != 1)
+    s->err = ferror(s->f) ? errno : EINVAL;
+}
+
+
+void snap_tag(snap_t *s, const char *tag, int n)
+{
+struct {
+  char t[4];
+  int32_t n;
+} r = { .n = n }, c;
+
+  memcpy(r.t, tag, sizeof(r.t));
+  c = r;
+  SNAP(s, c);
+
+  if(!s->err && memcmp(&c, &r, sizeof(r)))
+    s->err = EINVAL;
+}
+
+
+/* Strings are saved with their length, a restored string
+ * replaces the one in place
+ */
+void snap_str(snap_t *s, char **p)
+{
+uint32_t n = (s->wr && *p) ? strlen(*p) : 0;
+char *v;
+
+  SNAP(s, n);
+
+  if(s->wr)
+  {
+    if(n)
+      snap_io(s, *p, n);
+    return;
+  }
+
+  if(s->err || !(v = malloc(n + 1)))
+    return;
+
+  if(n)
+    snap_io(s, v, n);
+  v[n] = '\0';
+
+  if(s->err)
+    free(v);
+  else
+  {
+    free(*p);
+    *p = v;
+  }
+}
+
+
+static void snap_sys(snap_t *s, sys_t *sys)
+{
+  snap_tag(s, "SYS ", 0);
+  SNAP(s, sys->sswitches);
+  SNAP(s, sys->dswitches);
+  SNAP(s, sys->serial);
+  SNAP(s, sys->ucodeman);
+  SNAP(s, sys->ucodeeng);
+  SNAP(s, sys->ucodepln);
+  SNAP(s, sys->ucodeext);
+}
+
+
+/* The CPU state that outlives an instruction, translation and
+ * instruction caches are rebuilt after restore
+ */
+static void snap_cpu(snap_t *s, cpu_t *cpu, int *status)
+{
+  snap_tag(s, "CPU ", cpu->id);
+  SNAP(s, *status);
+  SNAP(s, cpu->crn);
+  SNAP(s, cpu->pb);
+  SNAP(s, cpu->exec);
+  SNAP(s, cpu->po);
+  SNAP(s, cpu->atr);
+  SNAP(s, cpu->cc);
+  SNAP(s, cpu->c);
+  SNAP(s, cpu->srf);
+  SNAP(s, cpu->op);
+  SNAP(s, cpu->fault);
+  SNAP(s, cpu->idle);
+
+#if !defined(MODEL)
+  char name[16] = "";
+  if(s->wr)
+    snprintf(name, sizeof(name), "%s", cpu->model.name);
+  SNAP(s, name);
+  if(!s->wr && !s->err)
+  {
+    cpumodel_t *m = get_cpumodel(name);
+    if(m)
+      cpu->model = *m;
+    else
+      s->err = EINVAL;
+  }
+  SNAP(s, cpu->model.ucodeman);
+  SNAP(s, cpu->model.ucodeeng);
+  SNAP(s, cpu->model.ucodepln);
+  SNAP(s, cpu->model.ucodeext);
+#endif
+
+  snap_tag(s, "INTR", cpu->id);
+  SNAP(s, cpu->intr.v);
+  SNAP(s, cpu->intr.s);
+  SNAP(s, cpu->intr.c);
+  SNAP(s, cpu->intr.a);
+  SNAP(s, cpu->intr.n);
+  SNAP(s, cpu->intr.burst);
+
+  if(!s->wr)
+  {
+    cpu->crs = &cpu->srf.urs[cpu->crn];
+    atomic_store_explicit(&cpu->intr.attn, 1, memory_order_relaxed);
+  }
+}
+
+
+static void snap_state(snap_t *s, cpu_t *cpu, int ncpu, int *status)
+{
+sys_t *sys = cpu->sys;
+
+  snap_sys(s, sys);
+  for(int n = 0; n < ncpu; ++n)
+    snap_cpu(s, sys->cpu[n], &status[n]);
+  io_snap(cpu, s);
+  snap_tag(s, "END ", 0);
+}
+
+
+/* Stop all CPUs and wait until they are held, then hold the device
+ * transfers.  The previous status is returned so that the CPUs that
+ * were running can be restarted.
+ */
+void snap_stop(sys_t *sys, int *status)
+{
+  for(int n = 0; n < sys->ncpu; ++n)
+  {
+    status[n] = sys->cpu[n]->halt.status == started ? started : stopped;
+    cpu_stop(sys->cpu[n]);
+  }
+
+  for(int n = 0; n < sys->ncpu; ++n)
+    cpu_wait(sys->cpu[n]);
+
+  io_hold(sys->cpu[0], true);
+}
+
+
+void snap_start(sys_t *sys, int *status)
+{
+  io_hold(sys->cpu[0], false);
+
+  for(int n = 0; n < sys->ncpu; ++n)
+    if(status[n] == started)
+      cpu_start(sys->cpu[n]);
+}
+
+
+static inline int snap_zero(const uint8_t *p)
+{
+static const uint8_t zero[em50_pgoc_size] = { 0 };
+
+  return !memcmp(p, zero, sizeof(zero));
+}
+
+
+/* Write storage in runs of non-zero pages, zero pages become holes
+ */
+static int snap_wrstor(int fd, off_t off, uint8_t *stor, size_t size)
+{
+  for(size_t p = 0, e; p < size; p = e)
+  {
+    while(p < size && snap_zero(stor + p))
+      p += em50_pgoc_size;
+
+    for(e = p; e < size && !snap_zero(stor + e); e += em50_pgoc_size)
+      ;
+
+    for(size_t n = p; n < e; )
+    {
+      ssize_t rc = pwrite(fd, stor + n, e - n, off + n);
+      if(rc < 0 && errno != EINTR)
+        return -1;
+      if(rc > 0)
+        n += rc;
+    }
+  }
+
+  return ftruncate(fd, off + size);
+}
+
+
+/* Pages of a delta, each preceded by its number, those set in map
+ * are written
+ */
+static void snap_pages(snap_t *s, sys_t *sys, const uint8_t *map)
+{
+int32_t p;
+
+  if(s->wr)
+  {
+    for(p = 0; p < dirty_pages(sys); ++p)
+      if(map[p])
+      {
+        SNAP(s, p);
+        snap_io(s, sys->physstor + (size_t)p * em50_pgoc_size, em50_pgoc_size);
+      }
+    p = -1;
+    SNAP(s, p);
+    return;
+  }
+
+  for(SNAP(s, p); !s->err && p >= 0; SNAP(s, p))
+    if(p < dirty_pages(sys))
+      snap_io(s, sys->physstor + (size_t)p * em50_pgoc_size, em50_pgoc_size);
+    else
+      s->err = EINVAL;
+}
+
+
+/* Write a snapshot of the stopped system, status is that of
+ * the CPUs before they were stopped.  A checkpoint starts a new
+ * interval of dirty pages.
+ */
+static int snap_write(cpu_t *cpu, const char *fn, int *status, int type, char *parent)
+{
+sys_t *sys = cpu->sys;
+char tmp[PATH_MAX];
+snaphdr_t hdr = { .version = SNAP_VERSION, .ncpu = sys->ncpu, .physsize = sys->physsize, .type = type };
+snap_t s = { .wr = true, .type = type };
+uint8_t *map = NULL;
+
+  memcpy(hdr.magic, SNAP_MAGIC, sizeof(hdr.magic));
+
+  snprintf(tmp, sizeof(tmp), "%s.tmp", fn);
+  if((type == SNAP_BASE || type == SNAP_DELTA) && !(map = malloc(dirty_pages(sys))))
+    return -1;
+  if(!(s.f = fopen(tmp, "w")))
+  {
+    free(map);
+    return -1;
+  }
+
+  if(map)
+    dirty_take(sys, map);
+
+  SNAP(&s, hdr);
+  if(type == SNAP_DELTA)
+    snap_str(&s, &parent);
+  snap_state(&s, cpu, sys->ncpu, status);
+
+  if(type == SNAP_DELTA)
+    snap_pages(&s, sys, map);
+  else
+  {
+    if(!s.err && fflush(s.f))
+      s.err = errno;
+
+    hdr.offset = (ftello(s.f) + SNAP_ALIGN - 1) & ~(uint64_t)(SNAP_ALIGN - 1);
+
+    if(!s.err && snap_wrstor(fileno(s.f), hdr.offset, sys->physstor, sys->physsize))
+      s.err = errno;
+  }
+
+  if(!s.err && fseeko(s.f, 0, SEEK_SET))
+    s.err = errno;
+  SNAP(&s, hdr);
+
+  if(fclose(s.f) && !s.err)
+    s.err = errno;
+
+  if(!s.err && rename(tmp, fn))
+    s.err = errno;
+
+  if(s.err && map)
+    dirty_merge(sys, map);
+  free(map);
+
+  if(s.err)
+  {
+    unlink(tmp);
+    errno = s.err;
+    return -1;
+  }
+
+  return 0;
+}
+
+
+int snap_save(cpu_t *cpu, const char *fn)
+{
+int status[EM50_MAXCPU];
+
+  snap_stop(cpu->sys, status);
+  int rc = snap_write(cpu, fn, status, SNAP_SAVE, NULL);
+  snap_start(cpu->sys, status);
+
+  return rc;
+}
+
+
+static int snap_rdhdr(FILE *f, snaphdr_t *hdr)
+{
+  if(fread(hdr, sizeof(*hdr), 1, f) != 1
+    || memcmp(hdr->magic, SNAP_MAGIC, sizeof(hdr->magic))
+    || hdr->version != SNAP_VERSION)
+  {
+    errno = ferror(f) ? errno : EINVAL;
+    return -1;
+  }
+
+  return 0;
+}
+
+
+/* Storage size of a snapshot, so that storage can be allocated
+ * to match before the snapshot is restored
+ */
+size_t snap_physsize(const char *fn)
+{
+FILE *f = fopen(fn, "r");
+snaphdr_t hdr;
+
+  if(!f)
+    return 0;
+
+  int rc = snap_rdhdr(f, &hdr);
+  fclose(f);
+
+  return rc ? 0 : hdr.physsize;
+}
+
+
+static int snap_mkdir(const char *dir)
+{
+  return (mkdir(dir, S_IRWXU) && errno != EEXIST) ? -1 : 0;
+}
+
+
+/* Storage is mapped private from the snapshot, pages are read
+ * when first referenced and copied when first modified.  A delta
+ * is applied on top of its parent, restored first.
+ */
+static int snap_load(cpu_t *cpu, const char *fn, int *status, int depth)
+{
+sys_t *sys = cpu->sys;
+snaphdr_t hdr;
+snap_t s = { .wr = false };
+char *parent = NULL;
+
+  if(!(s.f = fopen(fn, "r")))
+    return -1;
+
+  if(snap_rdhdr(s.f, &hdr))
+  {
+    fclose(s.f);
+    return -1;
+  }
+
+  s.type = hdr.type;
+
+  if(hdr.physsize != sys->physsize || hdr.ncpu > sys->ncpu)
+    s.err = EINVAL;
+
+  if(hdr.type == SNAP_DELTA)
+  {
+    snap_str(&s, &parent);
+    if(!s.err && depth >= SNAP_DEPTH)
+      s.err = ELOOP;
+    if(!s.err && snap_load(cpu, parent, status, depth + 1))
+      s.err = errno;
+    free(parent);
+  }
+
+  snap_state(&s, cpu, hdr.ncpu, status);
+
+  if(hdr.type == SNAP_DELTA)
+    snap_pages(&s, sys, NULL);
+  else
+    if(!s.err && mmap(sys->physstor, sys->physsize, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_FIXED, fileno(s.f), hdr.offset) == MAP_FAILED)
+      s.err = errno;
+
+  fclose(s.f);
+
+  if(s.err)
+  {
+    errno = s.err;
+    return -1;
+  }
+
+  return 0;
+}
+
+
+/* A restored checkpoint replays its disk records into overlays in
+ * <fn>.restored, and later checkpoints continue the chain from it.
+ * A restore that fails leaves the CPUs stopped and the disk and tape
+ * transfers released.
+ */
+int snap_restore(cpu_t *cpu, const char *fn)
+{
+sys_t *sys = cpu->sys;
+int status[EM50_MAXCPU];
+snaphdr_t hdr;
+FILE *f;
+char ov[PATH_MAX];
+
+  if(!(f = fopen(fn, "r")))
+    return -1;
+
+  int rc = snap_rdhdr(f, &hdr);
+  fclose(f);
+  if(rc)
+    return -1;
+
+  if(hdr.physsize != sys->physsize)
+    printf("Snapshot storage size %ju does not match %zu\n", (uintmax_t)hdr.physsize, sys->physsize);
+
+  if(hdr.physsize != sys->physsize || hdr.ncpu > sys->ncpu)
+  {
+    errno = EINVAL;
+    return -1;
+  }
+
+  if(hdr.type != SNAP_SAVE && !sys->overlay)
+  {
+    snprintf(ov, sizeof(ov), "%s.restored", fn);
+    if(snap_mkdir(ov))
+      return -1;
+    sys->overlay = strdup(ov);
+  }
+
+  snap_stop(sys, status);
+  for(int n = hdr.ncpu; n < sys->ncpu; ++n)
+    status[n] = stopped;
+
+  rc = snap_load(cpu, fn, status, 0);
+
+  for(int n = 0; n < sys->ncpu; ++n)
+  {
+    mm_ptlb(sys->cpu[n]);
+    mm_piotlb(sys->cpu[n]);
+  }
+  ic_purge(cpu);
+
+  if(rc)
+  {
+    memset(sys->dirty, 1, dirty_pages(sys));
+    io_hold(cpu, false);
+    return -1;
+  }
+
+  if(hdr.type != SNAP_SAVE)
+  {
+    dirty_reset(sys);
+    free(sys->ckpt);
+    sys->ckpt = realpath(fn, NULL);
+  }
+  else
+    memset(sys->dirty, 1, dirty_pages(sys));
+
+  snap_start(sys, status);
+
+  return 0;
+}
+
+
+static int snap_port(const char *port, int dflt)
+{
+  if(!port)
+    return dflt;
+
+  if(!strcasecmp(port, "none"))
+    return 0;
+
+  return atoi(port) ? atoi(port) : dflt;
+}
+
+
+/* A clone is this program resuming from the snapshot without a CP,
+ * in a process group of its own, console output goes to a file
+ */
+static pid_t snap_spawn(sys_t *sys, const char *fn, const char *dir, int aport, int pport)
+{
+char console[PATH_MAX], ap[16], pp[16];
+char *argv[] = { sys->progname, "-c", "/dev/null", "-p", sys->hdir, "-r", (char *)fn,
+                 "-O", (char *)dir, "-d", "-l", ap, "-o", pp, NULL };
+posix_spawn_file_actions_t fa;
+posix_spawnattr_t attr;
+pid_t pid;
+
+  snprintf(console, sizeof(console), "%s/console", dir);
+  snprintf(ap, sizeof(ap), aport ? "%d" : "none", aport);
+  snprintf(pp, sizeof(pp), pport ? "%d" : "none", pport);
+
+  posix_spawn_file_actions_init(&fa);
+  posix_spawn_file_actions_addopen(&fa, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+  posix_spawn_file_actions_addopen(&fa, STDOUT_FILENO, console, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+  posix_spawn_file_actions_adddup2(&fa, STDOUT_FILENO, STDERR_FILENO);
+
+  posix_spawnattr_init(&attr);
+  posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETPGROUP);
+  posix_spawnattr_setpgroup(&attr, 0);
+
+  int rc = posix_spawnp(&pid, sys->progname, &fa, &attr, argv, environ);
+
+  posix_spawnattr_destroy(&attr);
+  posix_spawn_file_actions_destroy(&fa);
+
+  if(rc)
+  {
+    errno = rc;
+    return -1;
+  }
+
+  return pid;
+}
+
+
+/* Clones resume from a snapshot in the clone directory, storage is
+ * shared with the snapshot until written.  Disk records in overlays
+ * are part of the snapshot and each clone replays them into overlays
+ * of its own in <clonedir>/<n>, so the disk files stay as they were
+ * and CLONE can be repeated, and used again by a clone.  Without
+ * overlays this system moves its disk writes to <clonedir>/0.  The
+ * clone directory is <hdir>/clone, or clone in the overlay directory.
+ * The k-th clone of a call listens on AMLC port aport+k-1 and PNC
+ * port pport+k-1, ports of 0 default to 100 and 200 above those of
+ * this system plus the number of clones started before.
+ */
+int snap_clone(cpu_t *cpu, int n, int aport, int pport)
+{
+sys_t *sys = cpu->sys;
+int status[EM50_MAXCPU];
+char dir[PATH_MAX - 32], fn[PATH_MAX], ov[PATH_MAX - 16];
+
+  if(!aport && (aport = snap_port(sys->port, AMLC_DFLTPORT)))
+    aport += 100 + sys->nclones;
+  if(!pport && (pport = snap_port(sys->pncport, PNC_DFLTPORT)))
+    pport += 200 + sys->nclones;
+
+  if(sys->clonedir)
+    snprintf(dir, sizeof(dir), "%s", sys->clonedir);
+  else
+    snprintf(dir, sizeof(dir), "%s/clone", sys->overlay ? sys->overlay : sys->hdir);
+  snprintf(fn, sizeof(fn), "%s/snap%d", dir, sys->nclones + 1);
+  snprintf(ov, sizeof(ov), "%s/0", dir);
+  if(snap_mkdir(dir) || (!sys->overlay && snap_mkdir(ov)))
+    return -1;
+
+  if(!sys->clonedir)
+    sys->clonedir = strdup(dir);
+
+  snap_stop(sys, status);
+  if(!sys->overlay)
+  {
+    sys->overlay = strdup(ov);
+    io_overlay(cpu);
+  }
+  int rc = snap_write(cpu, fn, status, SNAP_CLONE, NULL);
+  snap_start(sys, status);
+
+  if(rc)
+    return -1;
+
+  sys->clones = realloc(sys->clones, (sys->nclones + n) * sizeof(*sys->clones));
+
+  for(int k = 1; k <= n; ++k)
+  {
+  struct clone_t *c = &sys->clones[sys->nclones];
+
+    c->aport = aport ? aport + k - 1 : 0;
+    c->pport = pport ? pport + k - 1 : 0;
+
+    snprintf(ov, sizeof(ov), "%s/%d", dir, sys->nclones + 1);
+    if(snap_mkdir(ov) || (c->pid = snap_spawn(sys, fn, ov, c->aport, c->pport)) < 0)
+      return -1;
+
+    sys->nclones++;
+  }
+
+  return 0;
+}
+
+
+/* The first checkpoint, or one asked to be a base, holds all of
+ * storage and moves the disks to overlays in <fn>.disk.  Later ones
+ * hold the pages and disk records written since the previous one,
+ * so the CPUs are held for a time that follows the dirty set.
+ * Returns the number of pages written.
+ */
+ssize_t snap_checkpoint(cpu_t *cpu, const char *fn, bool base)
+{
+sys_t *sys = cpu->sys;
+int status[EM50_MAXCPU];
+int type = (base || !sys->ckpt) ? SNAP_BASE : SNAP_DELTA;
+char ov[PATH_MAX - 16];
+
+  snprintf(ov, sizeof(ov), "%s.disk", fn);
+  if(type == SNAP_BASE && !sys->overlay && snap_mkdir(ov))
+    return -1;
+
+  snap_stop(sys, status);
+
+  if(type == SNAP_BASE && !sys->overlay)
+  {
+    sys->overlay = strdup(ov);
+    io_overlay(cpu);
+  }
+
+  ssize_t n = (type == SNAP_BASE) ? dirty_pages(sys) : dirty_sync(sys);
+  int rc = snap_write(cpu, fn, status, type, sys->ckpt);
+
+  snap_start(sys, status);
+
+  if(rc)
+    return -1;
+
+  free(sys->ckpt);
+  sys->ckpt = realpath(fn, NULL);
+
+  return n;
+}
+
+
+static int snap_unix(const char *path, struct sockaddr_un *sa)
+{
+int fd;
+
+  memset(sa, 0, sizeof(*sa));
+  sa->sun_family = AF_UNIX;
+  if(strlen(path) >= sizeof(sa->sun_path))
+  {
+    errno = ENAMETOOLONG;
+    return -1;
+  }
+  strcpy(sa->sun_path, path);
+
+  if((fd = socket(AF_UNIX, SOCK_STREAM, 0)) >= 0)
+    ioctl(fd, FIOCLEX, NULL);
+
+  return fd;
+}
+
+
+/* Pre-copy migration to a system waiting with --incoming on the
+ * unix socket path.  Storage is sent while the CPUs run, then in
+ * rounds the pages written meanwhile, until few are left or the
+ * rounds run out.  The CPUs and the disk and tape transfers are
+ * held for the rest, and stay held once the destination has taken
+ * over.
+ */
+int snap_migrate(cpu_t *cpu, const char *path, snapmig_t *m)
+{
+sys_t *sys = cpu->sys;
+int status[EM50_MAXCPU];
+snaphdr_t hdr = { .version = SNAP_VERSION, .ncpu = sys->ncpu, .physsize = sys->physsize,
+                  .type = sys->overlay ? SNAP_BASE : SNAP_SAVE };
+snap_t s = { .wr = true, .type = hdr.type };
+size_t np = dirty_pages(sys), d;
+struct sockaddr_un sa;
+struct timespec t0, t1;
+uint8_t *map = NULL;
+int32_t p, rc = 0;
+int fd;
+
+  memset(m, 0, sizeof(*m));
+  memcpy(hdr.magic, SNAP_MAGIC, sizeof(hdr.magic));
+
+  if((fd = snap_unix(path, &sa)) < 0)
+    return -1;
+
+  if(connect(fd, (struct sockaddr *)&sa, sizeof(sa))
+    || !(map = malloc(np))
+    || !(s.f = fdopen(dup(fd), "w")))
+  {
+    rc = errno;
+    free(map);
+    close(fd);
+    errno = rc;
+    return -1;
+  }
+
+  SNAP(&s, hdr);
+
+  memset(map, 1, np);
+  snap_stop(sys, status);
+  dirty_reset(sys);
+
+  do {
+    snap_start(sys, status);
+
+    for(p = 0; p < np && !s.err; ++p)
+      if(map[p] && (m->rounds || !snap_zero(sys->physstor + (size_t)p * em50_pgoc_size)))
+      {
+        SNAP(&s, p);
+        snap_io(&s, sys->physstor + (size_t)p * em50_pgoc_size, em50_pgoc_size);
+        ++m->pages;
+      }
+    p = -1;
+    SNAP(&s, p);
+    ++m->rounds;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    snap_stop(sys, status);
+    d = dirty_sync(sys);
+
+    if(s.err || d <= SNAP_RESIDUE || m->rounds >= SNAP_ROUNDS)
+      break;
+
+    dirty_take(sys, map);
+  } while(1);
+
+  p = -2;
+  SNAP(&s, p);
+  if(!s.err && fflush(s.f))
+    s.err = errno;
+  if(!s.err && (m->lines = amlc_handoff(cpu, fd, true)) < 0)
+    s.err = errno;
+
+  m->last = d;
+  dirty_take(sys, map);
+  snap_pages(&s, sys, map);
+  snap_state(&s, cpu, sys->ncpu, status);
+
+  if(fclose(s.f) && !s.err)
+    s.err = errno;
+
+  if(!s.err && recv(fd, &rc, sizeof(rc), MSG_WAITALL) != sizeof(rc))
+    s.err = errno ? errno : EPIPE;
+  if(!s.err)
+    s.err = rc;
+
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+  m->held = (t1.tv_sec - t0.tv_sec) * 1e3 + (t1.tv_nsec - t0.tv_nsec) / 1e6;
+
+  close(fd);
+  free(map);
+
+  if(s.err)
+  {
+    memset(sys->dirty, 1, np);
+    snap_start(sys, status);
+    errno = s.err;
+    return -1;
+  }
+
+  return 0;
+}
+
+
+/* Wait on the unix socket path for a system to migrate here, the
+ * storage size it sends is returned so that storage can be
+ * allocated to match
+ */
+int snap_accept(const char *path, size_t *physsize)
+{
+struct sockaddr_un sa;
+snaphdr_t hdr;
+int ls, fd = -1;
+
+  if((ls = snap_unix(path, &sa)) < 0)
+    return -1;
+
+  unlink(path);
+  if(!bind(ls, (struct sockaddr *)&sa, sizeof(sa)) && !listen(ls, 1))
+  {
+    printf("Waiting for migration on %s\n", path);
+    fd = accept(ls, NULL, NULL);
+  }
+
+  int err = errno;
+  close(ls);
+  unlink(path);
+
+  if(fd < 0)
+  {
+    errno = err;
+    return -1;
+  }
+  ioctl(fd, FIOCLEX, NULL);
+
+  if(recv(fd, &hdr, sizeof(hdr), MSG_PEEK | MSG_WAITALL) != sizeof(hdr)
+    || memcmp(hdr.magic, SNAP_MAGIC, sizeof(hdr.magic))
+    || hdr.version != SNAP_VERSION)
+  {
+    close(fd);
+    errno = EINVAL;
+    return -1;
+  }
+
+  *physsize = hdr.physsize;
+
+  return fd;
+}
+
+
+/* Receive a migration on the connection from snap_accept, the stream
+ * is unbuffered so that the AMLC connections are not read past.
+ * Disk records of a source with overlays go to overlays in
+ * <path>.restored as for a restored checkpoint.
+ */
+int snap_incoming(cpu_t *cpu, int fd)
+{
+sys_t *sys = cpu->sys;
+int status[EM50_MAXCPU];
+snaphdr_t hdr;
+snap_t s = { .wr = false };
+char ov[PATH_MAX];
+int32_t p;
+
+  if(!(s.f = fdopen(fd, "r+")))
+  {
+    close(fd);
+    return -1;
+  }
+  setvbuf(s.f, NULL, _IONBF, 0);
+
+  if(snap_rdhdr(s.f, &hdr))
+  {
+    fclose(s.f);
+    return -1;
+  }
+
+  s.type = hdr.type;
+
+  if(hdr.physsize != sys->physsize || hdr.ncpu > sys->ncpu)
+    s.err = EINVAL;
+
+  if(!s.err && hdr.type != SNAP_SAVE && !sys->overlay)
+  {
+    snprintf(ov, sizeof(ov), "%s.restored", sys->incoming);
+    if(snap_mkdir(ov))
+      s.err = errno;
+    else
+      sys->overlay = strdup(ov);
+  }
+
+  snap_stop(sys, status);
+  for(int n = hdr.ncpu; n < sys->ncpu; ++n)
+    status[n] = stopped;
+
+  if(!s.err)
+    madvise(sys->physstor, sys->physsize, MADV_DONTNEED);
+
+  for(SNAP(&s, p); !s.err && p != -2; SNAP(&s, p))
+    if(p >= 0 && p < dirty_pages(sys))
+      snap_io(&s, sys->physstor + (size_t)p * em50_pgoc_size, em50_pgoc_size);
+    else if(p != -1)
+      s.err = EINVAL;
+
+  if(!s.err && amlc_handoff(cpu, fd, false) < 0)
+    s.err = errno ? errno : EPIPE;
+
+  snap_pages(&s, sys, NULL);
+  snap_state(&s, cpu, hdr.ncpu, status);
+
+  for(int n = 0; n < sys->ncpu; ++n)
+  {
+    mm_ptlb(sys->cpu[n]);
+    mm_piotlb(sys->cpu[n]);
+  }
+  ic_purge(cpu);
+  memset(sys->dirty, 1, dirty_pages(sys));
+
+  int32_t rc = s.err;
+  if(send(fd, &rc, sizeof(rc), 0) != sizeof(rc) && !s.err)
+    s.err = errno;
+  fclose(s.f);
+
+  if(s.err)
+  {
+    io_hold(cpu, false);
+    errno = s.err;
+    return -1;
+  }
+
+  snap_start(sys, status);
+
+  return 0;
+}
@@ -0,0 +1,106 @@
+/* Machine Snapshots
+ *
+ *
+ * Copyright Notice:
+ *
+ *   Copyright (C) 1999-2020 Jan Jaeger, All Rights Reserved.
+ *
+ *
+ * This file is part of the Prime 50 Series Emulator (em50).
+ *
+ *
+ * License Statement:
+ *
+ *   The Prime 50 Series Emulator (em50) is free software:
+ *   You can redistribute it and/or modify it under the terms
+ *   of the GNU General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License,
+ *   or (at your option) any later version.
+ *
+ *   em50 is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *   See the GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with em50.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef _snap_h
+#define _snap_h
+
+#define SNAP_MAGIC   "EM50SNAP"
+#define SNAP_VERSION 4
+#define SNAP_ALIGN   0x10000  // Storage offset, a multiple of any host page size
+#define SNAP_DEPTH   4096     // Deltas in a checkpoint chain
+#define SNAP_ROUNDS  30       // Migration rounds while running
+#define SNAP_RESIDUE 64       // Pages left to send with the CPUs held
+
+/* A snapshot file holds a header, the state records of the system,
+ * the CPUs and the devices, and then physical storage at an aligned
+ * offset so that it can be mapped rather than read on restore.
+ * All-zero storage pages are left as holes in the file.
+ * A checkpoint delta names its parent after the header and holds
+ * only the pages written since the parent, as records after the
+ * state, its offset is 0.
+ */
+typedef struct {
+  char     magic[8];
+  uint32_t version;
+  uint32_t ncpu;
+  uint64_t physsize;
+  uint64_t offset;    // Storage
+  uint32_t type;
+#define SNAP_SAVE  0
+#define SNAP_BASE  1  // Checkpoint with all of storage
+#define SNAP_DELTA 2  // Checkpoint with the pages written since the parent
+#define SNAP_CLONE 3  // All of storage and the disk overlay records, for CLONE
+  uint32_t spare;
+} snaphdr_t;
+
+/* The same routine saves or restores a piece of state, depending
+ * on wr, each piece starts with a tag that is checked on restore
+ */
+typedef struct snap_t {
+  FILE *f;
+  bool wr;
+  int err;            // First error, EINVAL for a mismatched record
+  int type;           // snaphdr_t.type
+} snap_t;
+
+void snap_io(snap_t *, void *, size_t);
+void snap_tag(snap_t *, const char *, int);
+void snap_str(snap_t *, char **);
+
+#define SNAP(_s, _v) snap_io((_s), (void *)&(_v), sizeof(_v))
+
+void snap_stop(sys_t *, int *);
+void snap_start(sys_t *, int *);
+
+int snap_save(cpu_t *, const char *);
+int snap_restore(cpu_t *, const char *);
+size_t snap_physsize(const char *);
+int snap_clone(cpu_t *, int, int, int);
+ssize_t snap_checkpoint(cpu_t *, const char *, bool);
+
+/* A migration streams the header, then rounds of page records, each
+ * ended by -1, while the source runs.  -2 marks the CPUs held, the
+ * AMLC connections follow as SCM_RIGHTS messages and then the last
+ * pages and the state as in a delta.  The destination answers with
+ * its error number, 0 once it has taken over.
+ */
+typedef struct {
+  int rounds;
+  size_t pages;       // Sent while running
+  size_t last;        // Sent with the CPUs held
+  int lines;          // AMLC connections handed over
+  double held;        // Milliseconds the CPUs were held
+} snapmig_t;
+
+int snap_migrate(cpu_t *, const char *, snapmig_t *);
+int snap_accept(const char *, size_t *);
+int snap_incoming(cpu_t *, int);
+
+#endif
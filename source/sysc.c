@@ -34,6 +34,8 @@
 
 #include "sysc.h"
 
+#include "snap.h"
+
 #if 0
 #undef logmsg
 #define logmsg(...) logall(__VA_ARGS__)
@@ -255,6 +257,48 @@ sc_t *sc = cpu->sc;
 }
 
 
+/* Without a CP the console output is copied to stdout until the
+ * CPU halts, there is no console input
+ */
+int sysc_detach(cpu_t *cpu)
+{
+sc_t *sc = cpu->sc;
+struct pollfd pfd = {.fd = sc->pr[0], .events = POLLIN};
+char buf[256];
+ssize_t n;
+int count;
+
+  do {
+    if((count = poll(&pfd, 1, 1000)) > 0)
+      while((n = read(sc->pr[0], buf, sizeof(buf))) > 0)
+        write(STDOUT_FILENO, buf, n);
+  } while(cpu->halt.status == started || count > 0);
+
+  return 0;
+}
+
+
+static void sc_snap(sc_t *sc, snap_t *s)
+{
+  SNAP(s, sc->rv);
+  SNAP(s, sc->tv);
+  SNAP(s, sc->rc);
+  SNAP(s, sc->tc);
+  SNAP(s, sc->rm);
+  SNAP(s, sc->tm);
+  SNAP(s, sc->r1);
+  SNAP(s, sc->t1);
+  SNAP(s, sc->r2);
+  SNAP(s, sc->t2);
+  SNAP(s, sc->im);
+  SNAP(s, sc->ri);
+  SNAP(s, sc->ti);
+  SNAP(s, sc->echo);
+  SNAP(s, sc->eplxout);
+  SNAP(s, sc->eplxin);
+}
+
+
 int sysc_io(cpu_t *cpu, int type, int ext, int func, int ctrl, void **devparm, int argc, char *argv[])
 {
 sc_t *sc = *devparm;
@@ -469,6 +513,9 @@ sc_t *sc = *devparm;
     case IO_TYPE_INI:
       sc_init(cpu, type, ext, func, ctrl, (sc_t **)devparm, argc, argv);
       break;
+    case IO_TYPE_SNP:
+      sc_snap(sc, (snap_t *)argv);
+      break;
   }
 
   return 1;
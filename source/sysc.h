@@ -62,5 +62,6 @@ typedef struct sc_t {
 int sysc_io(cpu_t *cpu, int, int, int, int, void **, int, char *[]);
 void sysc_input(cpu_t *, char *);
 int sysc_term(cpu_t *);
+int sysc_detach(cpu_t *);
 
 #endif
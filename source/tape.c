@@ -47,6 +47,8 @@
 
 #include "tape.h"
 
+#include "snap.h"
+
 #ifdef DEBUG
 static const char *mtstat[] = { "TMK", "ERR", "EOM", "BOF", "BOT", "OFL", "ONL", "WTM" };
 static const char *drn[] = { "current status word", "id number", "dmx channel number", "vector interrupt addr", "current status word2" };
@@ -253,6 +255,12 @@ mt_t *mt = parm;
   while(mt->pthread.tid)
   {
     pthread_cond_wait(&mt->pthread.cond, &mt->pthread.mutex);
+    while(mt->hold)
+    {
+      pthread_mutex_unlock(&mt->pthread.mutex);
+      usleep(1000);
+      pthread_mutex_lock(&mt->pthread.mutex);
+    }
     motion_setup(mt);
     mt->busy = 0;
   }
@@ -261,6 +269,53 @@ mt_t *mt = parm;
 }
 
 
+/* Mounted tapes are opened again and positioned as they were
+ */
+static void mt_snap(mt_t *mt, snap_t *s)
+{
+  pthread_mutex_lock(&mt->pthread.mutex);
+
+  SNAP(s, mt->busy);
+  SNAP(s, mt->pending);
+  SNAP(s, mt->cdr);
+  SNAP(s, mt->dr);
+  SNAP(s, mt->mo);
+  SNAP(s, mt->ms);
+  SNAP(s, mt->ff);
+  SNAP(s, mt->dv);
+  SNAP(s, mt->in);
+  SNAP(s, mt->intr);
+
+  for(int dv = 0; dv < (sizeof(mt->tm)/sizeof(*mt->tm)); ++dv)
+  {
+  tm_t *tm = &mt->tm[dv];
+  int md = tm->md;
+  off_t pos = (tm->fd >= 0) ? lseek(tm->fd, 0, SEEK_CUR) : 0;
+
+    snap_str(s, &tm->fn);
+    SNAP(s, md);
+    SNAP(s, pos);
+    SNAP(s, tm->sw);
+    SNAP(s, tm->max);
+
+    if(!s->wr && !s->err)
+    {
+      mt_close(tm);
+      if(md != cl && mt_open(tm) >= 0)
+      {
+        tm->md = md;
+        lseek(tm->fd, pos, SEEK_SET);
+      }
+    }
+  }
+
+  if(!s->wr && !s->err && mt->busy)
+    pthread_cond_signal(&mt->pthread.cond);
+
+  pthread_mutex_unlock(&mt->pthread.mutex);
+}
+
+
 static void mt_init(cpu_t *cpu, int type, int ext, int func, int ctrl, mt_t **mt, int argc, char *argv[])
 {
   (*mt) = calloc(1, sizeof(mt_t));
@@ -447,15 +502,27 @@ if(mt->pending) io_setintv(cpu, &mt->intr, mt->va);
       {
         uint16_t n = mt_read(&mt->tm[ext], physad(cpu, MT_ADDR_IPL), 8192);
         if(n > 0)
+        {
           cpu->srf.drf.dma_h[040] = (n>>1) + MT_ADDR_IPL;
+          dirty_range(cpu, MT_ADDR_IPL, n>>1);
+        }
         else
           logmsg("tape %03o boot failed\n", mt->ctrl);
+        ic_purge(cpu);
       }
       pthread_mutex_unlock(&mt->pthread.mutex);
       break;
     case IO_TYPE_INI:
       mt_init(cpu, type, ext, func, ctrl, (mt_t **)devparm, argc, argv);
       break;
+    case IO_TYPE_SNP:
+      mt_snap(mt, (snap_t *)argv);
+      break;
+    case IO_TYPE_HLD:
+      pthread_mutex_lock(&mt->pthread.mutex);
+      mt->hold = argc;
+      pthread_mutex_unlock(&mt->pthread.mutex);
+      break;
     case IO_TYPE_CLS:
       pthread_mutex_lock(&mt->pthread.mutex);
       mt_close(&mt->tm[ext]);
@@ -69,6 +69,7 @@ typedef struct mt_t {
   cpu_t *cpu;
 int busy;
 int pending;
+  int hold; // Held between motions by io_hold
   uint16_t ctrl;
   struct {
     pthread_t tid;
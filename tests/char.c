@@ -0,0 +1,819 @@
+/* Character Instruction Test
+ *
+ *
+ * Copyright Notice:
+ *
+ *   Copyright (C) 1999-2020 Jan Jaeger, All Rights Reserved.
+ *
+ *
+ * This file is part of the Prime 50 Series Emulator (em50).
+ *
+ *
+ * License Statement:
+ *
+ *   The Prime 50 Series Emulator (em50) is free software:
+ *   You can redistribute it and/or modify it under the terms
+ *   of the GNU General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License,
+ *   or (at your option) any later version.
+ *
+ *   em50 is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *   See the GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with em50.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/* Runs ZMV, ZMVD, ZFIL, ZCM and ZTRN of char.c, which move and compare
+ * a page span at a time, against the byte and word at a time code they
+ * replaced, on random operands in a segment whose pages are scattered
+ * over physical storage.  Operands start at either byte of a word, near
+ * or across page boundaries, and may overlap each other and the
+ * translate table.  Storage, FAR/FBR/FLR and the condition codes must
+ * be the same after both.
+ *
+ *   char [-n count] [-s seed]
+ */
+
+
+#include "emu.h"
+
+#include "mode.h"
+
+#include "opcode.h"
+
+#include "char.h"
+
+
+/* The code replaced, as it was in char.c, for V mode */
+
+static inline void old_move(cpu_t *cpu, uint32_t src, int srb, int srl, uint32_t dst, int dsb, int dsl)
+{
+  while(srl && dsl)
+  {
+  uint16_t w;
+    
+    w = E50X(vfetch_w)(cpu, src);
+
+    if(dsb == 0 && srb == 0 && dsl > 1 && srl > 1)
+    {
+      E50X(vstore_w)(cpu, dst, w);
+      inc_d(&src);
+      inc_d(&dst);
+      srl -= 2;
+      dsl -= 2;
+    }
+    else if(dsb != 0 && srb != 0)
+    {
+      uint16_t t = E50X(vfetch_w)(cpu, dst);
+      t = (t & 0xff00) | (w & 0x00ff);
+      E50X(vstore_w)(cpu, dst, t);
+      inc_d(&src); srb = 0;
+      inc_d(&dst); dsb = 0;
+      --srl;
+      --dsl;
+    }
+    else if(dsb != 0 && srb == 0)
+    {
+      uint16_t t = E50X(vfetch_w)(cpu, dst);
+      t = (t & 0xff00) | (w >> 8);
+      E50X(vstore_w)(cpu, dst, t);
+      srb = 8;
+      inc_d(&dst); dsb = 0;
+      --srl;
+      --dsl;
+    }
+    else if(dsb == 0 && srb != 0)
+    {
+      uint16_t t = E50X(vfetch_w)(cpu, dst);
+      t = (t & 0x00ff) | (w << 8);
+      E50X(vstore_w)(cpu, dst, t);
+      inc_d(&src); srb = 0;
+      dsb = 8;
+      --srl;
+      --dsl;
+    }
+    else /* dsb == 0 && srb == 0 && srl == 1 */
+    {
+      uint16_t t = E50X(vfetch_w)(cpu, dst);
+      t = (t & 0x00ff) | (w & 0xff00);
+      E50X(vstore_w)(cpu, dst, t);
+      srb = 8;
+      dsb = 8;
+      --srl;
+      --dsl;
+    }
+  }
+
+  uint16_t w = cpu->crs->km.ascii ? 020040: 0120240;
+
+  while(dsl)
+  {
+    if(dsb == 0 && dsl > 1)
+    {
+      E50X(vstore_w)(cpu, dst, w);
+      inc_d(&dst);
+      dsl -= 2;
+    }
+    else if(dsb != 0)
+    {
+      uint16_t t = E50X(vfetch_w)(cpu, dst);
+      t = (t & 0xff00) | (w & 0x00ff);
+      E50X(vstore_w)(cpu, dst, t);
+      inc_d(&dst); dsb = 0;
+      --dsl;
+    }
+    else /* dsl == 1 */
+    {
+      uint16_t t = E50X(vfetch_w)(cpu, dst);
+      t = (t & 0x00ff) | (w & 0xff00);
+      E50X(vstore_w)(cpu, dst, t);
+      dsb = 8;
+      --dsl;
+    }
+  }
+
+  S_FAR(cpu, 0, src);
+  S_FBR(cpu, 0, srb);
+  S_FLR(cpu, 0, srl);
+  S_FAR(cpu, 1, dst);
+  S_FBR(cpu, 1, dsb);
+  S_FLR(cpu, 1, dsl);
+}
+
+static inline void old_compare(cpu_t *cpu, uint32_t src, int srb, int srl, uint32_t dst, int dsb, int dsl)
+{
+  cc_sync(cpu);
+  cpu->crs->km.eq = 1;
+  cpu->crs->km.lt = 0;
+
+  while(srl && dsl)
+  {
+  uint16_t t, w = E50X(vfetch_w)(cpu, src);
+
+    if(dsb == 0 && srb == 0 && dsl > 1 && srl > 1)
+    {
+      t = E50X(vfetch_w)(cpu, dst);
+      inc_d(&src);
+      inc_d(&dst);
+      srl -= 2;
+      dsl -= 2;
+    }
+    else if(dsb != 0 && srb != 0)
+    {
+      w &= 0x00ff;
+      t = E50X(vfetch_w)(cpu, dst);
+      t &= 0x00ff;
+      inc_d(&src); srb = 0;
+      inc_d(&dst); dsb = 0;
+      --srl;
+      --dsl;
+    }
+    else if(dsb != 0 && srb == 0)
+    {
+      w >>= 8;
+      t = E50X(vfetch_w)(cpu, dst);
+      t &= 0x00ff;
+      srb = 8;
+      inc_d(&dst); dsb = 0;
+      --srl;
+      --dsl;
+    }
+    else if(dsb == 0 && srb != 0)
+    {
+      w &= 0x00ff;
+      t = E50X(vfetch_w)(cpu, dst);
+      t >>= 8;
+      inc_d(&src); srb = 0;
+      dsb = 8;
+      --srl;
+      --dsl;
+    }
+    else /* dsb == 0 && srb == 0 && srl == 1 */
+    {
+      w &= 0xff00;
+      t = E50X(vfetch_w)(cpu, dst);
+      t &= 0xff00;
+      srb = 8;
+      dsb = 8;
+      --srl;
+      --dsl;
+    }
+
+    if(w != t)
+    {
+      if((w & 0xff00) == (t & 0xff00))
+      {
+        S_FAR(cpu, 0, src-1);
+        S_FBR(cpu, 0, srb ? 0 : 8);
+        S_FLR(cpu, 0, srl+1);
+        S_FAR(cpu, 1, dst-1);
+        S_FBR(cpu, 1, dsb ? 0 : 8);
+        S_FLR(cpu, 1, dsl+1);
+      }
+      else
+      {
+        S_FAR(cpu, 0, src-2);
+        S_FLR(cpu, 0, srl+2);
+        S_FAR(cpu, 1, dst-2);
+        S_FLR(cpu, 1, dsl+2);
+      }
+      cc_sync(cpu);
+      cpu->crs->km.eq = 0;
+      cpu->crs->km.lt = w < t ? 1 : 0;
+      return;
+    }
+  }
+
+  while(dsl)
+  {
+    uint16_t t, w = cpu->crs->km.ascii ? 020040: 0120240;
+
+//  S_FAR(cpu, 1, dst);
+//  S_FBR(cpu, 1, dsb);
+//  S_FLR(cpu, 1, dsl);
+
+    if(dsb == 0 && dsl > 1)
+    {
+      t = E50X(vfetch_w)(cpu, dst);
+      inc_d(&dst);
+      dsl -= 2;
+    }
+    else if(dsb != 0)
+    {
+      w &= 0x00ff;
+      t = E50X(vfetch_w)(cpu, dst);
+      t &= 0x00ff;
+      inc_d(&dst); dsb = 0;
+      --dsl;
+    }
+    else /* dsb == 0 && dsl == 1 */
+    {
+      w &= 0xff00;
+      t = E50X(vfetch_w)(cpu, dst);
+      t &= 0xff00;
+      dsb = 8;
+      --dsl;
+    }
+
+    if(w != t)
+    {
+      if((w & 0xff00) == (t & 0xff00))
+      {
+        S_FAR(cpu, 1, dst-1);
+        S_FBR(cpu, 1, dsb ? 0 : 8);
+        S_FLR(cpu, 1, dsl+1);
+      }
+      else
+      {
+        S_FAR(cpu, 1, dst-2);
+        S_FLR(cpu, 1, dsl+2);
+      }
+      cc_sync(cpu);
+      cpu->crs->km.eq = 0;
+      cpu->crs->km.lt = w < t ? 1 : 0;
+      return;
+    }
+  }
+
+  while(srl)
+  {
+    uint16_t w, t = cpu->crs->km.ascii ? 020040: 0120240;
+
+//  S_FAR(cpu, 0, src);
+//  S_FBR(cpu, 0, srb);
+//  S_FLR(cpu, 0, srl);
+
+    if(srb == 0 && srl > 1)
+    {
+      w = E50X(vfetch_w)(cpu, src);
+      inc_d(&src);
+      srl -= 2;
+    }
+    else if(srb != 0)
+    {
+      t &= 0x00ff;
+      w = E50X(vfetch_w)(cpu, src);
+      w &= 0x00ff;
+      inc_d(&src); srb = 0;
+      --srl;
+    }
+    else /* srb == 0 && srl == 1 */
+    {
+      t &= 0xff00;
+      w = E50X(vfetch_w)(cpu, src);
+      w &= 0xff00;
+      srb = 8;
+      --srl;
+    }
+
+    if(w != t)
+    {
+      if((w & 0xff00) == (t & 0xff00))
+      {
+        S_FAR(cpu, 0, src-1);
+        S_FBR(cpu, 0, srb ? 0 : 8);
+        S_FLR(cpu, 0, srl+1);
+      }
+      else
+      {
+        S_FAR(cpu, 0, src-2);
+        S_FLR(cpu, 0, srl+2);
+      }
+      cc_sync(cpu);
+      cpu->crs->km.eq = 0;
+      cpu->crs->km.lt = w < t ? 1 : 0;
+      return;
+    }
+  }
+
+  S_FAR(cpu, 0, src);
+  S_FBR(cpu, 0, srb);
+  S_FLR(cpu, 0, srl);
+  S_FAR(cpu, 1, dst);
+  S_FBR(cpu, 1, dsb);
+  S_FLR(cpu, 1, dsl);
+}
+
+
+static inline uint8_t old_trtab(cpu_t *cpu, uint32_t trt, uint8_t c)
+{
+uint32_t x = intraseg_i(trt, (c >> 1));
+uint16_t t = E50X(vfetch_w)(cpu, x);
+
+  return (c & 1) ? t & 0xff : t >> 8;
+}
+
+static inline uint16_t old_trtab_w(cpu_t *cpu, uint32_t trt, uint16_t w)
+{
+sw_t r = {.w = w};
+
+  r.l = old_trtab(cpu, trt, r.l);
+  r.h = old_trtab(cpu, trt, r.h);
+
+  return r.w;
+}
+
+static inline uint16_t old_trtab_h(cpu_t *cpu, uint32_t trt, uint16_t w)
+{
+sw_t r = {.w = w};
+
+  r.h = old_trtab(cpu, trt, r.h);
+
+  return r.w;
+}
+
+static inline uint16_t old_trtab_l(cpu_t *cpu, uint32_t trt, uint16_t w)
+{
+sw_t r = {.w = w};
+
+  r.l = old_trtab(cpu, trt, r.l);
+
+  return r.w;
+}
+
+static inline void old_translate(cpu_t *cpu, uint32_t src, int srb, int srl, uint32_t dst, int dsb, int dsl, uint32_t trt)
+{
+  while(srl && dsl)
+  {
+  uint16_t w;
+    
+    w = E50X(vfetch_w)(cpu, src);
+
+    if(dsb == 0 && srb == 0 && srl > 1 && dsl > 1)
+    {
+      w = old_trtab_w(cpu, trt, w);
+      E50X(vstore_w)(cpu, dst, w);
+      inc_d(&src);
+      inc_d(&dst);
+      srl -= 2;
+      dsl -= 2;
+    }
+    else if(dsb != 0 && srb != 0)
+    {
+      w = old_trtab_l(cpu, trt, w);
+      uint16_t t = E50X(vfetch_w)(cpu, dst);
+      t = (t & 0xff00) | (w & 0x00ff);
+      E50X(vstore_w)(cpu, dst, t);
+      inc_d(&src); srb = 0;
+      inc_d(&dst); dsb = 0;
+      --srl;
+      --dsl;
+    }
+    else if(dsb != 0 && srb == 0)
+    {
+      w = old_trtab_h(cpu, trt, w);
+      uint16_t t = E50X(vfetch_w)(cpu, dst);
+      t = (t & 0xff00) | (w >> 8);
+      E50X(vstore_w)(cpu, dst, t);
+      srb = 8;
+      inc_d(&dst); dsb = 0;
+      --srl;
+      --dsl;
+    }
+    else if(dsb == 0 && srb != 0)
+    {
+      w = old_trtab_l(cpu, trt, w);
+      uint16_t t = E50X(vfetch_w)(cpu, dst);
+      t = (t & 0x00ff) | (w << 8);
+      E50X(vstore_w)(cpu, dst, t);
+      inc_d(&src); srb = 0;
+      dsb = 8;
+      --srl;
+      --dsl;
+    }
+    else /* dsb == 0 && srb == 0 && srl == 1 */
+    {
+      w = old_trtab_h(cpu, trt, w);
+      uint16_t t = E50X(vfetch_w)(cpu, dst);
+      t = (t & 0x00ff) | (w & 0xff00);
+      E50X(vstore_w)(cpu, dst, t);
+      srb = 8;
+      dsb = 8;
+      --srl;
+      --dsl;
+    }
+  }
+  S_FAR(cpu, 0, src);
+//S_FLR(cpu, 0, srl);
+  S_FBR(cpu, 0, srb);
+  S_FAR(cpu, 1, dst);
+  S_FLR(cpu, 1, dsl);
+  S_FBR(cpu, 1, dsb);
+}
+
+static void old_zfil(cpu_t *cpu, op_t op)
+{
+int f = FAR(op);
+uint32_t far = G_FAR(cpu, f);
+int flr = G_FLR(cpu, f);
+int bit = G_FBR(cpu, f);
+uint16_t c = G_A(cpu) & 0xff;
+
+  c |= c << 8;
+
+  while(flr)
+  {
+    if(bit != 0)
+    {
+      uint16_t w = E50X(vfetch_w)(cpu, far);
+      w &= 0xff00;
+      w |= c & 0xff;
+      E50X(vstore_w)(cpu, far, w);
+      --flr;
+      bit = 0;
+      inc_d(&far);
+    }
+    else
+    {
+      if(flr > 1)
+      {
+        E50X(vstore_w)(cpu, far, c);
+        flr -= 2;
+        inc_d(&far);
+      }
+      else /* flr == 1 */
+      {
+        uint16_t w = E50X(vfetch_w)(cpu, far);
+        w &= 0x00ff;
+        w |= c & 0xff00;
+        E50X(vstore_w)(cpu, far, w);
+        --flr;
+        bit = 8;
+      }
+    }
+  }
+
+  S_FLR(cpu, f, 0);
+  S_FAR(cpu, f, far);
+  S_FBR(cpu, f, bit);
+}
+
+static void old_zmvd(cpu_t *cpu, op_t op)
+{
+int len = G_FLR(cpu, 1);
+
+  old_move(cpu, G_FAR(cpu, 0), G_FBR(cpu, 0), len, G_FAR(cpu, 1), G_FBR(cpu, 1), len);
+}
+
+static void old_zmv(cpu_t *cpu, op_t op)
+{
+int srl = G_FLR(cpu, 0);
+int dsl = G_FLR(cpu, 1);
+
+  if(dsl < srl)
+    srl = dsl;
+
+  old_move(cpu, G_FAR(cpu, 0), G_FBR(cpu, 0), srl, G_FAR(cpu, 1), G_FBR(cpu, 1), dsl);
+}
+
+static void old_zcm(cpu_t *cpu, op_t op)
+{
+  old_compare(cpu, G_FAR(cpu, 0), G_FBR(cpu, 0), G_FLR(cpu, 0), G_FAR(cpu, 1), G_FBR(cpu, 1), G_FLR(cpu, 1));
+}
+
+static void old_ztrn(cpu_t *cpu, op_t op)
+{
+  old_translate(cpu, G_FAR(cpu, 0), G_FBR(cpu, 0), G_FLR(cpu, 1), G_FAR(cpu, 1), G_FBR(cpu, 1), G_FLR(cpu, 1), G_XB(cpu));
+}
+
+
+/* Test segment, its pages are put in random physical pages */
+
+#define SEG    01
+#define PAGES  em50_pages_in_segment
+#define PAGEB  (em50_page_size << 1)
+#define SDT    04000
+#define PMT    06000
+
+static uint32_t frame[PAGES];
+static uint8_t base[PAGES * PAGEB];
+static uint8_t image[PAGES * PAGEB];
+static uint8_t result[2][PAGES * PAGEB];
+
+static uint64_t seed = 0x9e3779b97f4a7c15ULL;
+
+static inline uint64_t rnd(void)
+{
+  seed ^= seed >> 12;
+  seed ^= seed << 25;
+  seed ^= seed >> 27;
+  return seed * 0x2545f4914f6cdd1dULL;
+}
+
+static void seg_init(cpu_t *cpu)
+{
+int n = cpu->maxmem >> em50_page_shift;
+uint8_t used[n];
+
+  memset(used, 0, n);
+
+  for(int p = 0; p < PAGES; ++p)
+  {
+    int f;
+    do f = 8 + rnd() % (n - 8); while(used[f]);
+    used[f] = 1;
+    frame[p] = f;
+    store_d(physad(cpu, PMT + (p << 1)), pmt_r | f);
+  }
+
+  store_d(physad(cpu, SDT + (SEG << 1)), PMT << sdw_s_s);
+  cpu->crs->dtar[ea_dtar(SEG << ea_s_s)] = ((1024 - (SEG + 1)) << sdt_s_s) | (SDT >> 1);
+  cpu->crs->km.sm = 1;
+
+  for(int i = 0; i < sizeof(base); ++i)
+    base[i] = rnd();
+}
+
+static void seg_load(cpu_t *cpu, const uint8_t *b)
+{
+  for(int p = 0; p < PAGES; ++p)
+    memcpy(physad(cpu, frame[p] << em50_page_shift), b + p * PAGEB, PAGEB);
+}
+
+static void seg_save(cpu_t *cpu, uint8_t *b)
+{
+  for(int p = 0; p < PAGES; ++p)
+    memcpy(b + p * PAGEB, physad(cpu, frame[p] << em50_page_shift), PAGEB);
+}
+
+
+/* Random operands */
+
+typedef struct {
+  uint32_t far[2];  // word within the segment
+  int fbr[2];
+  int flr[2];
+  uint32_t xb;
+  uint8_t a;
+  int ascii;
+} zcase_t;
+
+typedef struct {
+  uint32_t far[2];
+  uint32_t fxr[2];
+  int eq, lt;
+} zregs_t;
+
+/* Mostly close to the end of a page, never more than 8 pages from the
+   end of the segment */
+static uint32_t rnd_addr(void)
+{
+int p = rnd() % (PAGES - 8);
+int o = (rnd() & 1) ? em50_page_size - 1 - rnd() % 48 : rnd() % em50_page_size;
+
+  return (p << em50_page_shift) | o;
+}
+
+static int rnd_len(void)
+{
+  switch(rnd() % 4) {
+    case 0:
+      return rnd() % 8;
+    case 1:
+      return rnd() % 100;
+    default:
+      return rnd() % (3 * PAGEB);
+  }
+}
+
+static inline int zbyte(const zcase_t *c, int n)
+{
+  return (c->far[n] << 1) + (c->fbr[n] ? 1 : 0);
+}
+
+static void gen(zcase_t *c)
+{
+  for(int n = 0; n < 2; ++n)
+  {
+    c->far[n] = rnd_addr();
+    c->fbr[n] = (rnd() & 1) ? 8 : 0;
+    c->flr[n] = rnd_len();
+  }
+
+  /* Overlapping operands */
+  if(!(rnd() % 4))
+  {
+    c->far[1] = c->far[0] + rnd() % 9 - 4;
+    c->fbr[1] = (rnd() & 1) ? 8 : 0;
+  }
+
+  c->xb = rnd_addr();
+  c->a = rnd();
+  c->ascii = rnd() & 1;
+}
+
+static void gen_zcm(zcase_t *c)
+{
+uint8_t blank = c->ascii ? 040 : 0240;
+
+  gen(c);
+  if(rnd() & 1)
+    c->flr[1] = c->flr[0] + rnd() % 9 - 4;
+  if(c->flr[1] < 0)
+    c->flr[1] = 0;
+
+  int s = zbyte(c, 0), d = zbyte(c, 1);
+  int n = c->flr[0] < c->flr[1] ? c->flr[0] : c->flr[1];
+
+  memmove(image + d, image + s, n);
+
+  /* Blank padding of the longer operand */
+  int l = c->flr[0] > c->flr[1] ? 0 : 1;
+  if(rnd() % 4)
+    memset(image + zbyte(c, l) + n, blank, c->flr[l] - n);
+
+  /* At most one difference */
+  int m = c->flr[l];
+  if(m && (rnd() & 1))
+  {
+    int k = (rnd() & 1) ? m - 1 - rnd() % (m < 8 ? m : 8) : rnd() % m;
+    image[zbyte(c, rnd() & 1 ? 0 : 1) + k] ^= 1 << (rnd() % 8);
+  }
+}
+
+static void gen_ztrn(zcase_t *c)
+{
+  gen(c);
+
+  /* Table overlaid by the destination or the source */
+  if(!(rnd() % 4))
+    c->xb = c->far[rnd() & 1] + rnd() % 129 - 128;
+}
+
+static void apply(cpu_t *cpu, const zcase_t *c)
+{
+  for(int n = 0; n < 2; ++n)
+  {
+    S_FAR(cpu, n, (SEG << ea_s_s) | c->far[n]);
+    S_FXR(cpu, n, 0);
+    S_FLR(cpu, n, c->flr[n]);
+    S_FBR(cpu, n, c->fbr[n]);
+  }
+
+  S_XB(cpu, (SEG << ea_s_s) | (c->xb & ea_w));
+  S_A(cpu, c->a);
+  cc_sync(cpu);
+  cpu->crs->km.ascii = c->ascii;
+  cpu->crs->km.eq = 0;
+  cpu->crs->km.lt = 1;
+}
+
+static void state(cpu_t *cpu, zregs_t *r)
+{
+  for(int n = 0; n < 2; ++n)
+  {
+    r->far[n] = G_FAR(cpu, n);
+    r->fxr[n] = G_FXR(cpu, n);
+  }
+
+  cc_sync(cpu);
+  r->eq = cpu->crs->km.eq;
+  r->lt = cpu->crs->km.lt;
+}
+
+
+typedef struct {
+  const char *name;
+  uint8_t op[2];
+  void (*inst)(cpu_t *, op_t);
+  void (*old)(cpu_t *, op_t);
+  void (*gen)(zcase_t *);
+} zop_t;
+
+static const zop_t zop[] = {
+  { "zmv",  { 002, 0114 }, E50X(zmv),  old_zmv,  gen },
+  { "zmvd", { 002, 0115 }, E50X(zmvd), old_zmvd, gen },
+  { "zfil", { 002, 0116 }, E50X(zfil), old_zfil, gen },
+  { "zcm",  { 002, 0117 }, E50X(zcm),  old_zcm,  gen_zcm },
+  { "ztrn", { 002, 0110 }, E50X(ztrn), old_ztrn, gen_ztrn },
+};
+
+#define NUM(_a) (sizeof(_a) / sizeof(*(_a)))
+
+
+static int check(cpu_t *cpu, const zop_t *o, long n)
+{
+int fail = 0;
+
+  for(long i = 0; i < n; ++i)
+  {
+    zcase_t c;
+    zregs_t r[2];
+
+    memcpy(image, base, sizeof(image));
+    o->gen(&c);
+
+    for(int k = 0; k < 2; ++k)
+    {
+      seg_load(cpu, image);
+      apply(cpu, &c);
+      (k ? o->old : o->inst)(cpu, (uint8_t *)o->op);
+      state(cpu, &r[k]);
+      seg_save(cpu, result[k]);
+    }
+
+    if(memcmp(&r[0], &r[1], sizeof(*r)) || memcmp(result[0], result[1], sizeof(result[0])))
+    {
+      if(++fail <= 10)
+      {
+        int b = 0;
+        while(b < sizeof(result[0]) && result[0][b] == result[1][b])
+          ++b;
+        printf("%s far0 %o/%d flr0 %d far1 %o/%d flr1 %d xb %o: far %x %x fxr %x %x cc %d%d, old far %x %x fxr %x %x cc %d%d, storage %s at byte %o\n",
+          o->name, c.far[0], c.fbr[0], c.flr[0], c.far[1], c.fbr[1], c.flr[1], c.xb,
+          r[0].far[0], r[0].far[1], r[0].fxr[0], r[0].fxr[1], r[0].eq, r[0].lt,
+          r[1].far[0], r[1].far[1], r[1].fxr[0], r[1].fxr[1], r[1].eq, r[1].lt,
+          b < sizeof(result[0]) ? "differs" : "same", b);
+      }
+    }
+  }
+
+  return fail;
+}
+
+
+int main(int argc, char *argv[])
+{
+long n = 2000;
+int fail = 0;
+int c;
+
+  while((c = getopt(argc, argv, "n:s:")) != -1)
+    switch(c) {
+      case 'n':
+        n = strtol(optarg, NULL, 0);
+        break;
+      case 's':
+        seed = strtoull(optarg, NULL, 0) | 1;
+        break;
+      default:
+        fprintf(stderr, "usage: %s [-n count] [-s seed]\n", argv[0]);
+        return 1;
+    }
+
+  sys_t sys = { .progname = argv[0], .physsize = 0x100000 };
+  sys.physstor = mmap(NULL, sys.physsize, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+  cpu_t cpu = { .sys = &sys, .maxmem = sys.physsize >> 1 };
+
+  em50_init(&cpu);
+  const struct sched_param sparam = { .sched_priority = 0 };
+  pthread_setschedparam(pthread_self(), SCHED_OTHER, &sparam);
+
+  seg_init(&cpu);
+
+  printf("%-6s %10s %10s\n", "op", "count", "differ");
+  for(int i = 0; i < NUM(zop); ++i)
+  {
+    int f = check(&cpu, &zop[i], n);
+    printf("%-6s %10ld %10d\n", zop[i].name, n, f);
+    fail += f;
+  }
+
+  fflush(stdout);
+  _exit(fail ? 1 : 0);
+}
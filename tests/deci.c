@@ -0,0 +1,921 @@
+/* Decimal Conversion Test
+ *
+ *
+ * Copyright Notice:
+ *
+ *   Copyright (C) 1999-2020 Jan Jaeger, All Rights Reserved.
+ *
+ *
+ * This file is part of the Prime 50 Series Emulator (em50).
+ *
+ *
+ * License Statement:
+ *
+ *   The Prime 50 Series Emulator (em50) is free software:
+ *   You can redistribute it and/or modify it under the terms
+ *   of the GNU General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License,
+ *   or (at your option) any later version.
+ *
+ *   em50 is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *   See the GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with em50.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/* Runs the decimal operand conversions of deci.c, which work in 64 bits
+ * and move operands a page span at a time, against the 128 bit digit at
+ * a time code they replaced.  XAD, XCM, XMV, XMP and XDV reach storage
+ * only through load_decimal and store_decimal, and scale and divide only
+ * through dcw_scale, dec_div and dec_rem, so these are compared directly:
+ * all five field types, 0 to 63 digits, either sign and zone, odd byte
+ * offsets and fields across a page boundary in a segment whose pages are
+ * scattered over physical storage.  Values, storage and FAR/FBR must be
+ * the same after both.
+ *
+ *   deci [-n count] [-s seed]   compare
+ *   deci -b [-n count]          time both implementations
+ */
+
+
+/* deci.c is built into this test in place of deci.o, for its static
+   conversion routines */
+#include "../source/deci.c"
+
+#include <time.h>
+
+#undef  E50X
+#define E50X(_n) e64v_ ## _n
+
+
+/* The code replaced, as it was in deci.c, for V mode */
+
+static inline intdec_t old_dcw_scale(dcw_t dcw, int xmv, intdec_t value)
+{
+  int16_t scale = (dcw.g & 0x40) ? dcw.g | 0xff80 : dcw.g;
+
+//printf("scale %d, value %jd\n", scale, (intmax_t)value);
+  if(scale < 0)
+  {
+    intdec_t mult = pow(10, -scale);
+    value *= mult;
+  }
+  else if(scale > 0)
+  {
+//static const int adj[] = { 1, 0, 1, 0, 0 };
+//int lz = value ? dcw.f - log10(value >= 0 ? value : -value) - adj[dcw.e] : 0;
+//if(lz) printf("lz %d v %jd\n", lz, (intmax_t)value);
+//    if(!xmv && lz < scale)
+//      scale += lz;
+    intdec_t div = pow(10, scale < 40 ? scale : 39);
+    if(!div) { div = 1; value = 0;}
+// THIS IS WRONG FOR XCM, WHICH SHOULD IGNORE DCW.D
+    intdec_t rnd = (!xmv || (xmv && dcw.d)) ? div / 2 : 0;
+//  intdec_t rnd = (xmv && dcw.d) ? div / 2 : 0;
+    value = (value + (value > 0 ? rnd : -rnd)) / div;
+//printf("value %jd\n", (intmax_t)value);
+  }
+
+  return value;
+}
+
+
+static inline void old_store_bytes(cpu_t *cpu, uint8_t *bytes, int count, uint32_t *far, int *fbr)
+{
+  if(count == 0)
+    return;
+
+  if(*fbr != 0)
+  {
+  uint16_t w = (E50X(vfetch_w)(cpu, *far) & 0xff00) | *bytes++;
+    E50X(vstore_w)(cpu, (*far), w);
+    inc_d(far);
+    --count;
+    *fbr = 0;
+  }
+
+  for(int n = count / 2; n > 0; --n, count -= 2)
+  {
+  uint16_t w = *bytes++ << 8;
+           w |= *bytes++;
+    E50X(vstore_w)(cpu, (*far), w);
+    inc_d(far);
+  }
+
+  if(count > 0)
+  {
+  uint16_t w = (E50X(vfetch_w)(cpu, *far) & 0x00ff) | (*bytes << 8);
+    E50X(vstore_w)(cpu, *far, w);
+    *fbr = 8;
+  }
+}
+
+static inline void old_store_ls(cpu_t *cpu, int digits, intdec_t value, uint32_t *far, int *fbr)
+{
+uint8_t ls[digits + 1];
+
+
+  ls[0] = value < 0 ? '-' : '+';
+  if(!cpu->crs->km.ascii)
+    ls[0] |= 0x80;
+
+  if(value < 0)
+    value = -value;
+
+  for(int n = digits; n > 0; --n)
+  {
+    ls[n] = '0' + (value % 10);
+    value /= 10;
+    if(!cpu->crs->km.ascii)
+      ls[n] |= 0x80;
+  }
+
+  old_store_bytes(cpu, ls, digits + 1, far, fbr);
+}
+
+static inline void old_store_ts(cpu_t *cpu, int digits, intdec_t value, uint32_t *far, int *fbr)
+{
+uint8_t ls[digits + 1];
+
+
+  int neg = value < 0;
+
+  if(neg)
+    value = -value;
+
+  for(int n = digits - 1; n >= 0; --n)
+  {
+    ls[n] = '0' + (value % 10);
+    value /= 10;
+    if(!cpu->crs->km.ascii)
+      ls[n] |= 0x80;
+  }
+
+  ls[digits] = neg ? '-' : '+';
+
+  if(!cpu->crs->km.ascii)
+    ls[digits] |= 0x80;
+
+  old_store_bytes(cpu, ls, digits + 1, far, fbr);
+}
+
+static inline void old_store_pd(cpu_t *cpu, int digits, intdec_t value, uint32_t *far, int *fbr)
+{
+
+  if(!(digits & 1))
+    ++digits;
+
+  int bytes = (digits + 1) / 2;
+  uint8_t pd[bytes];
+
+  int neg = value < 0;
+
+  if(value < 0)
+    value = -value;
+
+  value *= 10;
+
+  for(int n = bytes - 1; n >= 0; --n)
+  {
+  int d = value % 100;
+    value /= 100;
+
+    pd[n] = (d / 10) << 4 | d % 10;
+  }
+
+  pd[bytes - 1] |= neg ? 0x0d : 0x0c;
+
+  old_store_bytes(cpu, pd, bytes, far, fbr);
+}
+
+static inline void old_store_le(cpu_t *cpu, int digits, intdec_t value, uint32_t *far, int *fbr)
+{
+uint8_t ls[digits];
+
+
+  int neg = value < 0;
+
+  if(neg)
+    value = -value;
+
+  for(int n = digits - 1; n >= 0; --n)
+  {
+    ls[n] = '0' + (value % 10);
+    value /= 10;
+    if(!cpu->crs->km.ascii)
+      ls[n] |= 0x80;
+  }
+
+  if(neg)
+  {
+    if((ls[0] & 0xf) == 0)
+      ls[0] = '}';
+    else
+      ls[0] += 'J' - '1';
+    if(!cpu->crs->km.ascii)
+      ls[0] |= 0x80;
+  }
+
+  old_store_bytes(cpu, ls, digits, far, fbr);
+}
+
+static inline void old_store_te(cpu_t *cpu, const int digits, intdec_t value, uint32_t *far, int *fbr)
+{
+uint8_t ls[digits];
+
+
+  int neg = value < 0;
+
+  if(neg)
+    value = -value;
+
+  for(int n = digits - 1; n >= 0; --n)
+  {
+    ls[n] = '0' + (value % 10);
+    value /= 10;
+    if(!cpu->crs->km.ascii)
+      ls[n] |= 0x80;
+  }
+
+  if(neg)
+  {
+    if((ls[digits - 1] & 0xf) == 0)
+      ls[digits - 1] = '}';
+    else
+      ls[digits - 1] += 'J' - '1';
+    if(!cpu->crs->km.ascii)
+      ls[digits - 1] |= 0x80;
+  }
+
+  old_store_bytes(cpu, ls, digits, far, fbr);
+}
+
+static inline void old_load_bytes(cpu_t *cpu, uint8_t *bytes, int count, uint32_t *far, int *fbr)
+{
+  if(count == 0)
+    return;
+
+  if(*fbr != 0)
+  {
+    *bytes++ = E50X(vfetch_w)(cpu, (*far)) & 0xff;
+    inc_d(far);
+    --count;
+    *fbr = 0;
+  }
+
+  for(int n = count / 2; n > 0; --n, count -= 2)
+  {
+  uint16_t w = E50X(vfetch_w)(cpu, (*far));
+    inc_d(far);
+    *bytes++ = w >> 8;
+    *bytes++ = w & 0xff;
+  }
+
+  if(count > 0)
+  {
+    *bytes = E50X(vfetch_w)(cpu, *far) >> 8;
+    *fbr = 8;
+  }
+}
+
+static inline intdec_t old_load_ls(cpu_t *cpu, int digits, uint32_t *far, int *fbr)
+{
+intdec_t r = 0;
+uint8_t ls[digits + 1];
+
+  old_load_bytes(cpu, ls, digits + 1, far, fbr);
+  for(int n = 1; n <= digits; n++)
+  {
+    r *= 10;
+    r += ls[n] & 0xf;
+  }
+  // space = 0x20, + = 0x2b, { = 0x7b 1011
+  //               - = 0x2d, } = 0x7d 1101
+  if((ls[0] & 0b100))
+    r = -r;
+
+
+  return r;
+}
+
+static inline intdec_t old_load_ts(cpu_t *cpu, int digits, uint32_t *far, int *fbr)
+{
+intdec_t r = 0;
+uint8_t ts[digits + 1];
+
+  old_load_bytes(cpu, ts, digits + 1, far, fbr);
+  for(int n = 0; n < digits; n++)
+  {
+    r *= 10;
+    r += ts[n] & 0xf;
+  }
+  // space = 0x20, + = 0x2b, { = 0x7b 1011
+  //               - = 0x2d, } = 0x7d 1101
+  if((ts[digits] & 0b100))
+    r = -r;
+
+
+  return r;
+}
+
+static inline intdec_t old_load_pd(cpu_t *cpu, int digits, uint32_t *far, int *fbr)
+{
+  if(!digits)
+    return 0;
+
+  if(!(digits & 1))
+    ++digits;
+
+  int bytes = (digits + 1) / 2;
+  uint8_t pd[bytes];
+
+  old_load_bytes(cpu, pd, bytes, far, fbr);
+
+  intdec_t value = 0;
+
+  int n;
+  for(n = 0; n < bytes - 1; ++n)
+  {
+    value *= 100;
+
+    value += ((pd[n] & 0xf0) >> 4) * 10 + (pd[n] & 0x0f);
+  }
+  value *= 10;
+  value += (pd[n] & 0xf0) >> 4;
+  if((pd[n] & 0x0f) == 0x0d)
+    value = -value;
+
+
+  return value;
+}
+
+static inline intdec_t old_load_le(cpu_t *cpu, int digits, uint32_t *far, int *fbr)
+{
+intdec_t r;
+uint8_t le[digits];
+
+  old_load_bytes(cpu, le, digits, far, fbr);
+
+  uint8_t t = le[0] & 0x7f;
+  int neg = t == '}' || t == '-' || (t >= 'J' && t <= 'R');
+  r = ((t >= 'J' && t <= 'R') ? t - 'I' : (t == '}' || t == '-' || t == '{' || t == '+') ? 0 : t) & 0xf;
+  for(int n = 1; n < digits; n++)
+  {
+    r *= 10;
+    r += le[n] & 0xf;
+  }
+  // space = 0x20, + = 0x2b, { = 0x7b 1011
+  //               - = 0x2d, } = 0x7d 1101
+  if(neg)
+    r = -r;
+
+
+  return r;
+}
+
+static inline intdec_t old_load_te(cpu_t *cpu, int digits, uint32_t *far, int *fbr)
+{
+intdec_t r = 0;
+uint8_t te[digits];
+
+  old_load_bytes(cpu, te, digits, far, fbr);
+
+  for(int n = 0; n < digits - 1; n++)
+  {
+    r += te[n] & 0xf;
+    r *= 10;
+  }
+  // space = 0x20, + = 0x2b, { = 0x7b 1011
+  //               - = 0x2d, } = 0x7d 1101
+
+  uint8_t l = te[digits - 1] & 0x7f;
+  int neg = l == '}' || l == '-' || (l >= 'J' && l <= 'R');
+  r += ((l >= 'J' && l <= 'R') ? l - 'I' : (l == '}' || l == '-' || l == '{' || l == '+') ? 0 : l) & 0xf;
+
+  if(neg)
+    r = -r;
+
+
+  return r;
+}
+
+static inline intdec_t old_load_decimal(cpu_t *cpu, dcw_t dcw, int far, uint32_t *far0, int *fbr0)
+{
+int type = dcw_type(dcw, far);
+int sign = dcw_sign(dcw, far);
+int digits = dcw_digits(dcw, far);
+
+intdec_t r;
+
+  if(!digits)
+    return 0;
+
+  switch(type) {
+
+    case dcw_dt_ls:
+      r = old_load_ls(cpu, digits, far0, fbr0);
+      break;
+
+    case dcw_dt_ts:
+      r = old_load_ts(cpu, digits, far0, fbr0);
+      break;
+
+    case dcw_dt_pd:
+      r = old_load_pd(cpu, digits, far0, fbr0);
+      break;
+
+    case dcw_dt_le:
+      r = old_load_le(cpu, digits, far0, fbr0);
+      break;
+
+    case dcw_dt_te:
+      r = old_load_te(cpu, digits, far0, fbr0);
+      break;
+
+    default:
+      abort();
+  }
+
+  if(sign)
+    r = -r;
+
+  return r;
+}
+
+static inline void old_store_decimal(cpu_t *cpu, dcw_t dcw, int far, intdec_t value, uint32_t *far1, int *fbr1)
+{
+int type = dcw_type(dcw, far);
+int abs = dcw_abs(dcw);
+int digits = dcw_digits(dcw, far);
+
+  if(value < 0 && abs)
+    value = -value;
+
+  switch(type) {
+
+    case dcw_dt_ls:
+      old_store_ls(cpu, digits, value, far1, fbr1);
+      break;
+
+    case dcw_dt_ts:
+      old_store_ts(cpu, digits, value, far1, fbr1);
+      break;
+
+    case dcw_dt_pd:
+      old_store_pd(cpu, digits, value, far1, fbr1);
+      break;
+
+    case dcw_dt_le:
+      old_store_le(cpu, digits, value, far1, fbr1);
+      break;
+
+    case dcw_dt_te:
+      old_store_te(cpu, digits, value, far1, fbr1);
+      break;
+
+    default:
+      abort();
+  }
+}
+
+
+/* Test segment, its pages are put in random physical pages */
+
+#define SEG    01
+#define PAGES  em50_pages_in_segment
+#define PAGEB  (em50_page_size << 1)
+#define SDT    04000
+#define PMT    06000
+
+static uint32_t frame[PAGES];
+static uint8_t base[PAGES * PAGEB];
+static uint8_t image[PAGES * PAGEB];
+static uint8_t result[2][PAGES * PAGEB];
+
+static uint64_t seed = 0x9e3779b97f4a7c15ULL;
+
+static inline uint64_t rnd(void)
+{
+  seed ^= seed >> 12;
+  seed ^= seed << 25;
+  seed ^= seed >> 27;
+  return seed * 0x2545f4914f6cdd1dULL;
+}
+
+static void seg_init(cpu_t *cpu)
+{
+int n = cpu->maxmem >> em50_page_shift;
+uint8_t used[n];
+
+  memset(used, 0, n);
+
+  for(int p = 0; p < PAGES; ++p)
+  {
+    int f;
+    do f = 8 + rnd() % (n - 8); while(used[f]);
+    used[f] = 1;
+    frame[p] = f;
+    store_d(physad(cpu, PMT + (p << 1)), pmt_r | f);
+  }
+
+  store_d(physad(cpu, SDT + (SEG << 1)), PMT << sdw_s_s);
+  cpu->crs->dtar[ea_dtar(SEG << ea_s_s)] = ((1024 - (SEG + 1)) << sdt_s_s) | (SDT >> 1);
+  cpu->crs->km.sm = 1;
+
+  for(int i = 0; i < sizeof(base); ++i)
+    base[i] = rnd();
+}
+
+static void seg_load(cpu_t *cpu, const uint8_t *b)
+{
+  for(int p = 0; p < PAGES; ++p)
+    memcpy(physad(cpu, frame[p] << em50_page_shift), b + p * PAGEB, PAGEB);
+}
+
+static void seg_save(cpu_t *cpu, uint8_t *b)
+{
+  for(int p = 0; p < PAGES; ++p)
+    memcpy(b + p * PAGEB, physad(cpu, frame[p] << em50_page_shift), PAGEB);
+}
+
+
+/* Random operands */
+
+typedef struct {
+  dcw_t dcw;
+  int far;          // field of the dcw, 0 or 1
+  uint32_t addr;    // word within the segment
+  int fbr;
+  int ascii;
+  int xmv;
+  intdec_t value;   // stored, scaled or divided
+  intdec_t div;
+} dcase_t;
+
+typedef struct {
+  intdec_t value[2];
+  uint32_t far;
+  int fbr;
+} dregs_t;
+
+typedef struct {
+  const char *name;
+  int op;
+  int type;
+  int digits;
+} dbench_t;
+
+static const dbench_t *bench_case;
+
+static const int dtype[] = { dcw_dt_ls, dcw_dt_ts, dcw_dt_pd, dcw_dt_le, dcw_dt_te };
+
+#define NUM(_a) (sizeof(_a) / sizeof(*(_a)))
+
+/* Mostly close to the end of a page, within one page when timed */
+static uint32_t rnd_addr(void)
+{
+int p = rnd() % (PAGES - 1);
+int o = bench_case ? rnd() % (em50_page_size - 40) :
+        (rnd() & 1) ? em50_page_size - 1 - rnd() % 40 : rnd() % em50_page_size;
+
+  return (p << em50_page_shift) | o;
+}
+
+/* A value of up to n digits, of either sign */
+static intdec_t rnd_value(int n)
+{
+intdec_t v = 0;
+
+  for(int i = bench_case ? n : rnd() % (n + 1); i > 0; --i)
+    v = v * 10 + rnd() % 10;
+
+  return (rnd() & 1) ? -v : v;
+}
+
+static int field_bytes(int type, int digits)
+{
+  switch(type) {
+    case dcw_dt_ls:
+    case dcw_dt_ts:
+      return digits + 1;
+    case dcw_dt_pd:
+      return ((digits | 1) + 1) / 2;
+    default:
+      return digits;
+  }
+}
+
+static void gen(dcase_t *c)
+{
+int type = bench_case ? bench_case->type : dtype[rnd() % NUM(dtype)];
+int digits = bench_case ? bench_case->digits : (rnd() & 1) ? rnd() % 20 : rnd() % 64;
+
+  c->far = rnd() & 1;
+  c->dcw.w = rnd();
+  if(c->far)
+  {
+    c->dcw.h = type;
+    c->dcw.f = digits;
+  }
+  else
+  {
+    c->dcw.e = type;
+    c->dcw.a = digits;
+  }
+
+  c->addr = rnd_addr();
+  c->fbr = (rnd() & 1) ? 8 : 0;
+  c->ascii = rnd() & 1;
+  c->xmv = rnd() & 1;
+  c->value = c->div = 0;
+}
+
+/* Digits, signs and zones as stored by store_decimal, at times with
+   a random byte in between */
+static void gen_load(dcase_t *c)
+{
+static const char sign[] = "+-{} ";
+static const char embed[] = "{}JKLMNOPQR+-0123456789";
+static const uint8_t nibble[] = { 0x0c, 0x0d, 0x0f, 0x0b, 0x0a, 0x00 };
+
+  gen(c);
+
+  int type = dcw_type(c->dcw, c->far);
+  int n = field_bytes(type, dcw_digits(c->dcw, c->far));
+  uint8_t zone = c->ascii ? 0 : 0x80;
+  uint8_t *f = image + (c->addr << 1) + (c->fbr ? 1 : 0);
+
+  if(!n)
+    return;
+
+  for(int i = 0; i < n; ++i)
+    f[i] = type == dcw_dt_pd ? (rnd() % 10) << 4 | rnd() % 10 : ('0' + rnd() % 10) | zone;
+
+  switch(type) {
+    case dcw_dt_ls:
+      f[0] = sign[rnd() % (NUM(sign) - 1)] | zone;
+      break;
+    case dcw_dt_ts:
+      f[n - 1] = sign[rnd() % (NUM(sign) - 1)] | zone;
+      break;
+    case dcw_dt_pd:
+      f[n - 1] = (f[n - 1] & 0xf0) | nibble[rnd() % NUM(nibble)];
+      break;
+    case dcw_dt_le:
+      f[0] = embed[rnd() % (NUM(embed) - 1)] | zone;
+      break;
+    case dcw_dt_te:
+      f[n - 1] = embed[rnd() % (NUM(embed) - 1)] | zone;
+      break;
+  }
+
+  if(!bench_case && !(rnd() % 8))
+    f[rnd() % n] = rnd();
+}
+
+/* Values that fit the field, or are truncated by it.  The old code
+   scaled packed values by 10, which overflowed beyond 37 digits */
+static void gen_store(dcase_t *c)
+{
+  do gen(c); while(!dcw_digits(c->dcw, c->far));
+
+  int digits = dcw_digits(c->dcw, c->far);
+
+  c->value = rnd_value((bench_case || (rnd() % 4 && digits < 37)) ? digits : 37);
+}
+
+/* Scale factors that do not overflow */
+static void gen_scale(dcase_t *c)
+{
+  gen(c);
+
+  int scale = (c->dcw.g & 0x40) ? c->dcw.g | ~0x7f : c->dcw.g;
+  int digits = bench_case ? bench_case->digits : scale < 0 ? 38 + scale : 37;
+
+  c->value = digits > 0 ? rnd_value(digits) : 0;
+}
+
+static void gen_div(dcase_t *c)
+{
+static const intdec_t edge[] = { INT64_MIN, INT64_MAX, -INT64_MAX, (intdec_t)INT64_MAX + 1, -1, 1 };
+int digits = bench_case ? bench_case->digits : 38;
+
+  gen(c);
+
+  c->value = (bench_case || rnd() % 8) ? rnd_value(digits) : edge[rnd() % NUM(edge)];
+  c->div = (bench_case || rnd() % 8) ? rnd_value(digits / 2) : edge[rnd() % NUM(edge)];
+  if(!c->div)
+    c->div = 1;
+}
+
+
+/* Run the case through the new (k = 0) or the old code (k = 1) */
+
+static void run_load(cpu_t *cpu, const dcase_t *c, int k, dregs_t *r)
+{
+  r->far = (SEG << ea_s_s) | c->addr;
+  r->fbr = c->fbr;
+  cpu->crs->km.ascii = c->ascii;
+  r->value[0] = (k ? old_load_decimal : E50X(load_decimal))(cpu, c->dcw, c->far, &r->far, &r->fbr);
+}
+
+static void run_store(cpu_t *cpu, const dcase_t *c, int k, dregs_t *r)
+{
+  r->far = (SEG << ea_s_s) | c->addr;
+  r->fbr = c->fbr;
+  cpu->crs->km.ascii = c->ascii;
+  (k ? old_store_decimal : E50X(store_decimal))(cpu, c->dcw, c->far, c->value, &r->far, &r->fbr);
+}
+
+static void run_scale(cpu_t *cpu, const dcase_t *c, int k, dregs_t *r)
+{
+  r->value[0] = (k ? old_dcw_scale : dcw_scale)(c->dcw, c->xmv, c->value);
+}
+
+static void run_div(cpu_t *cpu, const dcase_t *c, int k, dregs_t *r)
+{
+  r->value[0] = k ? c->value / c->div : dec_div(c->value, c->div);
+  r->value[1] = k ? c->value % c->div : dec_rem(c->value, c->div);
+}
+
+
+typedef struct {
+  const char *name;
+  void (*gen)(dcase_t *);
+  void (*run)(cpu_t *, const dcase_t *, int, dregs_t *);
+  int mem;
+} dop_t;
+
+static const dop_t dop[] = {
+  { "load",  gen_load,  run_load,  1 },
+  { "store", gen_store, run_store, 1 },
+  { "scale", gen_scale, run_scale, 0 },
+  { "div",   gen_div,   run_div,   0 },
+};
+
+
+static const char *hex(intdec_t v)
+{
+static char b[8][40];
+static int i;
+
+  i = (i + 1) % 8;
+  snprintf(b[i], sizeof(b[i]), "%16.16llx%16.16llx",
+    (unsigned long long)((__uint128_t)v >> 64), (unsigned long long)v);
+
+  return b[i];
+}
+
+static int check(cpu_t *cpu, const dop_t *o, long n)
+{
+int fail = 0;
+
+  for(long i = 0; i < n; ++i)
+  {
+    dcase_t c;
+    dregs_t r[2];
+
+    memset(r, 0, sizeof(r));
+    if(o->mem)
+      memcpy(image, base, sizeof(image));
+    o->gen(&c);
+
+    for(int k = 0; k < 2; ++k)
+    {
+      if(o->mem)
+        seg_load(cpu, image);
+      o->run(cpu, &c, k, &r[k]);
+      if(o->mem)
+        seg_save(cpu, result[k]);
+    }
+
+    if(r[0].value[0] != r[1].value[0] || r[0].value[1] != r[1].value[1]
+      || r[0].far != r[1].far || r[0].fbr != r[1].fbr
+      || (o->mem && memcmp(result[0], result[1], sizeof(result[0]))))
+    {
+      if(++fail <= 10)
+        printf("%s dcw %8.8x field %d at %o/%d ascii %d value %s div %s: %s %s far %x/%d, old %s %s far %x/%d, storage %s\n",
+          o->name, c.dcw.w, c.far, c.addr, c.fbr, c.ascii, hex(c.value), hex(c.div),
+          hex(r[0].value[0]), hex(r[0].value[1]), r[0].far, r[0].fbr,
+          hex(r[1].value[0]), hex(r[1].value[1]), r[1].far, r[1].fbr,
+          o->mem && memcmp(result[0], result[1], sizeof(result[0])) ? "differs" : "same");
+    }
+  }
+
+  return fail;
+}
+
+
+static double now(void)
+{
+struct timespec t;
+
+  clock_gettime(CLOCK_MONOTONIC, &t);
+
+  return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+#define BENCH_OPS 1024
+
+static const dbench_t dbench[] = {
+  { "load ls 9",   0, dcw_dt_ls, 9 },
+  { "load pd 15",  0, dcw_dt_pd, 15 },
+  { "load te 18",  0, dcw_dt_te, 18 },
+  { "load pd 31",  0, dcw_dt_pd, 31 },
+  { "store ls 9",  1, dcw_dt_ls, 9 },
+  { "store pd 15", 1, dcw_dt_pd, 15 },
+  { "store te 18", 1, dcw_dt_te, 18 },
+  { "store pd 31", 1, dcw_dt_pd, 31 },
+  { "scale 15",    2, dcw_dt_pd, 15 },
+  { "div 15",      3, dcw_dt_pd, 15 },
+};
+
+static void bench(cpu_t *cpu, long n)
+{
+static dcase_t c[BENCH_OPS];
+dregs_t r;
+
+  n = (n + BENCH_OPS - 1) / BENCH_OPS * BENCH_OPS;
+
+  printf("%-12s %12s %12s\n", "op", "new ns", "old ns");
+
+  for(int i = 0; i < NUM(dbench); ++i)
+  {
+    const dop_t *o = &dop[dbench[i].op];
+
+    bench_case = &dbench[i];
+    memcpy(image, base, sizeof(image));
+    for(int j = 0; j < BENCH_OPS; ++j)
+      o->gen(&c[j]);
+    seg_load(cpu, image);
+
+    double t[2];
+    for(int k = 0; k < 2; ++k)
+    {
+      double t0 = now();
+      for(long m = 0; m < n; m += BENCH_OPS)
+        for(int j = 0; j < BENCH_OPS; ++j)
+          o->run(cpu, &c[j], k, &r);
+      t[k] = (now() - t0) / n;
+    }
+    printf("%-12s %12.2f %12.2f\n", dbench[i].name, t[0], t[1]);
+  }
+
+  bench_case = NULL;
+}
+
+
+int main(int argc, char *argv[])
+{
+long n = 0;
+int b = 0;
+int fail = 0;
+int c;
+
+  while((c = getopt(argc, argv, "bn:s:")) != -1)
+    switch(c) {
+      case 'b':
+        b = 1;
+        break;
+      case 'n':
+        n = strtol(optarg, NULL, 0);
+        break;
+      case 's':
+        seed = strtoull(optarg, NULL, 0) | 1;
+        break;
+      default:
+        fprintf(stderr, "usage: %s [-b] [-n count] [-s seed]\n", argv[0]);
+        return 1;
+    }
+
+  sys_t sys = { .progname = argv[0], .physsize = 0x100000 };
+  sys.physstor = mmap(NULL, sys.physsize, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+  cpu_t cpu = { .sys = &sys, .maxmem = sys.physsize >> 1 };
+
+  em50_init(&cpu);
+  const struct sched_param sparam = { .sched_priority = 0 };
+  pthread_setschedparam(pthread_self(), SCHED_OTHER, &sparam);
+
+  seg_init(&cpu);
+
+  if(b)
+    bench(&cpu, n ? n : 1000000);
+  else
+  {
+    printf("%-6s %10s %10s\n", "op", "count", "differ");
+    for(int i = 0; i < NUM(dop); ++i)
+    {
+      int f = check(&cpu, &dop[i], n ? n : 5000);
+      printf("%-6s %10ld %10d\n", dop[i].name, n ? n : 5000, f);
+      fail += f;
+    }
+  }
+
+  fflush(stdout);
+  _exit(fail ? 1 : 0);
+}
@@ -0,0 +1,383 @@
+/* Floating Point Arithmetic Test
+ *
+ *
+ * Copyright Notice:
+ *
+ *   Copyright (C) 1999-2020 Jan Jaeger, All Rights Reserved.
+ *
+ *
+ * This file is part of the Prime 50 Series Emulator (em50).
+ *
+ *
+ * License Statement:
+ *
+ *   The Prime 50 Series Emulator (em50) is free software:
+ *   You can redistribute it and/or modify it under the terms
+ *   of the GNU General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License,
+ *   or (at your option) any later version.
+ *
+ *   em50 is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *   See the GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with em50.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/* Runs the Prime format double and quad arithmetic of flpt.h against
+ * the IEEE based arithmetic it replaced, on random normalised operands.
+ *
+ *   flpt [-n count] [-s seed]   print one line per operation:
+ *                               op a b native ieee
+ *                               for flpt.py to check against exact results
+ *   flpt -b [-n count]          time both implementations
+ */
+
+
+#include "emu.h"
+
+#include "mode.h"
+
+#include "opcode.h"
+
+#include "flpt.h"
+
+#include <time.h>
+
+
+static uint64_t seed = 0x9e3779b97f4a7c15ULL;
+
+static inline uint64_t rnd(void)
+{
+  seed ^= seed >> 12;
+  seed ^= seed << 25;
+  seed ^= seed >> 27;
+  return seed * 0x2545f4914f6cdd1dULL;
+}
+
+
+/* A normalised fraction with magnitude in 2^46..2^47-1, half of them with
+   trailing zeros so that exact results and ties are common */
+static uint64_t rnd_dbl(int e)
+{
+uint64_t m = rnd() >> 16;
+
+  if(rnd() & 1)
+    m &= ~0ULL << (rnd() % 47);
+
+  m = (m & ((1ULL << 46) - 1)) | (1ULL << 46);
+
+  if(!(rnd() % 64))
+    return 0;
+
+  int64_t f = (int64_t)m;
+  if(rnd() & 1)
+  {
+    f = -f;
+    if(m == (1ULL << 46))
+    {
+      f = -(1LL << 47);
+      --e;
+    }
+  }
+
+  return ((uint64_t)f << 16) | (e & 0xffff);
+}
+
+static int rnd_exp(int e, int span)
+{
+  return e + (int)(rnd() % (2 * span + 1)) - span;
+}
+
+
+static uint64_t ieee_add(uint64_t a, uint64_t b)
+{
+  return from_dbl_rnd(to_dbl(a) + to_dbl(b));
+}
+
+static uint64_t ieee_sub(uint64_t a, uint64_t b)
+{
+  return from_dbl_rnd(to_dbl(a) - to_dbl(b));
+}
+
+static uint64_t ieee_mul(uint64_t a, uint64_t b)
+{
+  return from_dbl_rnd(to_dbl(a) * to_dbl(b));
+}
+
+static uint64_t ieee_div(uint64_t a, uint64_t b)
+{
+  return from_dbl_rnd(to_dbl(a) / to_dbl(b));
+}
+
+static uint64_t ieee_fsb(uint64_t a, uint64_t b)
+{
+  return ffrom_dbl_rnd(fto_dbl(a) - fto_dbl(b));
+}
+
+static uint64_t dbl_fsb(uint64_t a, uint64_t b)
+{
+  return _d2f(dbl_sub(_f2d(a), _f2d(b)));
+}
+
+
+#ifdef FLOAT128
+static __uint128_t rnd_qad(int e)
+{
+em50_qad q = {.dbl.q = rnd_dbl(e)};
+
+  if(q.dbl.q)
+  {
+    q.qex.q = rnd() << 16;
+    if(rnd() & 1)
+      q.qex.q &= ~0ULL << (16 + rnd() % 48);
+    /* -0.5 normalised as -1.0 * 2^-1 has no further fraction bits */
+    if(q.dbl.sign && !q.dbl.mantissa)
+      q.qex.q = 0;
+  }
+
+  return q.q;
+}
+
+static __uint128_t ieee_qadd(__uint128_t a, __uint128_t b)
+{
+  return from_qad(to_qad(a) + to_qad(b));
+}
+
+static __uint128_t ieee_qsub(__uint128_t a, __uint128_t b)
+{
+  return from_qad(to_qad(a) - to_qad(b));
+}
+
+static __uint128_t ieee_qmul(__uint128_t a, __uint128_t b)
+{
+  return from_qad(to_qad(a) * to_qad(b));
+}
+
+static __uint128_t ieee_qdiv(__uint128_t a, __uint128_t b)
+{
+  return from_qad(to_qad(a) / to_qad(b));
+}
+#endif
+
+
+typedef struct {
+  const char *name;
+  uint64_t (*native)(uint64_t, uint64_t);
+  uint64_t (*ieee)(uint64_t, uint64_t);
+  int single;
+  int span;       // exponent of b from that of a, or 0 from 128
+} dop_t;
+
+static const dop_t dop[] = {
+  { "add", dbl_add, ieee_add, 0, 60 },
+  { "sub", dbl_sub, ieee_sub, 0, 60 },
+  { "mul", dbl_mul, ieee_mul, 0, 0 },
+  { "div", dbl_div, ieee_div, 0, 0 },
+  { "fsb", dbl_fsb, ieee_fsb, 1, 30 },
+};
+
+#ifdef FLOAT128
+typedef struct {
+  const char *name;
+  __uint128_t (*native)(__uint128_t, __uint128_t);
+  __uint128_t (*ieee)(__uint128_t, __uint128_t);
+  int span;
+} qop_t;
+
+static const qop_t qop[] = {
+  { "qadd", qad_add, ieee_qadd, 110 },
+  { "qsub", qad_sub, ieee_qsub, 110 },
+  { "qmul", qad_mul, ieee_qmul, 0 },
+  { "qdiv", qad_div, ieee_qdiv, 0 },
+};
+#endif
+
+#define NUM(_a) (sizeof(_a) / sizeof(*(_a)))
+
+
+/* Exponents are kept such that operands and results stay well inside the
+   range of an IEEE double */
+static int rnd_exp2(int *e, int span)
+{
+  *e = rnd_exp(400, 100);
+
+  return span ? rnd_exp(*e, span) : rnd_exp(128, 100);
+}
+
+
+static void gen_dbl(const dop_t *o, uint64_t *a, uint64_t *b)
+{
+int e, f = rnd_exp2(&e, o->span);
+
+  *a = rnd_dbl(e);
+  *b = rnd_dbl(f);
+
+  if(o->single)
+  {
+    *a = _d2f(*a & ~(0xffffffULL << 16));
+    *b = _d2f(*b & ~(0xffffffULL << 16));
+  }
+  else if(!(rnd() % 16) && *a)
+    *b = *a ^ ((rnd() & 0xff) << 16);  // near cancellation
+}
+
+#ifdef FLOAT128
+static void gen_qad(const qop_t *o, __uint128_t *a, __uint128_t *b)
+{
+int e, f = rnd_exp2(&e, o->span);
+
+  *a = rnd_qad(e);
+  *b = rnd_qad(f);
+
+  if(!(rnd() % 16) && *a)
+    *b = *a ^ ((__uint128_t)(rnd() & 0xff) << 16);
+}
+
+static void prt_qad(__uint128_t q)
+{
+em50_qad v = {.q = q};
+
+  printf(" %16.16llx%16.16llx", (unsigned long long)v.dbl.q, (unsigned long long)v.qex.q);
+}
+#endif
+
+
+static void check(long n)
+{
+  for(int i = 0; i < NUM(dop); ++i)
+    for(long j = 0; j < n; ++j)
+    {
+      uint64_t a, b;
+      gen_dbl(&dop[i], &a, &b);
+      if(dop[i].native == dbl_div && !(b >> 16))
+        continue;
+      printf("%s %16.16llx %16.16llx %16.16llx %16.16llx\n", dop[i].name,
+        (unsigned long long)a, (unsigned long long)b,
+        (unsigned long long)dop[i].native(a, b), (unsigned long long)dop[i].ieee(a, b));
+    }
+
+#ifdef FLOAT128
+  for(int i = 0; i < NUM(qop); ++i)
+    for(long j = 0; j < n; ++j)
+    {
+      __uint128_t a, b;
+      gen_qad(&qop[i], &a, &b);
+      if(qop[i].native == qad_div && !((em50_qad){.q = b}).dbl.q)
+        continue;
+      printf("%s", qop[i].name);
+      prt_qad(a);
+      prt_qad(b);
+      prt_qad(qop[i].native(a, b));
+      prt_qad(qop[i].ieee(a, b));
+      printf("\n");
+    }
+#endif
+}
+
+
+static double now(void)
+{
+struct timespec t;
+
+  clock_gettime(CLOCK_MONOTONIC, &t);
+
+  return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+#define BENCH_OPS 4096
+
+static void bench(long n)
+{
+static uint64_t a[BENCH_OPS], b[BENCH_OPS];
+volatile uint64_t sink = 0;
+
+  n = (n + BENCH_OPS - 1) / BENCH_OPS * BENCH_OPS;
+
+  printf("%-6s %12s %12s\n", "op", "native ns", "ieee ns");
+
+  for(int i = 0; i < NUM(dop); ++i)
+  {
+    for(int j = 0; j < BENCH_OPS; ++j)
+      do gen_dbl(&dop[i], &a[j], &b[j]); while(!(b[j] >> 16));
+
+    double t[2];
+    for(int k = 0; k < 2; ++k)
+    {
+      uint64_t (*f)(uint64_t, uint64_t) = k ? dop[i].ieee : dop[i].native;
+      uint64_t s = 0;
+      double t0 = now();
+      for(long r = 0; r < n; r += BENCH_OPS)
+        for(int j = 0; j < BENCH_OPS; ++j)
+          s += f(a[j], b[j]);
+      t[k] = (now() - t0) / n;
+      sink += s;
+    }
+    printf("%-6s %12.2f %12.2f\n", dop[i].name, t[0], t[1]);
+  }
+
+#ifdef FLOAT128
+  static __uint128_t qa[BENCH_OPS], qb[BENCH_OPS];
+
+  for(int i = 0; i < NUM(qop); ++i)
+  {
+    for(int j = 0; j < BENCH_OPS; ++j)
+      do gen_qad(&qop[i], &qa[j], &qb[j]); while(!((em50_qad){.q = qb[j]}).dbl.q);
+
+    double t[2];
+    for(int k = 0; k < 2; ++k)
+    {
+      __uint128_t (*f)(__uint128_t, __uint128_t) = k ? qop[i].ieee : qop[i].native;
+      __uint128_t s = 0;
+      double t0 = now();
+      for(long r = 0; r < n; r += BENCH_OPS)
+        for(int j = 0; j < BENCH_OPS; ++j)
+          s += f(qa[j], qb[j]);
+      t[k] = (now() - t0) / n;
+      sink += (uint64_t)s;
+    }
+    printf("%-6s %12.2f %12.2f\n", qop[i].name, t[0], t[1]);
+  }
+#endif
+
+  (void)sink;
+}
+
+
+int main(int argc, char *argv[])
+{
+long n = 0;
+int b = 0;
+int c;
+
+  while((c = getopt(argc, argv, "bn:s:")) != -1)
+    switch(c) {
+      case 'b':
+        b = 1;
+        break;
+      case 'n':
+        n = strtol(optarg, NULL, 0);
+        break;
+      case 's':
+        seed = strtoull(optarg, NULL, 0) | 1;
+        break;
+      default:
+        fprintf(stderr, "usage: %s [-b] [-n count] [-s seed]\n", argv[0]);
+        return 1;
+    }
+
+#ifndef FLPT_NATIVE
+  fprintf(stderr, "%s: no Prime format arithmetic on this host, comparing IEEE with itself\n", argv[0]);
+#endif
+
+  if(b)
+    bench(n ? n : 10000000);
+  else
+    check(n ? n : 100000);
+
+  return 0;
+}
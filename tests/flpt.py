@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+
+# Checks the output of flpt against exact rational arithmetic.
+#
+# Double results are the exact result rounded once to 47 magnitude bits,
+# half away from zero, quad results the exact result truncated to 95
+# magnitude bits.  Every native result must match, the IEEE results that
+# do not are counted as one unit in the last place off, or further off.
+#
+#   ./flpt | ./flpt.py
+
+import sys
+from fractions import Fraction
+
+
+def sext(v, bits):
+    return v - (1 << bits) if v >> (bits - 1) else v
+
+
+def dbl(d):
+    return Fraction(sext(d >> 16, 48)) * Fraction(2) ** ((d & 0xffff) - 128 - 47)
+
+
+def flt(d):
+    return Fraction(sext(d >> 8, 24)) * Fraction(2) ** ((d & 0xff) - 128 - 23)
+
+
+def qad(h):
+    d, x = int(h[:16], 16), int(h[16:], 16)
+    f = (sext(d >> 16, 48) << 48) | (x >> 16)
+    return Fraction(f) * Fraction(2) ** ((d & 0xffff) - 128 - 95)
+
+
+def scale(a, bits):
+    k = a.numerator.bit_length() - a.denominator.bit_length() - bits
+    while a >= Fraction(2) ** (k + bits):
+        k += 1
+    while a < Fraction(2) ** (k + bits - 1):
+        k -= 1
+    return k
+
+
+def pack(v, bits, rnd):
+    if v == 0:
+        return 0, 0
+    neg, a = v < 0, abs(v)
+    k = scale(a, bits)
+    q = a / Fraction(2) ** k
+    m = int(q + Fraction(1, 2)) if rnd else int(q)
+    if m >> bits:
+        m >>= 1
+        k += 1
+    e = k + 128 + bits
+    f = -m if neg else m
+    if neg and m == 1 << (bits - 1):
+        f = -(1 << bits)
+        e -= 1
+    return f & ((1 << (bits + 1)) - 1), e & 0xffff
+
+
+def ref_dbl(v):
+    f, e = pack(v, 47, True)
+    return (f << 16) | e
+
+
+def ref_flt(v):
+    d = ref_dbl(v)
+    m = (((d >> 16) & ((1 << 47) - 1)) + 0x800000) >> 24
+    return ((d >> 63) << 31) | ((m & 0x7fffff) << 8) | (d & 0xff)
+
+
+def ref_qad(v):
+    f, e = pack(v, 95, False)
+    return '%16.16x%16.16x' % (((f >> 48) << 16) | e, (f & ((1 << 48) - 1)) << 16)
+
+
+def ulp_dbl(d):
+    return Fraction(2) ** ((d & 0xffff) - 128 - 47)
+
+
+def ulp_flt(d):
+    return Fraction(2) ** ((d & 0xff) - 128 - 23)
+
+
+def ulp_qad(h):
+    return Fraction(2) ** ((int(h[:16], 16) & 0xffff) - 128 - 95)
+
+
+ops = {
+    'add': (dbl, lambda a, b: a + b, ref_dbl, ulp_dbl),
+    'sub': (dbl, lambda a, b: a - b, ref_dbl, ulp_dbl),
+    'mul': (dbl, lambda a, b: a * b, ref_dbl, ulp_dbl),
+    'div': (dbl, lambda a, b: a / b, ref_dbl, ulp_dbl),
+    'fsb': (flt, lambda a, b: a - b, ref_flt, ulp_flt),
+    'qadd': (qad, lambda a, b: a + b, ref_qad, ulp_qad),
+    'qsub': (qad, lambda a, b: a - b, ref_qad, ulp_qad),
+    'qmul': (qad, lambda a, b: a * b, ref_qad, ulp_qad),
+    'qdiv': (qad, lambda a, b: a / b, ref_qad, ulp_qad),
+}
+
+count = {}
+shown = 0
+
+for line in sys.stdin:
+    op, a, b, n, i = line.split()
+    get, fn, ref, ulp = ops[op]
+    if op[0] != 'q':
+        a, b, n, i = int(a, 16), int(b, 16), int(n, 16), int(i, 16)
+    r = ref(fn(get(a), get(b)))
+    c = count.setdefault(op, [0, 0, 0, 0])
+    c[0] += 1
+    c[1] += n != r
+    if i != r:
+        c[2 if abs(get(i) - get(r)) <= ulp(r) else 3] += 1
+    if n != r and shown < 10:
+        shown += 1
+        h = (lambda v: v) if op[0] == 'q' else (lambda v: '%x' % v)
+        print('%s %s %s native %s exact %s' % (op, h(a), h(b), h(n), h(r)))
+
+print('%-6s %10s %10s %10s %10s' % ('op', 'count', 'native', 'ieee 1ulp', 'ieee more'))
+for op, c in count.items():
+    print('%-6s %10d %10d %10d %10d' % (op, c[0], c[1], c[2], c[3]))
+
+sys.exit(1 if not count or any(c[1] for c in count.values()) else 0)